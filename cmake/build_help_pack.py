@@ -0,0 +1,107 @@
+"""Сборка справки: help/*.html -> сжатый пакет, встроенный в программу как C++ исходник.
+
+Использование: build_help_pack.py <каталог_help> <выходной .cpp>
+
+Формат пакета (целые - big-endian, строки - UTF-8 с длиной quint16):
+    "VZHP", quint32 версия
+    quint32 число страниц, затем для каждой (по возрастанию ключа):
+        ключ, quint32 смещение текста, quint32 длина текста
+    quint32 число слов индекса, затем для каждого (по возрастанию байтов UTF-8):
+        слово, quint32 число страниц, затем пары quint16 страница, quint16 вхождения
+    тексты страниц подряд
+Пакет сжимается в формате qCompress (quint32 исходный размер + поток zlib).
+"""
+
+import html
+import os
+import re
+import struct
+import sys
+import zlib
+
+PACK_MAGIC = b"VZHP"
+PACK_VERSION = 1
+MIN_TERM_LENGTH = 2
+BYTES_PER_LINE = 20
+
+TAG_PATTERN = re.compile(r"<[^>]+>")
+WORD_PATTERN = re.compile(r"\w+")
+
+
+def pack_string(text):
+    data = text.encode("utf-8")
+    return struct.pack(">H", len(data)) + data
+
+
+def page_terms(content):
+    """Слова страницы без разметки, в нижнем регистре - так же разбирается запрос в HelpStore."""
+    text = html.unescape(TAG_PATTERN.sub(" ", content)).lower()
+    counts = {}
+    for word in WORD_PATTERN.findall(text):
+        if len(word) >= MIN_TERM_LENGTH:
+            counts[word] = counts.get(word, 0) + 1
+    return counts
+
+
+def build_pack(help_dir):
+    pages = []
+    for name in sorted(os.listdir(help_dir)):
+        if name.endswith(".html"):
+            with open(os.path.join(help_dir, name), encoding="utf-8") as f:
+                pages.append((name[:-len(".html")], f.read().rstrip("\n")))
+    pages.sort(key=lambda page: page[0].encode("utf-8"))
+
+    index = {}
+    for number, (_, content) in enumerate(pages):
+        for term, hits in page_terms(content).items():
+            index.setdefault(term, []).append((number, min(hits, 0xFFFF)))
+
+    header = PACK_MAGIC + struct.pack(">I", PACK_VERSION)
+    table = struct.pack(">I", len(pages))
+    bodies = [content.encode("utf-8") for _, content in pages]
+    table_size = sum(2 + len(key.encode("utf-8")) + 8 for key, _ in pages) + 4
+
+    terms = sorted(index, key=lambda term: term.encode("utf-8"))
+    postings = bytearray(struct.pack(">I", len(terms)))
+    for term in terms:
+        postings += pack_string(term) + struct.pack(">I", len(index[term]))
+        for number, hits in index[term]:
+            postings += struct.pack(">HH", number, hits)
+
+    offset = len(header) + table_size + len(postings)
+    for (key, _), body in zip(pages, bodies):
+        table += pack_string(key) + struct.pack(">II", offset, len(body))
+        offset += len(body)
+
+    return header + table + bytes(postings) + b"".join(bodies)
+
+
+def write_source(path, data):
+    lines = []
+    for start in range(0, len(data), BYTES_PER_LINE):
+        chunk = data[start:start + BYTES_PER_LINE]
+        lines.append("    " + ",".join(str(byte) for byte in chunk) + ",")
+    source = (
+        "// Сгенерировано cmake/build_help_pack.py из help/*.html - не редактировать\n"
+        "extern const unsigned char HELP_PACK_DATA[];\n"
+        "extern const unsigned int HELP_PACK_SIZE;\n"
+        "\n"
+        "const unsigned char HELP_PACK_DATA[] = {\n"
+        + "\n".join(lines) + "\n"
+        "};\n"
+        "const unsigned int HELP_PACK_SIZE = %d;\n" % len(data)
+    )
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    with open(path, "w", encoding="utf-8", newline="\n") as f:
+        f.write(source)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: build_help_pack.py <help_dir> <output.cpp>")
+    raw = build_pack(sys.argv[1])
+    write_source(sys.argv[2], struct.pack(">I", len(raw)) + zlib.compress(raw, 9))
+
+
+if __name__ == "__main__":
+    main()
@@ -41,6 +41,21 @@ REM Список заголовочных файлов с Q_OBJECT
 "%MOC_EXE%" -o "%OUT_DIR%\moc_SettingsWidget.cpp" "%SRC_DIR%\SettingsWidget.h"
 "%MOC_EXE%" -o "%OUT_DIR%\moc_HelpWidget.cpp" "%SRC_DIR%\HelpWidget.h"
 "%MOC_EXE%" -o "%OUT_DIR%\moc_PythonHighlighter.cpp" "%SRC_DIR%\PythonHighlighter.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_OutputView.cpp" "%SRC_DIR%\OutputView.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_ProcessOutputPump.cpp" "%SRC_DIR%\ProcessOutputPump.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_RunnerChannel.cpp" "%SRC_DIR%\RunnerChannel.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_PythonWorkerPool.cpp" "%SRC_DIR%\PythonWorkerPool.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_DebugPanel.cpp" "%SRC_DIR%\DebugPanel.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_PythonEnvironment.cpp" "%SRC_DIR%\PythonEnvironment.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_PyrobTaskIndex.cpp" "%SRC_DIR%\PyrobTaskIndex.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_SymbolIndex.cpp" "%SRC_DIR%\SymbolIndex.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_CompletionServer.cpp" "%SRC_DIR%\CompletionServer.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_EditorDocument.cpp" "%SRC_DIR%\EditorDocument.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_FileLoader.cpp" "%SRC_DIR%\FileLoader.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_SessionStore.cpp" "%SRC_DIR%\SessionStore.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_SingleInstance.cpp" "%SRC_DIR%\SingleInstance.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_FilePickerService.cpp" "%SRC_DIR%\FilePickerService.h"
+"%MOC_EXE%" -o "%OUT_DIR%\moc_PackageService.cpp" "%SRC_DIR%\PackageService.h"
 "%MOC_EXE%" -o "%OUT_DIR%\moc_PyrobEditorWidget.cpp" "%SRC_DIR%\pyrobeditor\PyrobEditorWidget.h"
 "%MOC_EXE%" -o "%OUT_DIR%\moc_grideditor.cpp" "%SRC_DIR%\pyrobeditor\grideditor.h"
 "%MOC_EXE%" -o "%OUT_DIR%\moc_projectmodel.cpp" "%SRC_DIR%\pyrobeditor\projectmodel.h"
@@ -0,0 +1,124 @@
+# Замер замедления скрипта под отладчиком Vuzhyk.
+#
+#   python runtime/bench_debug_trace.py [скрипт.py] [строка точки останова]
+#
+# Скрипт (по умолчанию - встроенная нагрузка с циклами и вызовами stdlib)
+# выполняется в отдельных процессах в трех режимах:
+#   plain  - обычный запуск;
+#   legacy - глобальный sys.settrace, как в прежнем отладчике (normpath на каждой строке);
+#   runner - трассировка из vuzhyk_runner.py (sys.monitoring на Python 3.12+).
+# Точка останова ставится на строку, которая не выполняется, поэтому замеряется
+# только стоимость трассировки. Выводится время и замедление относительно plain.
+import os
+import runpy
+import subprocess
+import sys
+import tempfile
+import time
+
+RUNNER = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'vuzhyk_runner.py')
+
+WORKLOAD = '''\
+import json
+import re
+
+
+def never_called():
+    return 0  # Точка останова по умолчанию (строка 6)
+
+
+def work(n):
+    total = 0
+    pattern = re.compile(r'\\d+')
+    for i in range(n):
+        total += i * i % 7
+        if i % 100 == 0:
+            total += len(pattern.findall(json.dumps({'i': i, 'items': [i, i + 1]})))
+    return total
+
+
+work(2000000)
+'''
+DEFAULT_BREAKPOINT = 6
+
+
+def run_plain(script):
+    runpy.run_path(script, run_name='__main__')
+
+
+def run_legacy(script, line):
+    # Та же проверка, что выполнял прежний отладочный скрипт на каждой строке
+    breakpoints = {line}
+
+    def trace_debug(frame, event, arg):
+        if event == 'line':
+            normalized_filename = os.path.normpath(os.path.abspath(frame.f_code.co_filename))
+            normalized_current_file = os.path.normpath(os.path.abspath(script))
+            if normalized_filename == normalized_current_file and frame.f_lineno in breakpoints:
+                pass
+        return trace_debug
+
+    sys.settrace(trace_debug)
+    try:
+        runpy.run_path(script, run_name='__main__')
+    finally:
+        sys.settrace(None)
+
+
+def run_runner(script, line):
+    namespace = {'__name__': 'vuzhyk_runner'}
+    with open(RUNNER, encoding='utf-8') as f:
+        exec(compile(f.read(), RUNNER, 'exec'), namespace)
+    namespace['_vz_debug_file'] = namespace['_vz_norm'](script)
+    namespace['_vz_breakpoints'] = {line}
+    namespace['_vz_start_tracing']()
+    try:
+        runpy.run_path(script, run_name='__main__')
+    finally:
+        namespace['_vz_stop_tracing']()
+
+
+def child(mode, script, line):
+    started = time.perf_counter()
+    if mode == 'plain':
+        run_plain(script)
+    elif mode == 'legacy':
+        run_legacy(script, line)
+    else:
+        run_runner(script, line)
+    print(time.perf_counter() - started)
+
+
+def measure(mode, script, line):
+    output = subprocess.run(
+        [sys.executable, os.path.abspath(__file__), '--child', mode, script, str(line)],
+        check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    return float(output.strip().splitlines()[-1])
+
+
+def main():
+    if len(sys.argv) > 1:
+        script = os.path.abspath(sys.argv[1])
+        line = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+        temp = None
+    else:
+        temp = tempfile.NamedTemporaryFile('w', suffix='.py', delete=False, encoding='utf-8')
+        temp.write(WORKLOAD)
+        temp.close()
+        script, line = temp.name, DEFAULT_BREAKPOINT
+    try:
+        print('Python %s, %s' % (sys.version.split()[0], script))
+        plain = measure('plain', script, line)
+        for mode in ('plain', 'legacy', 'runner'):
+            seconds = plain if mode == 'plain' else measure(mode, script, line)
+            print('%-7s %8.3f с  x%.1f' % (mode, seconds, seconds / plain))
+    finally:
+        if temp is not None:
+            os.remove(temp.name)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1 and sys.argv[1] == '--child':
+        child(sys.argv[2], sys.argv[3], int(sys.argv[4]))
+    else:
+        main()
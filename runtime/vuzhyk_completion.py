@@ -0,0 +1,754 @@
+# Сервер анализа кода для автодополнения в Vuzhyk.
+# Запускается как: python -c <этот код>
+# Долгоживущий процесс: запросы приходят JSON-строками в stdin, ответы уходят
+# JSON-строками в stdout. Используются только ast, inspect и importlib.
+# Код пользователя и сторонних пакетов не выполняется: их модули разбираются
+# через ast. Импортируются только уже загруженные модули, встроенные модули и
+# модули расширений стандартной библиотеки (например, math) - импорт .py-модуля
+# мог бы зависнуть, открыть окно или иметь другие побочные эффекты.
+#
+# Запросы:
+#   {"id": 1, "method": "complete", "file": путь, "version": N, "source": текст,
+#    "line": строка (с 1), "column": начало дополняемого слова (символ, с 0)}
+#     source передается, только если сервер еще не видел эту версию файла
+#   {"id": 2, "method": "check", "file": путь, "version": N, "source": текст}
+#     проверка синтаксиса через compile() этого интерпретатора
+#   {"method": "cancel", "id": 1}
+#   {"method": "close", "file": путь}
+# Ответы:
+#   {"id": 1, "result": [{"name": ..., "kind": ...}, ...]}
+#   {"id": 2, "diagnostics": [{"line", "column", "endLine", "endColumn", "message"}]}
+#     строки с 1, столбцы - символы с 0; пустой список - ошибок нет
+#   {"id": 1, "cancelled": true}  - отменен или вытеснен более новым запросом
+#   {"id": 1, "error": "stale"}   - нет текста этой версии, нужно повторить с source
+import ast
+import builtins
+import collections
+import importlib
+import importlib.machinery
+import inspect
+import json
+import keyword
+import os
+import pkgutil
+import re
+import sys
+import sysconfig
+import threading
+import warnings
+
+_out = sys.stdout.buffer
+# Импортируемые для анализа модули могут печатать - stdout занят протоколом
+sys.stdout = sys.stderr
+# Запуск через -c добавляет в sys.path текущий каталог IDE - модули оттуда не ищем
+sys.path[:] = [path for path in sys.path if path not in ('', '.')]
+
+_lock = threading.Condition()
+_queue = collections.deque()   # Ожидающие обработки запросы
+_cancelled = set()             # Номера отмененных запросов
+_closed = False                # stdin закрыт - IDE завершилась
+
+_documents = {}                # Файл -> Document
+_local_modules = {}            # Путь -> (время изменения, привязки верхнего уровня)
+_module_names = None           # Имена модулей из sys.path (считаются один раз)
+
+_MAX_RESOLVE_DEPTH = 8         # Защита от циклов вроде a = b; b = a
+_MAX_PARSE_FIXES = 20          # Сколько ошибочных строк заменять на pass при разборе
+_FROM_IMPORT_RE = re.compile(r'^\s*from\s+([\w.]+)\s+import\s+(?:.*,\s*)?$')
+_IMPORT_RE = re.compile(r'^\s*(?:import|from)\s+(?:[\w.]+\s*,\s*)*$')
+
+
+class Document:
+    """Текст файла одной версии и кэш его разбора."""
+
+    def __init__(self, path):
+        self.path = path
+        self.version = None
+        self.lines = []
+        self.tree = None
+        self.good_tree = None   # Последнее успешно разобранное дерево (текст может быть недописан)
+        self.source = ''
+
+    def update(self, version, source):
+        self.version = version
+        self.source = source
+        self.lines = source.split('\n')
+        self.tree = None
+
+    def parse(self):
+        if self.tree is not None:
+            return self.tree
+        lines = list(self.lines)
+        # Недописанная строка (например, "math.") делает файл синтаксически неверным -
+        # заменяем ошибочные строки на pass с тем же отступом и пробуем снова
+        for _ in range(_MAX_PARSE_FIXES):
+            try:
+                self.tree = ast.parse('\n'.join(lines))
+                self.good_tree = self.tree
+                return self.tree
+            except SyntaxError as error:
+                index = (error.lineno or 0) - 1
+                if not 0 <= index < len(lines) or lines[index].strip() == 'pass':
+                    break
+                text = lines[index]
+                lines[index] = text[:len(text) - len(text.lstrip())] + 'pass'
+            except (ValueError, RecursionError, MemoryError):
+                break
+        self.tree = self.good_tree or ast.Module(body=[], type_ignores=[])
+        return self.tree
+
+
+class Bindings(ast.NodeVisitor):
+    """Имена, связанные в одной области видимости (без вложенных функций и классов)."""
+
+    def __init__(self):
+        self.kinds = {}        # Имя -> вид
+        self.nodes = {}        # Имя -> [(строка, узел-источник значения)]
+
+    def bind(self, name, kind, line, node):
+        self.kinds.setdefault(name, kind)
+        self.nodes.setdefault(name, []).append((line, node))
+
+    def collect(self, body):
+        for statement in body:
+            self.visit(statement)
+        return self
+
+    def visit_FunctionDef(self, node):
+        self.bind(node.name, 'function', node.lineno, node)
+
+    visit_AsyncFunctionDef = visit_FunctionDef
+
+    def visit_ClassDef(self, node):
+        self.bind(node.name, 'class', node.lineno, node)
+
+    def visit_Lambda(self, node):
+        pass
+
+    def visit_ListComp(self, node):
+        pass
+
+    visit_SetComp = visit_DictComp = visit_GeneratorExp = visit_ListComp
+
+    def visit_Import(self, node):
+        for alias in node.names:
+            name = alias.asname or alias.name.split('.')[0]
+            target = alias.name if alias.asname else alias.name.split('.')[0]
+            self.bind(name, 'module', node.lineno, ('import', target))
+
+    def visit_ImportFrom(self, node):
+        module = '.' * node.level + (node.module or '')
+        for alias in node.names:
+            if alias.name == '*':
+                continue
+            self.bind(alias.asname or alias.name, 'variable', node.lineno, ('from', module, alias.name))
+
+    def visit_Assign(self, node):
+        for target in node.targets:
+            self.bind_target(target, node.value, node.lineno)
+        self.visit(node.value)
+
+    def visit_AnnAssign(self, node):
+        self.bind_target(node.target, node.value, node.lineno)
+
+    def visit_AugAssign(self, node):
+        self.bind_target(node.target, None, node.lineno)
+
+    def visit_For(self, node):
+        self.bind_target(node.target, None, node.lineno)
+        self.collect(node.body)
+        self.collect(node.orelse)
+
+    visit_AsyncFor = visit_For
+
+    def visit_With(self, node):
+        for item in node.items:
+            if item.optional_vars is not None:
+                self.bind_target(item.optional_vars, None, node.lineno)
+        self.collect(node.body)
+
+    visit_AsyncWith = visit_With
+
+    def visit_ExceptHandler(self, node):
+        if node.name:
+            self.bind(node.name, 'variable', node.lineno, None)
+        self.collect(node.body)
+
+    def visit_NamedExpr(self, node):
+        self.bind_target(node.target, node.value, node.lineno)
+
+    def visit_Global(self, node):
+        pass
+
+    visit_Nonlocal = visit_Global
+
+    def bind_target(self, target, value, line):
+        if isinstance(target, ast.Name):
+            self.bind(target.id, 'variable', line, value)
+        elif isinstance(target, (ast.Tuple, ast.List)):
+            for element in target.elts:
+                self.bind_target(element, None, line)
+        elif isinstance(target, ast.Starred):
+            self.bind_target(target.value, None, line)
+
+
+class Scope:
+    def __init__(self, node, bindings, parent=None):
+        self.node = node          # ast.Module, FunctionDef или ClassDef
+        self.bindings = bindings
+        self.parent = parent
+
+
+def _function_bindings(node):
+    bindings = Bindings()
+    args = node.args
+    for arg in getattr(args, 'posonlyargs', []) + args.args + args.kwonlyargs:
+        bindings.bind(arg.arg, 'param', node.lineno, None)
+    for arg in (args.vararg, args.kwarg):
+        if arg is not None:
+            bindings.bind(arg.arg, 'param', node.lineno, None)
+    return bindings.collect(node.body)
+
+
+def _scope_at(tree, line):
+    """Цепочка областей видимости, содержащих строку (от внутренней к модулю)."""
+    scope = Scope(tree, Bindings().collect(tree.body))
+    body = tree.body
+    while True:
+        inner = None
+        for node in ast.walk(ast.Module(body=body, type_ignores=[])):
+            if isinstance(node, (ast.FunctionDef, ast.AsyncFunctionDef, ast.ClassDef)):
+                end = getattr(node, 'end_lineno', None) or node.lineno
+                if node.lineno < line <= end or (node.lineno == line and isinstance(node, ast.ClassDef)):
+                    inner = node
+                    break
+        if inner is None:
+            return scope
+        if isinstance(inner, ast.ClassDef):
+            bindings = Bindings().collect(inner.body)
+        else:
+            bindings = _function_bindings(inner)
+        scope = Scope(inner, bindings, scope)
+        body = inner.body
+
+
+def _visible_scopes(scope):
+    """Области, имена которых видны в scope: тело класса не видно из его методов."""
+    result = [scope]
+    current = scope.parent
+    while current is not None:
+        if not isinstance(current.node, ast.ClassDef):
+            result.append(current)
+        current = current.parent
+    return result
+
+
+def _enclosing_class(scope):
+    """Класс метода, внутри которого находится scope (для self)."""
+    current = scope
+    while current is not None and current.parent is not None:
+        if isinstance(current.node, (ast.FunctionDef, ast.AsyncFunctionDef)) \
+                and isinstance(current.parent.node, ast.ClassDef):
+            return current.parent.node
+        current = current.parent
+    return None
+
+
+# Значения при выводе типов: ('object', объект Python), ('class', ClassDef, Scope)
+# или ('module', путь к файлу модуля, который разбирается, но не выполняется)
+
+def _import_module(name, document, origin=None):
+    """Модуль по имени; origin - файл с инструкцией import (для относительного импорта)."""
+    if name.startswith('.'):
+        level = len(name) - len(name.lstrip('.'))
+        base = os.path.dirname(os.path.abspath(origin or document.path))
+        for _ in range(level - 1):
+            base = os.path.dirname(base)
+        path = _module_file(base, name[level:])
+        return ('module', path) if path else None
+    local = _local_module_path(name, document)
+    if local:
+        return ('module', local)
+    return _library_module(name)
+
+
+def _module_file(base, name):
+    """Файл модуля name (через точки) в каталоге base; пустое имя - сам пакет base."""
+    relative = name.replace('.', os.sep)
+    candidates = (relative + '.py', os.path.join(relative, '__init__.py')) if relative else ('__init__.py',)
+    for candidate in candidates:
+        path = os.path.join(base, candidate)
+        if os.path.isfile(path):
+            return path
+    return None
+
+
+def _local_module_path(name, document):
+    """Модуль рядом с файлом пользователя (первый каталог sys.path при запуске)."""
+    if not os.path.isfile(document.path):
+        return None
+    return _module_file(os.path.dirname(os.path.abspath(document.path)), name)
+
+
+def _stdlib_directories():
+    paths = sysconfig.get_paths()
+    directories = {paths.get('stdlib'), paths.get('platstdlib'), sys.base_prefix,
+                   os.path.join(sys.base_prefix, 'DLLs')}
+    if paths.get('platstdlib'):
+        directories.add(os.path.join(paths['platstdlib'], 'lib-dynload'))
+    return {os.path.normcase(os.path.abspath(path)) for path in directories if path}
+
+
+_STDLIB_DIRECTORIES = _stdlib_directories()
+
+
+def _find_spec(name):
+    """Спецификация модуля без импорта родительских пакетов (importlib.util.find_spec импортирует их)."""
+    spec = None
+    path = None
+    parts = name.split('.')
+    for index in range(len(parts)):
+        if index and path is None:
+            return None   # Родитель - не пакет
+        try:
+            spec = importlib.machinery.PathFinder.find_spec('.'.join(parts[:index + 1]), path)
+        except (ImportError, ValueError, OSError):
+            return None
+        if spec is None:
+            return None
+        path = spec.submodule_search_locations
+    return spec
+
+
+def _library_module(name):
+    module = sys.modules.get(name)
+    if module is not None:
+        return ('object', module)
+    # Встроенные модули и расширения стандартной библиотеки импортируются без выполнения Python-кода
+    if name in sys.builtin_module_names:
+        return _safe_import(name)
+    spec = _find_spec(name)
+    if spec is None or not spec.origin:
+        return None
+    if isinstance(spec.loader, importlib.machinery.ExtensionFileLoader) \
+            and os.path.normcase(os.path.dirname(os.path.abspath(spec.origin))) in _STDLIB_DIRECTORIES \
+            and ('.' not in name or name.rpartition('.')[0] in sys.modules):
+        return _safe_import(name)
+    if spec.origin.endswith('.py') and os.path.isfile(spec.origin):
+        return ('module', spec.origin)
+    return None
+
+
+def _safe_import(name):
+    try:
+        return ('object', importlib.import_module(name))
+    except BaseException:
+        return None
+
+
+def _local_module_bindings(path):
+    try:
+        mtime = os.path.getmtime(path)
+    except OSError:
+        return Bindings()
+    cached = _local_modules.get(path)
+    if cached and cached[0] == mtime:
+        return cached[1]
+    try:
+        with open(path, 'rb') as file:
+            tree = ast.parse(file.read())
+        bindings = Bindings().collect(tree.body)
+    except (OSError, SyntaxError, ValueError):
+        bindings = Bindings()
+    _local_modules[path] = (mtime, bindings)
+    return bindings
+
+
+def _resolve_name(name, scopes, document, line, depth):
+    if depth > _MAX_RESOLVE_DEPTH:
+        return None
+    if name == 'self':
+        cls = _enclosing_class(scopes[0])
+        if cls is not None:
+            return ('class', cls, scopes[-1])
+    for scope in scopes:
+        entries = scope.bindings.nodes.get(name)
+        if not entries:
+            continue
+        # Последнее присваивание до текущей строки, иначе первое
+        before = [entry for entry in entries if entry[0] <= line] or entries[:1]
+        for _, source in reversed(before):
+            value = _resolve_source(source, scope, scopes, document, line, depth)
+            if value is not None:
+                return value
+        return None
+    if hasattr(builtins, name):
+        return ('object', getattr(builtins, name))
+    return None
+
+
+def _resolve_source(source, scope, scopes, document, line, depth):
+    if source is None:
+        return None
+    if isinstance(source, tuple):
+        if source[0] == 'import':
+            return _import_module(source[1], document)
+        module = _import_module(source[1], document)
+        return _member(module, source[2], document, depth + 1)
+    if isinstance(source, ast.ClassDef):
+        return ('class', source, scope)
+    if isinstance(source, ast.AST) and not isinstance(source, (ast.FunctionDef, ast.AsyncFunctionDef)):
+        # Выражение - в областях, видимых из места присваивания
+        return _infer(source, _visible_scopes(scope) if scope is not None else scopes, document, line, depth + 1)
+    return None
+
+
+def _infer(node, scopes, document, line, depth):
+    if depth > _MAX_RESOLVE_DEPTH:
+        return None
+    if isinstance(node, ast.Constant):
+        return ('object', type(node.value))
+    literal_types = {ast.List: list, ast.ListComp: list, ast.Dict: dict, ast.DictComp: dict,
+                     ast.Set: set, ast.SetComp: set, ast.Tuple: tuple, ast.JoinedStr: str}
+    for node_type, value_type in literal_types.items():
+        if isinstance(node, node_type):
+            return ('object', value_type)
+    if isinstance(node, ast.Name):
+        return _resolve_name(node.id, scopes, document, line, depth + 1)
+    if isinstance(node, ast.Attribute):
+        base = _infer(node.value, scopes, document, line, depth + 1)
+        return _member(base, node.attr, document, depth + 1)
+    if isinstance(node, ast.BinOp):
+        return _infer(node.left, scopes, document, line, depth + 1)
+    if isinstance(node, ast.Call):
+        callee = _infer(node.func, scopes, document, line, depth + 1)
+        if callee is None:
+            return None
+        if callee[0] == 'class':
+            return callee   # Экземпляр локального класса - те же атрибуты
+        if callee[0] == 'object' and inspect.isclass(callee[1]):
+            return callee
+    return None
+
+
+def _member(value, name, document, depth):
+    if value is None or depth > _MAX_RESOLVE_DEPTH:
+        return None
+    kind = value[0]
+    if kind == 'object':
+        try:
+            member = getattr(value[1], name)
+        except BaseException:
+            # Подмодуль пакета, еще не импортированный в сам пакет
+            if inspect.ismodule(value[1]):
+                return _import_module(value[1].__name__ + '.' + name, document)
+            return None
+        return ('object', member)
+    if kind == 'module':
+        bindings = _local_module_bindings(value[1])
+        entries = bindings.nodes.get(name)
+        if entries:
+            source = entries[-1][1]
+            if isinstance(source, ast.ClassDef):
+                return ('class', source, Scope(ast.Module(body=[], type_ignores=[]), bindings))
+            if isinstance(source, tuple):
+                # Относительный импорт - от файла этого модуля, а не от файла пользователя
+                module = _import_module(source[1], document, value[1])
+                return module if source[0] == 'import' else _member(module, source[2], document, depth + 1)
+            return None
+        if os.path.basename(value[1]) == '__init__.py':
+            # Подмодуль пакета, не упомянутый в его __init__.py
+            path = _module_file(os.path.dirname(value[1]), name)
+            if path:
+                return ('module', path)
+        return None
+    if kind == 'class':
+        for member_name, _, source in _class_members(value[1], value[2], document, depth):
+            if member_name == name and isinstance(source, ast.ClassDef):
+                return ('class', source, value[2])
+    return None
+
+
+def _class_members(cls, scope, document, depth):
+    """Методы, атрибуты класса и self.x из его методов, затем члены базовых классов."""
+    members = []
+    bindings = Bindings().collect(cls.body)
+    for name, kind in bindings.kinds.items():
+        source = bindings.nodes[name][-1][1]
+        members.append((name, kind, source))
+    for node in ast.walk(cls):
+        if isinstance(node, ast.Attribute) and isinstance(node.ctx, ast.Store) \
+                and isinstance(node.value, ast.Name) and node.value.id == 'self':
+            members.append((node.attr, 'variable', None))
+    if depth < _MAX_RESOLVE_DEPTH:
+        scopes = [scope] if scope is not None else []
+        for base in cls.bases:
+            value = _infer(base, scopes, document, 0, depth + 1) if scopes else None
+            members.extend((name, kind, None) for name, kind in _members(value, document, depth + 1))
+    return members
+
+
+def _object_kind(value):
+    if inspect.ismodule(value):
+        return 'module'
+    if inspect.isclass(value):
+        return 'class'
+    if callable(value):
+        return 'function'
+    return 'variable'
+
+
+def _members(value, document, depth=0):
+    """[(имя, вид)] атрибутов значения."""
+    if value is None:
+        return []
+    kind = value[0]
+    if kind == 'object':
+        obj = value[1]
+        result = []
+        for name in dir(obj):
+            try:
+                member = inspect.getattr_static(obj, name)
+            except AttributeError:
+                member = None
+            result.append((name, _object_kind(member)))
+        if inspect.ismodule(obj) and hasattr(obj, '__path__'):
+            # Подмодули пакета, которые еще не импортированы
+            try:
+                result.extend((info.name, 'module') for info in pkgutil.iter_modules(obj.__path__))
+            except (OSError, TypeError):
+                pass
+        return result
+    if kind == 'module':
+        result = list(_local_module_bindings(value[1]).kinds.items())
+        if os.path.basename(value[1]) == '__init__.py':
+            try:
+                result.extend((info.name, 'module') for info in pkgutil.iter_modules([os.path.dirname(value[1])]))
+            except (OSError, TypeError):
+                pass
+        return result
+    if kind == 'class':
+        return [(name, member_kind) for name, member_kind, _ in _class_members(value[1], value[2], document, depth)]
+    return []
+
+
+def _all_module_names(document):
+    global _module_names
+    if _module_names is None:
+        names = set(sys.builtin_module_names)
+        try:
+            names.update(info.name for info in pkgutil.iter_modules())
+        except (OSError, ImportError):
+            pass
+        _module_names = names
+    names = set(_module_names)
+    if os.path.isfile(document.path):
+        try:
+            for entry in os.listdir(os.path.dirname(os.path.abspath(document.path))):
+                if entry.endswith('.py'):
+                    names.add(entry[:-3])
+        except OSError:
+            pass
+    return [(name, 'module') for name in names]
+
+
+def _expression_before_dot(text):
+    """Выражение перед завершающей точкой ("obj.items()[0]." -> "obj.items()[0]") или None."""
+    stripped = text.rstrip()
+    if not stripped.endswith('.'):
+        return None
+    end = len(stripped) - 1
+    position = end
+    closing = {')': '(', ']': '['}
+    while position > 0:
+        ch = stripped[position - 1]
+        if ch.isalnum() or ch in '_.':
+            position -= 1
+        elif ch in closing:
+            # Пропускаем сбалансированные скобки вызова или индексации
+            depth = 0
+            while position > 0:
+                current = stripped[position - 1]
+                if current in closing:
+                    depth += 1
+                elif current in '([':
+                    depth -= 1
+                position -= 1
+                if depth == 0:
+                    break
+            if depth != 0:
+                return None
+        elif ch in '"\'' and position == end:
+            # Строковый литерал: "abc".
+            start = stripped.rfind(ch, 0, position - 1)
+            if start < 0:
+                return None
+            position = start
+            break
+        else:
+            break
+    expression = stripped[position:end].strip()
+    return expression or None
+
+
+def _complete(request, document):
+    line = request['line']
+    column = request['column']
+    text = document.lines[line - 1] if 0 < line <= len(document.lines) else ''
+    before = text[:column]
+
+    match = _FROM_IMPORT_RE.match(before)
+    if match:
+        return _members(_import_module(match.group(1), document), document)
+    if _IMPORT_RE.match(before):
+        return _all_module_names(document)
+
+    tree = document.parse()
+    if _cancelled_request(request):
+        return None
+    scopes = _visible_scopes(_scope_at(tree, line))
+
+    expression = _expression_before_dot(before)
+    if expression is not None:
+        try:
+            node = ast.parse(expression, mode='eval').body
+        except (SyntaxError, ValueError):
+            return []
+        return _members(_infer(node, scopes, document, line, 0), document)
+
+    result = []
+    for scope in scopes:
+        result.extend(scope.bindings.kinds.items())
+    result.extend((name, 'keyword') for name in keyword.kwlist)
+    result.extend((name, 'builtin') for name in dir(builtins) if not name.startswith('_'))
+    return result
+
+
+def _check(document):
+    """Первая синтаксическая ошибка файла (compile сообщает только одну)."""
+    try:
+        with warnings.catch_warnings():
+            # SyntaxWarning (например, неизвестная escape-последовательность) - не ошибка
+            warnings.simplefilter('ignore')
+            compile(document.source, document.path, 'exec', dont_inherit=True)
+    except SyntaxError as error:
+        line = error.lineno or 1
+        column = max((error.offset or 1) - 1, 0)
+        end_line = getattr(error, 'end_lineno', None) or line
+        end_column = (getattr(error, 'end_offset', None) or 0) - 1
+        if end_line == line and end_column <= column:
+            end_column = column + 1
+        return [{'line': line, 'column': column, 'endLine': end_line, 'endColumn': max(end_column, 0),
+                 'message': error.msg, 'kind': type(error).__name__}]
+    except (ValueError, OverflowError, MemoryError, RecursionError) as error:
+        # Например, нулевой байт в тексте
+        return [{'line': 1, 'column': 0, 'endLine': 1, 'endColumn': 1, 'message': str(error),
+                 'kind': type(error).__name__}]
+    return []
+
+
+def _cancelled_request(request):
+    with _lock:
+        return request.get('id') in _cancelled
+
+
+def _send(message):
+    _out.write((json.dumps(message, ensure_ascii=False) + '\n').encode('utf-8'))
+    _out.flush()
+
+
+def _apply_source(request):
+    """Документ запроса с текстом из него; None - у сервера нет текста этой версии."""
+    path = request.get('file', '')
+    document = _documents.get(path)
+    if 'source' in request:
+        if document is None:
+            document = _documents[path] = Document(path)
+        document.update(request.get('version'), request['source'])
+    elif document is None or document.version != request.get('version'):
+        return None
+    return document
+
+
+def _handle(request):
+    method = request.get('method')
+    if method == 'close':
+        _documents.pop(request.get('file'), None)
+        return
+    if method not in ('complete', 'check'):
+        return
+    document = _apply_source(request)
+    if document is None:
+        _send({'id': request['id'], 'error': 'stale'})
+        return
+
+    if method == 'check':
+        _send({'id': request['id'], 'diagnostics': _check(document)})
+        return
+
+    items = _complete(request, document)
+    if items is None or _cancelled_request(request):
+        _send({'id': request['id'], 'cancelled': True})
+        return
+    # Одинаковые имена - оставляем первое (из ближайшей области видимости)
+    seen = {}
+    for name, kind in items:
+        if name not in seen and not name.startswith('__'):
+            seen[name] = kind
+    result = [{'name': name, 'kind': kind}
+              for name, kind in sorted(seen.items(), key=lambda item: (item[0].startswith('_'), item[0].lower()))]
+    _send({'id': request['id'], 'result': result})
+
+
+def _reader():
+    global _closed
+    for raw in sys.stdin.buffer:
+        try:
+            message = json.loads(raw.decode('utf-8'))
+        except ValueError:
+            continue
+        with _lock:
+            if message.get('method') == 'cancel':
+                _cancelled.add(message.get('id'))
+            else:
+                if message.get('method') in ('complete', 'check'):
+                    # Новый запрос для файла вытесняет ожидающие запросы того же вида
+                    for pending in _queue:
+                        if pending.get('method') == message.get('method') and pending.get('file') == message.get('file'):
+                            _cancelled.add(pending.get('id'))
+                _queue.append(message)
+            _lock.notify()
+    with _lock:
+        _closed = True
+        _lock.notify()
+
+
+def main():
+    threading.Thread(target=_reader, daemon=True).start()
+    while True:
+        with _lock:
+            while not _queue and not _closed:
+                _lock.wait()
+            if not _queue:
+                return
+            request = _queue.popleft()
+            skip = 'id' in request and request['id'] in _cancelled
+        if skip:
+            # IDE считает эту версию текста переданной - следующие запросы придут без source
+            if request.get('method') in ('complete', 'check') and 'source' in request:
+                _apply_source(request)
+            _send({'id': request['id'], 'cancelled': True})
+        else:
+            try:
+                _handle(request)
+            except Exception as error:
+                if 'id' in request:
+                    _send({'id': request['id'], 'error': str(error)})
+        if 'id' in request:
+            # Номера запросов растут - более старые отмены больше не понадобятся
+            with _lock:
+                _cancelled.difference_update([i for i in _cancelled if isinstance(i, int) and i <= request['id']])
+
+
+if __name__ == '__main__':
+    main()
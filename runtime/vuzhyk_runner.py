@@ -0,0 +1,463 @@
+# Обертка запуска скрипта пользователя в Vuzhyk.
+# Запускается как: python -c <этот код> <путь к скрипту> [имя канала]
+# как прогретый процесс: python -c <этот код> --worker (см. _vz_worker)
+# или под отладчиком: python -c <этот код> --debug <путь к скрипту> <имя канала>
+# По каналу (именованный канал Windows / unix-сокет QLocalServer) в IDE
+# отправляются служебные сообщения в виде JSON-строк, а в режиме отладки
+# из IDE приходят команды (см. _vz_pause).
+import sys
+import os
+import json
+import runpy
+import traceback
+
+_vz_channel = None
+_vz_inbuf = b''            # Принятые, но еще не разобранные байты команд
+_vz_debug_file = None      # Нормализованный путь отлаживаемого файла
+_vz_breakpoints = set()    # Номера строк (с 1) с точками останова
+_vz_step_mode = None       # Шаг: 'into', 'over', 'out' или None
+_vz_step_depth = 0         # Глубина стека кадра, с которого начат шаг
+_vz_refs = {}              # Номер -> объект для раскрытия в дереве переменных (до продолжения)
+
+_VZ_MAX_CHILDREN = 100     # Сколько элементов коллекции отдавать за один запрос
+
+
+def _vz_connect(name):
+    """Подключается к QLocalServer IDE. Без канала скрипт просто выполняется."""
+    if not name:
+        return None
+    try:
+        if os.name == 'nt':
+            return open(name, 'r+b', buffering=0)
+        import socket
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        sock.connect(name)
+        return sock.makefile('rwb', buffering=0)
+    except OSError:
+        return None
+
+
+def _vz_send(message):
+    if _vz_channel is None:
+        return
+    try:
+        data = json.dumps(message, ensure_ascii=False) + '\n'
+        _vz_channel.write(data.encode('utf-8'))
+    except (OSError, ValueError):
+        pass
+
+
+def _vz_receive():
+    """Блокирующее чтение одной команды. None - канал закрыт."""
+    global _vz_inbuf
+    if _vz_channel is None:
+        return None
+    while b'\n' not in _vz_inbuf:
+        try:
+            chunk = _vz_channel.read(4096)
+        except OSError:
+            chunk = b''
+        if not chunk:
+            return None
+        _vz_inbuf += chunk
+    line, _, _vz_inbuf = _vz_inbuf.partition(b'\n')
+    try:
+        return json.loads(line.decode('utf-8'))
+    except ValueError:
+        return {}
+
+
+def _vz_exception_record(exc_type, exc_value, exc_tb):
+    """Компактная запись об исключении: тип, сообщение, кадры и место ошибки."""
+    frames = []
+    for frame in traceback.extract_tb(exc_tb):
+        if frame.filename.startswith('<') or frame.filename == runpy.__file__:
+            continue  # Кадры самой обертки (<string>) и runpy
+        frames.append({
+            'file': os.path.abspath(frame.filename),
+            'line': frame.lineno or 0,
+            'function': frame.name,
+        })
+    record = {
+        'event': 'exception',
+        'type': exc_type.__name__,
+        'message': str(exc_value),
+        'frames': frames,
+    }
+    if isinstance(exc_value, SyntaxError) and exc_value.filename:
+        # У SyntaxError место ошибки не входит в traceback
+        record['file'] = os.path.abspath(exc_value.filename)
+        record['line'] = exc_value.lineno or 0
+    elif frames:
+        record['file'] = frames[-1]['file']
+        record['line'] = frames[-1]['line']
+    return record
+
+
+def _vz_excepthook(exc_type, exc_value, exc_tb):
+    if exc_type is not SystemExit:
+        _vz_send(_vz_exception_record(exc_type, exc_value, exc_tb))
+    sys.__excepthook__(exc_type, exc_value, exc_tb)
+
+
+def _vz_run(script):
+    sys.argv = [script]
+    sys.excepthook = _vz_excepthook
+    try:
+        runpy.run_path(script, run_name='__main__')
+    except SystemExit:
+        raise
+    except Exception:
+        # Сначала сообщаем IDE, затем печатаем полный traceback
+        _vz_send(_vz_exception_record(*sys.exc_info()))
+        traceback.print_exc()
+        sys.exit(1)
+    finally:
+        sys.stdout.flush()
+        sys.stderr.flush()
+
+
+def _vz_norm(path):
+    return os.path.normcase(os.path.normpath(os.path.abspath(path)))
+
+
+def _vz_gui_pump():
+    """Функция обработки событий GUI скрипта, если он уже создал окно.
+
+    Пока скрипт стоит на точке останова, его окна должны перерисовываться.
+    Проверяются только уже импортированные модули - сами тулкиты не импортируются.
+    """
+    tkinter = sys.modules.get('tkinter')
+    if tkinter is not None and getattr(tkinter, '_default_root', None) is not None:
+        return tkinter._default_root.update
+    for name in ('PyQt5.QtWidgets', 'PyQt6.QtWidgets', 'PySide2.QtWidgets', 'PySide6.QtWidgets'):
+        module = sys.modules.get(name)
+        app = module.QApplication.instance() if module is not None else None
+        if app is not None:
+            return app.processEvents
+    return None
+
+
+def _vz_wait_command(pump):
+    """Ждет данные в канале, обрабатывая события GUI скрипта каждые 10 мс."""
+    if b'\n' in _vz_inbuf:
+        return
+    if os.name == 'nt':
+        import msvcrt
+        import time
+        import _winapi
+        handle = msvcrt.get_osfhandle(_vz_channel.fileno())
+        while True:
+            try:
+                if _winapi.PeekNamedPipe(handle, 0)[0]:
+                    return
+            except OSError:
+                return  # Канал закрыт - _vz_receive вернет None
+            pump()
+            time.sleep(0.01)
+    else:
+        import select
+        while not select.select([_vz_channel], [], [], 0.01)[0]:
+            pump()
+
+
+def _vz_frame_record(frame):
+    return {
+        'file': os.path.abspath(frame.f_code.co_filename),
+        'line': frame.f_lineno,
+        'function': frame.f_code.co_name,
+    }
+
+
+def _vz_stack_frames(frame):
+    """Кадры скрипта от текущего к внешнему (без кадров обертки и runpy)."""
+    frames = []
+    while frame is not None:
+        filename = frame.f_code.co_filename
+        if not filename.startswith('<') and filename != runpy.__file__:
+            frames.append(frame)
+        frame = frame.f_back
+    return frames
+
+
+def _vz_depth(frame):
+    depth = 0
+    while frame is not None:
+        depth += 1
+        frame = frame.f_back
+    return depth
+
+
+_vz_repr_limits = None
+
+
+def _vz_short_repr(value):
+    """repr с ограничением длины: большие коллекции и строки не сериализуются целиком."""
+    global _vz_repr_limits
+    if _vz_repr_limits is None:
+        import reprlib
+        _vz_repr_limits = reprlib.Repr()
+        _vz_repr_limits.maxstring = 200
+        _vz_repr_limits.maxother = 200
+    try:
+        return _vz_repr_limits.repr(value)
+    except Exception as error:
+        return '<ошибка repr: %s>' % error
+
+
+def _vz_expandable(value):
+    if isinstance(value, (dict, list, tuple, set, frozenset)):
+        return len(value) > 0
+    if isinstance(value, (str, bytes, int, float, complex, bool, type(None), type)):
+        return False
+    import types
+    if isinstance(value, (types.ModuleType, types.FunctionType, types.BuiltinFunctionType, types.MethodType)):
+        return False
+    return bool(getattr(value, '__dict__', None))
+
+
+def _vz_variable(name, value):
+    variable = {'name': name, 'type': type(value).__name__, 'value': _vz_short_repr(value)}
+    if _vz_expandable(value):
+        # Содержимое отдается по запросу expand, а не вместе с переменной
+        ref = len(_vz_refs) + 1
+        _vz_refs[ref] = value
+        variable['ref'] = ref
+    return variable
+
+
+def _vz_locals(frame):
+    variables = []
+    for name, value in frame.f_locals.items():
+        if name.startswith('__'):
+            continue
+        variables.append(_vz_variable(name, value))
+    return variables
+
+
+def _vz_children(value):
+    import itertools
+    if isinstance(value, dict):
+        items = ((_vz_short_repr(key), item) for key, item in value.items())
+        total = len(value)
+    elif isinstance(value, (list, tuple, set, frozenset)):
+        items = (('[%d]' % index, item) for index, item in enumerate(value))
+        total = len(value)
+    else:
+        attributes = vars(value)
+        items = iter(attributes.items())
+        total = len(attributes)
+    variables = [_vz_variable(name, item) for name, item in itertools.islice(items, _VZ_MAX_CHILDREN)]
+    if total > _VZ_MAX_CHILDREN:
+        variables.append({'name': '...', 'type': '', 'value': 'еще %d' % (total - _VZ_MAX_CHILDREN)})
+    return variables
+
+
+def _vz_step_hit(frame):
+    if _vz_step_mode == 'into':
+        return True
+    depth = _vz_depth(frame)
+    if _vz_step_mode == 'over':
+        return depth <= _vz_step_depth
+    return depth < _vz_step_depth
+
+
+def _vz_pause(frame, reason):
+    """Останов: сообщает IDE и обслуживает команды до continue/step.
+
+    Команды IDE:
+      {"command": "continue"}, {"command": "step", "mode": "into" | "over" | "out"},
+      {"command": "breakpoints", "lines": [...]},
+      {"command": "stack"}, {"command": "locals", "frame": N}, {"command": "expand", "ref": N}.
+    Ответы: {"event": "stack", "frames": [...]}, {"event": "locals", "frame": N, "variables": [...]},
+      {"event": "children", "ref": N, "variables": [...]}.
+    """
+    global _vz_step_mode, _vz_step_depth, _vz_breakpoints
+    sys.stdout.flush()
+    sys.stderr.flush()
+    frames = _vz_stack_frames(frame)
+    if frame is not None:
+        message = _vz_frame_record(frame)
+        message.update({'event': 'break', 'reason': reason})
+        _vz_send(message)
+    pump = _vz_gui_pump()
+    changed = False
+    while True:
+        if pump is not None:
+            _vz_wait_command(pump)
+        command = _vz_receive()
+        if command is None:
+            # IDE закрыла канал - дальше выполняемся без отладчика
+            _vz_step_mode = None
+            _vz_refs.clear()
+            _vz_stop_tracing()
+            return
+        name = command.get('command')
+        if name in ('continue', 'step'):
+            _vz_step_mode = command.get('mode', 'into') if name == 'step' else None
+            _vz_step_depth = _vz_depth(frame)
+            _vz_refs.clear()
+            _vz_resume(frame, changed or _vz_step_mode is not None)
+            return
+        if name == 'breakpoints':
+            _vz_breakpoints = set(command.get('lines', []))
+            changed = True
+        elif name == 'stack':
+            _vz_send({'event': 'stack', 'frames': [_vz_frame_record(f) for f in frames]})
+        elif name == 'locals':
+            index = command.get('frame', 0)
+            if 0 <= index < len(frames):
+                _vz_send({'event': 'locals', 'frame': index, 'variables': _vz_locals(frames[index])})
+        elif name == 'expand':
+            ref = command.get('ref')
+            if ref in _vz_refs:
+                _vz_send({'event': 'children', 'ref': ref, 'variables': _vz_children(_vz_refs[ref])})
+
+
+# Трассировка построчно только кода отлаживаемого файла.
+# Принадлежность объекта кода файлу и его строки вычисляются один раз и кэшируются,
+# поэтому код stdlib и библиотек выполняется без построчных событий.
+# На Python 3.12+ используется sys.monitoring: события LINE включаются только для
+# объектов кода отлаживаемого файла, а строки без точек останова отключаются
+# после первого срабатывания (sys.monitoring.DISABLE).
+
+_vz_code_lines_cache = {}  # Объект кода -> frozenset его строк или None для чужого кода
+_vz_path_cache = {}        # co_filename -> нормализованный путь
+_vz_monitoring = False     # Трассировка через sys.monitoring
+
+
+def _vz_code_lines(code):
+    """Строки объекта кода из отлаживаемого файла; None - код из другого файла."""
+    try:
+        return _vz_code_lines_cache[code]
+    except KeyError:
+        pass
+    filename = code.co_filename
+    path = _vz_path_cache.get(filename)
+    if path is None:
+        path = _vz_path_cache[filename] = _vz_norm(filename)
+    lines = None
+    if path == _vz_debug_file:
+        import dis
+        lines = frozenset(line for _, line in dis.findlinestarts(code) if line)
+    _vz_code_lines_cache[code] = lines
+    return lines
+
+
+def _vz_trace_call(frame, event, arg):
+    # Глобальная функция трассировки вызывается только при входе в кадр
+    lines = _vz_code_lines(frame.f_code)
+    if lines is None:
+        return None
+    if _vz_step_mode or not _vz_breakpoints.isdisjoint(lines):
+        return _vz_trace_line
+    return None
+
+
+def _vz_trace_line(frame, event, arg):
+    if event == 'line':
+        if frame.f_lineno in _vz_breakpoints:
+            _vz_pause(frame, 'breakpoint')
+        elif _vz_step_mode and _vz_step_hit(frame):
+            _vz_pause(frame, 'step')
+    return _vz_trace_line
+
+
+def _vz_on_start(code, offset):
+    if _vz_code_lines(code) is not None:
+        sys.monitoring.set_local_events(sys.monitoring.DEBUGGER_ID, code, sys.monitoring.events.LINE)
+    # Для каждого объекта кода PY_START нужен один раз
+    return sys.monitoring.DISABLE
+
+
+def _vz_on_line(code, line):
+    if line in _vz_breakpoints:
+        _vz_pause(sys._getframe(1), 'breakpoint')
+    elif _vz_step_mode:
+        if _vz_step_hit(sys._getframe(1)):
+            _vz_pause(sys._getframe(1), 'step')
+        # Во время шага не отключаем: DISABLE действует на объект кода целиком, и
+        # вложенный рекурсивный кадр отключил бы следующую строку вызывающего
+    else:
+        return sys.monitoring.DISABLE
+
+
+def _vz_start_tracing():
+    global _vz_monitoring
+    monitoring = getattr(sys, 'monitoring', None)
+    if monitoring is not None:
+        tool = monitoring.DEBUGGER_ID
+        try:
+            monitoring.use_tool_id(tool, 'vuzhyk')
+        except ValueError:
+            monitoring = None  # Отладчик уже занят (например, другим инструментом)
+    if monitoring is not None:
+        _vz_monitoring = True
+        monitoring.register_callback(tool, monitoring.events.PY_START, _vz_on_start)
+        monitoring.register_callback(tool, monitoring.events.LINE, _vz_on_line)
+        monitoring.set_events(tool, monitoring.events.PY_START)
+    else:
+        sys.settrace(_vz_trace_call)
+
+
+def _vz_stop_tracing():
+    if _vz_monitoring:
+        tool = sys.monitoring.DEBUGGER_ID
+        sys.monitoring.set_events(tool, 0)
+        sys.monitoring.register_callback(tool, sys.monitoring.events.PY_START, None)
+        sys.monitoring.register_callback(tool, sys.monitoring.events.LINE, None)
+    else:
+        sys.settrace(None)
+
+
+def _vz_resume(frame, changed):
+    """Продолжение после останова. При шаге или смене точек останова
+    снова включает построчные события там, где они были отключены."""
+    if not changed:
+        return
+    if _vz_monitoring:
+        sys.monitoring.restart_events()
+        return
+    # Кадры, уже выполняющиеся без построчной трассировки, получают ее явно
+    while frame is not None:
+        lines = _vz_code_lines(frame.f_code)
+        if lines is not None and (_vz_step_mode or not _vz_breakpoints.isdisjoint(lines)):
+            frame.f_trace = _vz_trace_line
+        frame = frame.f_back
+
+
+def _vz_debug(script, channel):
+    """Режим отладки: до запуска скрипта ждет точки останова и команду continue."""
+    global _vz_channel, _vz_debug_file
+    _vz_channel = _vz_connect(channel)
+    _vz_debug_file = _vz_norm(script)
+    if _vz_channel is not None:
+        _vz_pause(None, 'start')
+        _vz_start_tracing()
+    _vz_run(script)
+
+
+def _vz_worker():
+    """Режим быстрого запуска: интерпретатор уже запущен и ждет задание.
+
+    Первая строка stdin - JSON {"script", "cwd", "channel"}; остальной stdin
+    достается скрипту (input()). Процесс выполняет один скрипт и завершается.
+    """
+    global _vz_channel
+    line = sys.stdin.readline()
+    if not line.strip():
+        return
+    job = json.loads(line)
+    os.chdir(job['cwd'])
+    _vz_channel = _vz_connect(job.get('channel', ''))
+    _vz_run(job['script'])
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1 and sys.argv[1] == '--worker':
+        _vz_worker()
+    elif len(sys.argv) > 3 and sys.argv[1] == '--debug':
+        _vz_debug(sys.argv[2], sys.argv[3])
+    else:
+        _vz_channel = _vz_connect(sys.argv[2] if len(sys.argv) > 2 else '')
+        _vz_run(sys.argv[1])
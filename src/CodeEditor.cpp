@@ -1,4 +1,7 @@
 #include "CodeEditor.h"
+#include "SymbolIndex.h"
+#include "CompletionAPIs.h"
+#include "EditorDocument.h"
 
 #include <QAbstractItemView>
 #include <QAbstractItemModel>
@@ -10,18 +13,15 @@
 #include <QEvent>
 #include <QSettings>
 #include <QFont>
-#include <QTextCursor>
 #include <QRegularExpression>
 #include <QTimer>
 #include <QColor>
 #include <QPainter>
-#include <QTextDocument>
-#include <QTextBlock>
 #include <QScrollBar>
-#include <Qsci/qsciapis.h>
 #include <QImage>
 #include <QPixmap>
 #include <QPalette>
+#include <QToolTip>
 
 CodeEditor::CodeEditor(QWidget *parent)
     : QsciScintilla(parent), m_lexer(new QsciLexerPython(this)) {
@@ -67,8 +67,9 @@ CodeEditor::CodeEditor(QWidget *parent)
     setAutoIndent(true);
     
     // Включаем встроенный автокомплит QScintilla
-    // AcsAll = AcsDocument (слова из документа) + AcsAPIs (ключевые слова из API)
-    setAutoCompletionSource(QsciScintilla::AcsAll);
+    // Слова документа уже входят в слой редактора CompletionAPIs (из SymbolIndex),
+    // поэтому сканирование документа при каждом показе списка (AcsDocument) не нужно
+    setAutoCompletionSource(QsciScintilla::AcsAPIs);
     setAutoCompletionThreshold(2);
     setAutoCompletionCaseSensitivity(false);
     setAutoCompletionReplaceWord(true);
@@ -113,18 +114,33 @@ CodeEditor::CodeEditor(QWidget *parent)
     connect(this, &QsciScintilla::marginClicked, this, &CodeEditor::onMarginClicked);
     connect(this, &QsciScintilla::textChanged, this, &CodeEditor::onTextChanged);
     
-    // Создаем dummy document для совместимости
-    m_dummyDocument = new QTextDocument(this);
-    m_dummyDocument->setPlainText(text());
+    // Индекс идентификаторов для автодополнения обновляется по SCN_MODIFIED
+    m_symbolIndex = new SymbolIndex(this);
+    
+    // Дополнения сервера анализа относятся к одному слову: правка перед ним
+    // или уход курсора делают их неактуальными
+    connect(this, &QsciScintillaBase::SCN_CHARADDED, this, &CodeEditor::onCharAdded);
+    connect(this, &QsciScintilla::cursorPositionChanged, this, &CodeEditor::onCursorMoved);
+    connect(this, &QsciScintillaBase::SCN_MODIFIED, this,
+            [this](int position, int modificationType, const char *, int length) {
+                if (!(modificationType & (SC_MOD_INSERTTEXT | SC_MOD_DELETETEXT))) return;
+                if (m_semanticWordStart >= 0 && position < m_semanticWordStart) {
+                    clearSemanticCompletions();
+                }
+                // Подчеркивание ошибки сдвигается вместе с текстом - следим за его границами,
+                // чтобы при замене снять только его
+                if (m_syntaxErrorStart >= 0) {
+                    const int delta = (modificationType & SC_MOD_INSERTTEXT) ? length : -length;
+                    auto shift = [position, delta](int &bound) {
+                        if (bound > position) bound = qMax(position, bound + delta);
+                    };
+                    shift(m_syntaxErrorStart);
+                    shift(m_syntaxErrorEnd);
+                }
+            });
     
-    // Подключаем сигналы для совместимости с document()
-    connect(this, &QsciScintilla::textChanged, this, [this]() {
-        if (m_dummyDocument) {
-            m_dummyDocument->setPlainText(text());
-            // Эмулируем сигналы QTextDocument
-            emit m_dummyDocument->contentsChanged();
-        }
-    });
+    // Сигналы в стиле QTextDocument для MainWindow - без копии текста
+    m_document = new EditorDocument(this);
     
     // Применяем тему по умолчанию
     setTheme("light");
@@ -158,127 +174,76 @@ void CodeEditor::setupLexer() {
     // Устанавливаем лексер
     setLexer(m_lexer);
     
-    // Настраиваем API для автокомплита (ключевые слова Python)
-    QsciAPIs *apis = new QsciAPIs(m_lexer);
-    if (apis) {
-        // Добавляем ключевые слова Python
-        QStringList keywords = {
-            // Ключевые слова
-            "and", "as", "assert", "break", "class", "continue", "def", "del",
-            "elif", "else", "except", "False", "finally", "for", "from", "global",
-            "if", "import", "in", "is", "lambda", "None", "nonlocal", "not",
-            "or", "pass", "raise", "return", "True", "try", "while", "with", "yield",
-            // Встроенные функции
-            "abs", "all", "any", "ascii", "bin", "bool", "bytearray", "bytes",
-            "callable", "chr", "classmethod", "compile", "complex", "delattr", "dict", "dir",
-            "divmod", "enumerate", "eval", "exec", "filter", "float", "format", "frozenset",
-            "getattr", "globals", "hasattr", "hash", "help", "hex", "id", "input",
-            "int", "isinstance", "issubclass", "iter", "len", "list", "locals", "map",
-            "max", "memoryview", "min", "next", "object", "oct", "open", "ord",
-            "pow", "print", "property", "range", "repr", "reversed", "round", "set",
-            "setattr", "slice", "sorted", "staticmethod", "str", "sum", "super", "tuple",
-            "type", "vars", "zip", "__import__",
-            // Исключения
-            "BaseException", "Exception", "ArithmeticError", "AssertionError", "AttributeError",
-            "BufferError", "EOFError", "ImportError", "IndentationError", "IndexError",
-            "KeyError", "KeyboardInterrupt", "LookupError", "MemoryError", "NameError",
-            "NotImplementedError", "OSError", "OverflowError", "ReferenceError", "RuntimeError",
-            "StopIteration", "SyntaxError", "SystemError", "SystemExit", "TypeError",
-            "UnboundLocalError", "UnicodeError", "UnicodeDecodeError", "UnicodeEncodeError",
-            "UnicodeTranslateError", "ValueError", "ZeroDivisionError",
-            // Константы
-            "Ellipsis", "NotImplemented", "__debug__", "__name__", "__file__", "__doc__"
-        };
-        
-        for (const QString &keyword : keywords) {
-            apis->add(keyword);
-        }
-        
-        apis->prepare();
-        m_lexer->setAPIs(apis);
+    // Источник дополнений: общее базовое дерево + слова этого файла
+    m_completionAPIs = new CompletionAPIs(m_lexer);
+    m_lexer->setAPIs(m_completionAPIs);
+}
+
+void CodeEditor::setCompletionBase(std::shared_ptr<const CompletionTrie> base) {
+    if (m_completionAPIs) {
+        m_completionAPIs->setBase(std::move(base));
     }
 }
 
-void CodeEditor::updateAPIs(const QStringList &additionalWords) {
-    if (!m_lexer) return;
-    
-    // Безопасно получаем старый API
-    QsciAPIs *oldAPIs = nullptr;
-    QsciAbstractAPIs *oldAPIsAbstract = nullptr;
-    try {
-        oldAPIsAbstract = m_lexer->apis();
-        if (oldAPIsAbstract) {
-            oldAPIs = qobject_cast<QsciAPIs*>(oldAPIsAbstract);
-        }
-    } catch (...) {
-        // Игнорируем ошибки при получении старого API
-        oldAPIsAbstract = nullptr;
-        oldAPIs = nullptr;
+void CodeEditor::setCompletionWords(const QStringList &words) {
+    if (m_completionAPIs) {
+        m_completionAPIs->setDeltaWords(words);
     }
-    
-    // Отменяем подготовку старого API, если она идет
-    if (oldAPIs) {
-        try {
-            oldAPIs->cancelPreparation();
-        } catch (...) {
-            // Игнорируем ошибки при отмене подготовки
-        }
+}
+
+qint64 CodeEditor::completionMemoryUsage() const {
+    return m_completionAPIs ? m_completionAPIs->deltaMemoryUsage() : 0;
+}
+
+bool CodeEditor::semanticCompletionContext(int *line, int *column) const {
+    if (m_semanticWordStart < 0) return false;
+    const int wordLine = int(SendScintilla(SCI_LINEFROMPOSITION, static_cast<unsigned long>(m_semanticWordStart)));
+    const int bytes = m_semanticWordStart - int(SendScintilla(SCI_POSITIONFROMLINE, static_cast<unsigned long>(wordLine)));
+    // Позиции Scintilla - в байтах, сервер считает в символах
+    *line = wordLine + 1;
+    *column = isUtf8() ? QString::fromUtf8(text(wordLine).toUtf8().left(bytes)).length() : bytes;
+    return true;
+}
+
+void CodeEditor::setSemanticCompletions(const QStringList &words) {
+    if (m_semanticWordStart < 0 || !m_completionAPIs) return;
+    const bool attribute = m_semanticWordStart > 0
+        && SendScintilla(SCI_GETCHARAT, static_cast<unsigned long>(m_semanticWordStart - 1)) == '.';
+    m_completionAPIs->setSemanticWords(words, attribute);
+    // После точки список показывается сразу, для имен - только обновляется
+    if (isListActive() || attribute) {
+        autoCompleteFromAPIs();
     }
-    
-    // Создаем новый API объект
-    QsciAPIs *apis = new QsciAPIs(m_lexer);
-    if (!apis) return;
-    
-    // Добавляем базовые ключевые слова Python
-    QStringList keywords = {
-        // Ключевые слова
-        "and", "as", "assert", "break", "class", "continue", "def", "del",
-        "elif", "else", "except", "False", "finally", "for", "from", "global",
-        "if", "import", "in", "is", "lambda", "None", "nonlocal", "not",
-        "or", "pass", "raise", "return", "True", "try", "while", "with", "yield",
-        // Встроенные функции
-        "abs", "all", "any", "ascii", "bin", "bool", "bytearray", "bytes",
-        "callable", "chr", "classmethod", "compile", "complex", "delattr", "dict", "dir",
-        "divmod", "enumerate", "eval", "exec", "filter", "float", "format", "frozenset",
-        "getattr", "globals", "hasattr", "hash", "help", "hex", "id", "input",
-        "int", "isinstance", "issubclass", "iter", "len", "list", "locals", "map",
-        "max", "memoryview", "min", "next", "object", "oct", "open", "ord",
-        "pow", "print", "property", "range", "repr", "reversed", "round", "set",
-        "setattr", "slice", "sorted", "staticmethod", "str", "sum", "super", "tuple",
-        "type", "vars", "zip", "__import__",
-        // Исключения
-        "BaseException", "Exception", "ArithmeticError", "AssertionError", "AttributeError",
-        "BufferError", "EOFError", "ImportError", "IndentationError", "IndexError",
-        "KeyError", "KeyboardInterrupt", "LookupError", "MemoryError", "NameError",
-        "NotImplementedError", "OSError", "OverflowError", "ReferenceError", "RuntimeError",
-        "StopIteration", "SyntaxError", "SystemError", "SystemExit", "TypeError",
-        "UnboundLocalError", "UnicodeError", "UnicodeDecodeError", "UnicodeEncodeError",
-        "UnicodeTranslateError", "ValueError", "ZeroDivisionError",
-        // Константы
-        "Ellipsis", "NotImplemented", "__debug__", "__name__", "__file__", "__doc__"
-    };
-    
-    // Добавляем базовые ключевые слова
-    for (const QString &keyword : keywords) {
-        apis->add(keyword);
+}
+
+void CodeEditor::clearSemanticCompletions() {
+    m_semanticWordStart = -1;
+    if (m_completionAPIs) {
+        m_completionAPIs->clearSemanticWords();
     }
-    
-    // Добавляем дополнительные слова (например, задачи pyrob)
-    for (const QString &word : additionalWords) {
-        if (!word.isEmpty() && word.length() > 1) {
-            apis->add(word);
-        }
+}
+
+void CodeEditor::onCharAdded(int ch) {
+    const long position = SendScintilla(SCI_GETCURRENTPOS);
+    const int wordStart = int(SendScintilla(SCI_WORDSTARTPOSITION, static_cast<unsigned long>(position), 1L));
+    if (ch != '.') {
+        // Запрос - один раз на слово, а не на каждый символ; числа не дополняются
+        if (wordStart == m_semanticWordStart || wordStart >= position) return;
+        const int first = int(SendScintilla(SCI_GETCHARAT, static_cast<unsigned long>(wordStart)));
+        if (first >= '0' && first <= '9') return;
     }
-    
-    // Устанавливаем API в лексер
-    m_lexer->setAPIs(apis);
-    
-    // Подготавливаем API (асинхронно)
-    apis->prepare();
-    
-    // Старый API удалится автоматически при следующем вызове
-    if (oldAPIs) {
-        oldAPIs->deleteLater();
+    clearSemanticCompletions();
+    m_semanticWordStart = wordStart;
+    emit semanticCompletionRequested();
+}
+
+void CodeEditor::onCursorMoved(int line, int index) {
+    Q_UNUSED(line);
+    Q_UNUSED(index);
+    if (m_semanticWordStart < 0) return;
+    const long position = SendScintilla(SCI_GETCURRENTPOS);
+    if (SendScintilla(SCI_WORDSTARTPOSITION, static_cast<unsigned long>(position), 1L) != m_semanticWordStart) {
+        clearSemanticCompletions();
     }
 }
 
@@ -290,7 +255,8 @@ void CodeEditor::setupMargins() {
     setMarginWidth(0, 16); // Фиксированная ширина для брейкпоинтов (отдельная колонка)
     setMarginSensitivity(0, true);
     // Устанавливаем маску маркеров для margin 0 - брейкпоинты и маркер предпросмотра
-    setMarginMarkerMask(0, (1 << BREAKPOINT_MARKER) | (1 << BREAKPOINT_DISABLED_MARKER) | (1 << BREAKPOINT_HOVER_MARKER));
+    setMarginMarkerMask(0, (1 << BREAKPOINT_MARKER) | (1 << BREAKPOINT_DISABLED_MARKER) | (1 << BREAKPOINT_HOVER_MARKER)
+                               | (1 << SYNTAX_ERROR_MARKER));
     
     // Margin 1: номера строк - справа от брейкпоинтов
     setMarginType(1, QsciScintilla::NumberMargin);
@@ -324,6 +290,18 @@ void CodeEditor::setupIndicators() {
     // Используем только setMarkerBackgroundColor, который правильно конвертирует QColor
     QColor errorColor(255, 100, 100); // Яркий красный фон (R, G, B)
     setMarkerBackgroundColor(errorColor, ERROR_MARKER);
+    
+    // Строка, на которой остановлен отладчик (желтый фон)
+    markerDefine(QsciScintilla::Background, DEBUG_LINE_MARKER);
+    setMarkerBackgroundColor(QColor(255, 238, 150), DEBUG_LINE_MARKER);
+    
+    // Ошибка синтаксиса во время набора: подчеркивание в тексте и стрелка на полях
+    // (стрелка не путается с кружками брейкпоинтов и видна вместе с ними)
+    indicatorDefine(QsciScintilla::SquiggleIndicator, ERROR_INDICATOR);
+    setIndicatorForegroundColor(QColor(230, 30, 30), ERROR_INDICATOR);
+    markerDefine(QsciScintilla::RightArrow, SYNTAX_ERROR_MARKER);
+    setMarkerForegroundColor(QColor(230, 30, 30), SYNTAX_ERROR_MARKER);
+    setMarkerBackgroundColor(QColor(230, 30, 30), SYNTAX_ERROR_MARKER);
 }
 
 void CodeEditor::setCompleter(QCompleter *completer) {
@@ -659,6 +637,21 @@ void CodeEditor::mouseMoveEvent(QMouseEvent *e) {
             m_hoverBreakpointLine = -1;
         }
     }
+    
+    // Подсказка с текстом ошибки синтаксиса - над ее строкой на полях или над подчеркиванием
+    const int errorLine = m_syntaxErrorHandle >= 0 ? markerLine(m_syntaxErrorHandle) : -1;
+    const int textPosition = int(SendScintilla(QsciScintilla::SCI_POSITIONFROMPOINTCLOSE, pos.x(), pos.y()));
+    const bool overError = errorLine >= 0
+        && ((isOverMargin0 && line == errorLine)
+            || (textPosition >= 0
+                && SendScintilla(QsciScintilla::SCI_INDICATORVALUEAT, ERROR_INDICATOR, textPosition) != 0));
+    if (overError && !m_syntaxErrorMessage.isEmpty()) {
+        QToolTip::showText(e->globalPos(), m_syntaxErrorMessage, this);
+        m_syntaxToolTipShown = true;
+    } else if (m_syntaxToolTipShown) {
+        QToolTip::hideText();
+        m_syntaxToolTipShown = false;
+    }
 }
 
 void CodeEditor::leaveEvent(QEvent *e) {
@@ -843,6 +836,73 @@ void CodeEditor::clearErrorHighlight() {
     m_errorLineNumbers.clear();
 }
 
+void CodeEditor::setSyntaxError(int line, int column, int endLine, int endColumn, const QString &message) {
+    if (line < 0 || line >= lines()) {
+        clearSyntaxError();
+        return;
+    }
+    endLine = qBound(line, endLine, lines() - 1);
+    // Столбцы - в символах; позиция не выходит за конец строки (без перевода строки)
+    auto positionAt = [this](int lineNumber, int index) {
+        const int lineEnd = int(SendScintilla(SCI_GETLINEENDPOSITION, static_cast<unsigned long>(lineNumber)));
+        return qMin(positionFromLineIndex(lineNumber, qMax(index, 0)), lineEnd);
+    };
+    int start = positionAt(line, column);
+    int end = positionAt(endLine, endColumn);
+    if (end <= start) {
+        // Ошибка в конце строки (например, незакрытая скобка) - подчеркиваем последний символ
+        end = start;
+        start = end > positionFromLineIndex(line, 0)
+            ? int(SendScintilla(SCI_POSITIONBEFORE, static_cast<unsigned long>(end))) : end;
+        if (start == end) {
+            end = int(SendScintilla(SCI_POSITIONAFTER, static_cast<unsigned long>(start)));
+        }
+    }
+    
+    const int currentLine = m_syntaxErrorHandle >= 0 ? markerLine(m_syntaxErrorHandle) : -1;
+    if (start == m_syntaxErrorStart && end == m_syntaxErrorEnd && currentLine == line) {
+        m_syntaxErrorMessage = message; // Та же ошибка - ничего не перерисовываем
+        return;
+    }
+    clearSyntaxError();
+    m_syntaxErrorStart = start;
+    m_syntaxErrorEnd = end;
+    m_syntaxErrorMessage = message;
+    SendScintilla(SCI_SETINDICATORCURRENT, static_cast<unsigned long>(ERROR_INDICATOR));
+    SendScintilla(SCI_INDICATORFILLRANGE, static_cast<unsigned long>(start), static_cast<long>(end - start));
+    m_syntaxErrorHandle = markerAdd(line, SYNTAX_ERROR_MARKER);
+}
+
+void CodeEditor::clearSyntaxError() {
+    if (m_syntaxErrorStart < 0 && m_syntaxErrorHandle < 0) return;
+    // Снимаем только прежний диапазон, а не индикатор во всем документе
+    if (m_syntaxErrorStart >= 0 && m_syntaxErrorEnd > m_syntaxErrorStart) {
+        const int length = int(SendScintilla(SCI_GETLENGTH));
+        const int start = qMin(m_syntaxErrorStart, length);
+        const int end = qMin(m_syntaxErrorEnd, length);
+        SendScintilla(SCI_SETINDICATORCURRENT, static_cast<unsigned long>(ERROR_INDICATOR));
+        SendScintilla(SCI_INDICATORCLEARRANGE, static_cast<unsigned long>(start), static_cast<long>(end - start));
+    }
+    if (m_syntaxErrorHandle >= 0) {
+        markerDeleteHandle(m_syntaxErrorHandle);
+    }
+    m_syntaxErrorStart = -1;
+    m_syntaxErrorEnd = -1;
+    m_syntaxErrorHandle = -1;
+    m_syntaxErrorMessage.clear();
+    if (m_syntaxToolTipShown) {
+        QToolTip::hideText();
+        m_syntaxToolTipShown = false;
+    }
+}
+
+void CodeEditor::setDebugLine(int lineNumber) {
+    markerDeleteAll(DEBUG_LINE_MARKER);
+    if (lineNumber >= 0 && lineNumber < lines()) {
+        markerAdd(lineNumber, DEBUG_LINE_MARKER);
+    }
+}
+
 void CodeEditor::toggleBreakpoint(int lineNumber) {
     if (lineNumber < 0 || lineNumber >= lines()) return;
     
@@ -886,49 +946,28 @@ void CodeEditor::setTheme(const QString &theme) {
     applyTheme(theme);
 }
 
-QTextDocument *CodeEditor::document() const {
-    // QScintilla не использует QTextDocument напрямую
-    // Возвращаем dummy document для совместимости (создается в конструкторе)
-    return m_dummyDocument;
-}
-
 QString CodeEditor::toPlainText() const {
     return text();
 }
 
 void CodeEditor::setPlainText(const QString &text) {
     setText(text);
-    if (m_dummyDocument) {
-        m_dummyDocument->setPlainText(text);
-    }
 }
 
-QTextCursor CodeEditor::textCursor() const {
-    // Создаем QTextCursor из позиции в QScintilla
-    int line, index;
-    getCursorPosition(&line, &index);
-    if (m_dummyDocument) {
-        QTextCursor cursor(m_dummyDocument);
-        // Перемещаем курсор к нужной позиции
-        QTextBlock block = m_dummyDocument->findBlockByLineNumber(line);
-        if (block.isValid()) {
-            int pos = block.position() + qMin(index, block.length() - 1);
-            cursor.setPosition(pos);
-        }
-        return cursor;
-    }
-    return QTextCursor();
+void CodeEditor::enterLargeFileMode() {
+    if (m_largeFile) return;
+    m_largeFile = true;
+    // Индекс слов разбирал бы каждую строку файла - дополняем только общими словами
+    m_symbolIndex->setEnabled(false);
+    setCompletionWords(QStringList());
+    // Уровни сворачивания требуют разбора всего файла лексером
+    setFolding(QsciScintilla::NoFoldStyle);
+    SendScintilla(SCI_SETPROPERTY, "fold", "0");
 }
 
-void CodeEditor::setTextCursor(const QTextCursor &cursor) {
-    if (!m_dummyDocument) return;
-    
-    // Получаем позицию из QTextCursor и устанавливаем в QScintilla
-    int pos = cursor.position();
-    QTextBlock block = m_dummyDocument->findBlock(pos);
-    int line = block.blockNumber();
-    int index = pos - block.position();
-    setCursorPosition(line, index);
+void CodeEditor::setLoading(bool loading) {
+    m_loading = loading;
+    setReadOnly(loading);
 }
 
 void CodeEditor::centerCursor() {
@@ -939,24 +978,12 @@ void CodeEditor::centerCursor() {
 }
 
 bool CodeEditor::isModified() const {
-    // QScintilla использует SCI_GETMODIFY для проверки модификации
-    return SendScintilla(QsciScintilla::SCI_GETMODIFY) != 0;
+    return m_document->isModified();
 }
 
 void CodeEditor::setModified(bool modified) {
-    // QScintilla использует SCI_SETSAVEPOINT для сброса флага модификации
-    if (!modified) {
-        SendScintilla(QsciScintilla::SCI_SETSAVEPOINT);
-        if (m_dummyDocument) {
-            m_dummyDocument->setModified(false);
-        }
-        } else {
-        // Для установки флага модификации нужно изменить текст
-        // Но это не нужно, так как QScintilla автоматически отслеживает изменения
-        if (m_dummyDocument) {
-            m_dummyDocument->setModified(true);
-        }
-    }
+    // Флаг изменения хранит Scintilla (точка сохранения), установить его может только правка
+    m_document->setModified(modified);
 }
 
 void CodeEditor::applyTheme(const QString &theme) {
@@ -1051,6 +1078,7 @@ void CodeEditor::applyTheme(const QString &theme) {
         // Цвет маркера ошибок для светлой темы (яркий красный фон)
         QColor errorColorLight(255, 100, 100); // Яркий красный (R, G, B)
         setMarkerBackgroundColor(errorColorLight, ERROR_MARKER);
+        setMarkerBackgroundColor(QColor(255, 238, 150), DEBUG_LINE_MARKER);
     } else if (theme == "dark") {
         // Темная тема "Dark+" из VS Code
         setPaper(QColor(30, 30, 30));  // #1E1E1E - темный фон VS Code
@@ -1143,6 +1171,7 @@ void CodeEditor::applyTheme(const QString &theme) {
         // Цвет маркера ошибок для темной темы (красный фон, видимый на темном фоне)
         QColor errorColorDark(200, 50, 50); // Яркий красный, видимый на темном фоне (R, G, B)
         setMarkerBackgroundColor(errorColorDark, ERROR_MARKER);
+        setMarkerBackgroundColor(QColor(92, 82, 30), DEBUG_LINE_MARKER);
     }
     
     // Обновляем цвета маркеров брейкпоинтов (одинаковые для обеих тем)
@@ -7,12 +7,16 @@
 #include <QSet>
 #include <QPointer>
 #include <QStringListModel>
-#include <QTextDocument>
-#include <QTextBlock>
-#include <QTextCursor>
 #include <QPaintEvent>
 #include <QImage>
 
+#include <memory>
+
+class CompletionAPIs;
+class CompletionTrie;
+class EditorDocument;
+class SymbolIndex;
+
 class CodeEditor : public QsciScintilla {
     Q_OBJECT
 public:
@@ -26,28 +30,48 @@ public:
     void highlightErrorLines(const QList<int> &lineNumbers);
     void clearErrorHighlight();
     
-    // Обновление API для автокомплита
-    void updateAPIs(const QStringList &additionalWords = QStringList());
+    // Ошибка синтаксиса, найденная во время набора: волнистое подчеркивание, значок
+    // на полях и подсказка при наведении. line - с 0, column - символ в строке (с 0)
+    void setSyntaxError(int line, int column, int endLine, int endColumn, const QString &message);
+    void clearSyntaxError();
+    
+    // Автодополнение: общее базовое дерево и слова этого файла (объединяются при запросе)
+    void setCompletionBase(std::shared_ptr<const CompletionTrie> base);
+    void setCompletionWords(const QStringList &words);
+    qint64 completionMemoryUsage() const; // Байты слоя этого редактора (без общего дерева)
+    
+    // Дополнения от сервера анализа для слова, начатого последним
+    // (line - с 1, column - символ начала слова); false - слово уже не актуально
+    bool semanticCompletionContext(int *line, int *column) const;
+    void setSemanticCompletions(const QStringList &words);
+    SymbolIndex *symbolIndex() const { return m_symbolIndex; } // Идентификаторы документа
     
     // Точки останова
     QSet<int> breakpoints() const { return m_breakpoints; }
     void toggleBreakpoint(int lineNumber);
     void setBreakpoint(int lineNumber, bool enabled);
     bool hasBreakpoint(int lineNumber) const;
+    void setDebugLine(int lineNumber); // Строка, на которой остановлен отладчик (-1 - снять)
     
-    // Совместимость с QPlainTextEdit API
-    QTextDocument *document() const;
+    // Совместимость с QPlainTextEdit API (без копии текста - см. EditorDocument)
+    EditorDocument *document() const { return m_document; }
     QString toPlainText() const;
     void setPlainText(const QString &text);
+    
+    // Большой файл: без сворачивания и индекса слов, чтобы открываться сразу
+    void enterLargeFileMode();
+    bool isLargeFile() const { return m_largeFile; }
+    // Файл еще загружается (FileLoader): правка и сохранение недоступны
+    void setLoading(bool loading);
+    bool isLoading() const { return m_loading; }
     bool isModified() const;
     void setModified(bool modified);
-    QTextCursor textCursor() const;
-    void setTextCursor(const QTextCursor &cursor);
     void centerCursor();
 
 signals:
     void fontSizeChanged(int size);
     void breakpointToggled(int lineNumber, bool enabled);
+    void semanticCompletionRequested(); // Начато новое слово или введена точка
 
 protected:
     void keyPressEvent(QKeyEvent *e) override;
@@ -60,6 +84,8 @@ private slots:
     void insertCompletion(const QString &completion);
     void onMarginClicked(int margin, int line, Qt::KeyboardModifiers state);
     void onTextChanged();
+    void onCharAdded(int ch);
+    void onCursorMoved(int line, int index);
 
 private:
     void setupLexer();
@@ -68,6 +94,7 @@ private:
     void applyTheme(const QString &theme);
     void updateMarginWidths(); // Обновление ширины колонок при изменении размера шрифта
     void updateBreakpointMarkers(); // Обновление размера маркеров брейкпоинтов при изменении размера шрифта
+    void clearSemanticCompletions();
     
     // Создание изображения chevron (две палки, образующие угол)
     QImage createChevronImage(bool right, const QColor &color = QColor(0, 0, 0));  // true = вправо (>), false = вниз (⌄)
@@ -77,14 +104,26 @@ private:
     QString m_theme { "light" };
     QList<int> m_errorLineNumbers;
     QSet<int> m_breakpoints;
-    QTextDocument *m_dummyDocument { nullptr }; // Для совместимости с document()
+    EditorDocument *m_document { nullptr }; // Сигналы и флаг изменения в стиле QTextDocument
+    SymbolIndex *m_symbolIndex { nullptr };
+    CompletionAPIs *m_completionAPIs { nullptr }; // Принадлежит лексеру
+    int m_semanticWordStart { -1 }; // Позиция слова, для которого запрошены дополнения сервера
     int m_hoverBreakpointLine { -1 }; // Строка, где показывается предпросмотр брейкпоинта
+    int m_syntaxErrorStart { -1 };    // Подчеркнутый диапазон ошибки синтаксиса (позиции Scintilla)
+    int m_syntaxErrorEnd { -1 };
+    int m_syntaxErrorHandle { -1 };   // Маркер на полях (следует за строкой при правках)
+    QString m_syntaxErrorMessage;
+    bool m_syntaxToolTipShown { false };
     int m_currentFontSize { 10 }; // Текущий размер шрифта для отслеживания изменений
+    bool m_largeFile { false };
+    bool m_loading { false };
     
     // Индикаторы для ошибок и точек останова
-    static const int ERROR_INDICATOR = 0;
+    static const int ERROR_INDICATOR = 0; // Волнистое подчеркивание ошибки синтаксиса
     static const int ERROR_MARKER = 4; // Маркер для выделения строк с ошибками красным фоном
     static const int BREAKPOINT_MARKER = 1;
     static const int BREAKPOINT_DISABLED_MARKER = 2;
     static const int BREAKPOINT_HOVER_MARKER = 3; // Маркер для предпросмотра при наведении
+    static const int DEBUG_LINE_MARKER = 5; // Текущая строка отладчика
+    static const int SYNTAX_ERROR_MARKER = 6; // Значок ошибки синтаксиса на полях
 };
@@ -0,0 +1,131 @@
+#include "CompletionAPIs.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+qint64 stringsMemory(const QStringList &strings) {
+    qint64 bytes = 0;
+    for (const QString &word : strings) {
+        bytes += sizeof(QString) + qint64(word.capacity()) * sizeof(QChar);
+    }
+    return bytes;
+}
+
+// Слияние двух списков, отсортированных по ключу сравнения, без повторов
+QStringList mergeSorted(const QStringList &first, const QStringList &second) {
+    if (second.isEmpty()) return first;
+    if (first.isEmpty()) return second;
+    QStringList result;
+    result.reserve(first.size() + second.size());
+    int i = 0;
+    int j = 0;
+    while (i < first.size() || j < second.size()) {
+        QString word;
+        if (j >= second.size() || (i < first.size() && first.at(i).toCaseFolded() <= second.at(j).toCaseFolded())) {
+            word = first.at(i++);
+        } else {
+            word = second.at(j++);
+        }
+        if (result.isEmpty() || result.last() != word) {
+            result.append(word);
+        }
+    }
+    return result;
+}
+}
+
+void CompletionAPIs::WordLayer::assign(const QStringList &source) {
+    QVector<std::pair<QString, QString>> keyed;
+    keyed.reserve(source.size());
+    for (const QString &word : source) {
+        if (!word.isEmpty()) {
+            keyed.append({ word.toCaseFolded(), word });
+        }
+    }
+    std::sort(keyed.begin(), keyed.end());
+    keyed.erase(std::unique(keyed.begin(), keyed.end()), keyed.end());
+
+    folded.clear();
+    words.clear();
+    folded.reserve(keyed.size());
+    words.reserve(keyed.size());
+    for (const auto &entry : qAsConst(keyed)) {
+        folded.append(entry.first);
+        words.append(entry.second);
+    }
+}
+
+QStringList CompletionAPIs::WordLayer::withPrefix(const QString &foldedPrefix) const {
+    const auto begin = std::lower_bound(folded.constBegin(), folded.constEnd(), foldedPrefix);
+    int index = int(begin - folded.constBegin());
+    const int first = index;
+    while (index < folded.size() && folded.at(index).startsWith(foldedPrefix)) {
+        ++index;
+    }
+    return words.mid(first, index - first);
+}
+
+qint64 CompletionAPIs::WordLayer::memoryUsage() const {
+    return stringsMemory(folded) + stringsMemory(words);
+}
+
+CompletionAPIs::CompletionAPIs(QsciLexer *lexer)
+    : QsciAbstractAPIs(lexer), m_base(CompletionTrie::fallback()) {
+}
+
+void CompletionAPIs::setBase(std::shared_ptr<const CompletionTrie> base) {
+    m_base = base ? std::move(base) : CompletionTrie::fallback();
+}
+
+void CompletionAPIs::setDeltaWords(const QStringList &words) {
+    if (words == m_deltaWords) return;
+    m_deltaWords = words;
+    m_delta.assign(words);
+}
+
+void CompletionAPIs::setSemanticWords(const QStringList &words, bool attribute) {
+    m_semantic.assign(words);
+    m_semanticAttribute = attribute;
+    m_hasSemantic = true;
+}
+
+void CompletionAPIs::clearSemanticWords() {
+    if (!m_hasSemantic) return;
+    m_semantic = WordLayer();
+    m_hasSemantic = false;
+}
+
+qint64 CompletionAPIs::deltaMemoryUsage() const {
+    return sizeof(CompletionAPIs) + stringsMemory(m_deltaWords) + m_delta.memoryUsage() + m_semantic.memoryUsage();
+}
+
+void CompletionAPIs::updateAutoCompletionList(const QStringList &context, QStringList &list) {
+    if (context.isEmpty()) return;
+    const QString folded = context.last().toCaseFolded();
+
+    // "obj.attr": словарные слои не знают атрибутов - только ответ сервера анализа
+    if (context.size() > 1) {
+        if (m_hasSemantic && m_semanticAttribute) {
+            list += m_semantic.withPrefix(folded);
+        }
+        return;
+    }
+
+    // Все слои отсортированы по ключу сравнения - объединяем слиянием без повторов
+    QStringList words = m_base ? m_base->wordsWithPrefix(context.last()) : QStringList();
+    words = mergeSorted(words, m_delta.withPrefix(folded));
+    if (m_hasSemantic && !m_semanticAttribute) {
+        words = mergeSorted(words, m_semantic.withPrefix(folded));
+    }
+    list += words;
+}
+
+QStringList CompletionAPIs::callTips(const QStringList &context, int commas, QsciScintilla::CallTipsStyle style,
+                                     QList<int> &shifts) {
+    Q_UNUSED(context);
+    Q_UNUSED(commas);
+    Q_UNUSED(style);
+    Q_UNUSED(shifts);
+    return QStringList();
+}
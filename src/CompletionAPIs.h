@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CompletionTrie.h"
+
+#include <Qsci/qsciabstractapis.h>
+
+#include <memory>
+
+// Источник дополнений QScintilla для одного редактора: общее базовое дерево
+// (ключевые слова, builtins, модули, API pyrob) плюс небольшой слой слов этого
+// файла и задач pyrob. Слои объединяются в момент запроса, поэтому при обновлении
+// слов файла не нужно пересоздавать и заново готовить QsciAPIs.
+// Третий слой - ответ сервера анализа (CompletionServer) для текущего слова;
+// пока его нет, работают только словарные слои.
+class CompletionAPIs : public QsciAbstractAPIs {
+public:
+    explicit CompletionAPIs(QsciLexer *lexer);
+
+    void setBase(std::shared_ptr<const CompletionTrie> base);
+    void setDeltaWords(const QStringList &words); // Возвращает сразу, если список не изменился
+    void setSemanticWords(const QStringList &words, bool attribute); // attribute - дополнение после "obj."
+    void clearSemanticWords();
+    bool hasSemanticWords() const { return m_hasSemantic; }
+
+    qint64 deltaMemoryUsage() const; // Только слои этого редактора (базовое дерево общее)
+    qint64 baseMemoryUsage() const { return m_base ? m_base->memoryUsage() : 0; }
+
+    void updateAutoCompletionList(const QStringList &context, QStringList &list) override;
+    QStringList callTips(const QStringList &context, int commas, QsciScintilla::CallTipsStyle style,
+                         QList<int> &shifts) override;
+
+private:
+    // Слова, отсортированные по ключу сравнения (без учета регистра)
+    struct WordLayer {
+        QStringList folded;
+        QStringList words;
+
+        void assign(const QStringList &source);
+        QStringList withPrefix(const QString &foldedPrefix) const;
+        qint64 memoryUsage() const;
+    };
+
+    std::shared_ptr<const CompletionTrie> m_base;
+    QStringList m_deltaWords;   // Как передано (для сравнения)
+    WordLayer m_delta;
+    WordLayer m_semantic;
+    bool m_hasSemantic { false };
+    bool m_semanticAttribute { false };
+};
@@ -0,0 +1,234 @@
+#include "CompletionServer.h"
+
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+
+namespace {
+constexpr int MAX_FAILED_STARTS = 3;    // После стольких сбоев подряд сервер больше не запускается
+constexpr int RESTART_DELAY_MS = 1000;  // Пауза перед перезапуском после сбоя
+// Запросы обрабатываются по одному; столько без единого ответа - сервер завис
+// (например, на разборе огромного файла) и перезапускается
+constexpr int REQUEST_TIMEOUT_MS = 10000;
+}
+
+CompletionServer::CompletionServer(QObject *parent)
+    : QObject(parent) {
+    m_watchdog.setSingleShot(true);
+    m_watchdog.setInterval(REQUEST_TIMEOUT_MS);
+    connect(&m_watchdog, &QTimer::timeout, this, &CompletionServer::onRequestTimeout);
+}
+
+CompletionServer::~CompletionServer() {
+    stop();
+}
+
+void CompletionServer::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    m_failedStarts = 0;
+    if (m_enabled) {
+        start();
+    } else {
+        stop();
+        failPendingRequests();
+    }
+}
+
+void CompletionServer::setPythonPath(const QString &python) {
+    if (m_pythonPath == python) return;
+    m_pythonPath = python;
+    m_failedStarts = 0;
+    // Сервер анализирует модули своего интерпретатора - перезапускаем
+    stop();
+    failPendingRequests();
+    if (m_enabled) {
+        start();
+    }
+}
+
+void CompletionServer::setScript(const QString &script) {
+    if (m_script == script) return;
+    m_script = script;
+    stop();
+    failPendingRequests();
+    if (m_enabled) {
+        start();
+    }
+}
+
+int CompletionServer::complete(const QString &file, quint64 version, const std::function<QString()> &source,
+                               int line, int column) {
+    if (!m_enabled || !m_process || m_process->state() == QProcess::NotRunning) {
+        return 0;
+    }
+    const int id = m_nextId++;
+    QJsonObject request;
+    request.insert("id", id);
+    request.insert("method", "complete");
+    request.insert("line", line);
+    request.insert("column", column);
+    attachSource(request, file, version, source);
+    sendRequest(request);
+    return id;
+}
+
+int CompletionServer::check(const QString &file, quint64 version, const std::function<QString()> &source) {
+    if (!m_enabled || !m_process || m_process->state() == QProcess::NotRunning) {
+        return 0;
+    }
+    const int id = m_nextId++;
+    QJsonObject request;
+    request.insert("id", id);
+    request.insert("method", "check");
+    attachSource(request, file, version, source);
+    sendRequest(request);
+    return id;
+}
+
+void CompletionServer::cancel(int id) {
+    if (id <= 0) return;
+    QJsonObject request;
+    request.insert("method", "cancel");
+    request.insert("id", id);
+    send(request);
+}
+
+void CompletionServer::closeFile(const QString &file) {
+    if (!m_sentVersions.remove(file)) return;
+    QJsonObject request;
+    request.insert("method", "close");
+    request.insert("file", file);
+    send(request);
+}
+
+void CompletionServer::start() {
+    if (m_process || m_pythonPath.isEmpty() || m_script.isEmpty()) return;
+    if (m_failedStarts >= MAX_FAILED_STARTS) return;
+
+    m_process = new QProcess(this);
+    m_process->setProgram(m_pythonPath);
+    m_process->setArguments(QStringList() << "-c" << m_script);
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    // Сервер не должен находить модули в текущем каталоге IDE (сам он убирает его из sys.path)
+    m_process->setWorkingDirectory(QDir::tempPath());
+    // Предупреждения анализируемых модулей не нужны, а непрочитанный stderr
+    // мог бы заполнить канал и остановить сервер
+    m_process->setStandardErrorFile(QProcess::nullDevice());
+    connect(m_process, &QProcess::started, this, &CompletionServer::started);
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &CompletionServer::onReadyRead);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &CompletionServer::onFinished);
+    connect(m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            onFinished();
+        }
+    });
+    m_process->start();
+}
+
+void CompletionServer::stop() {
+    if (!m_process) return;
+    QProcess *process = m_process;
+    m_process = nullptr;
+    disconnect(process, nullptr, this, nullptr);
+    // Закрытый stdin - сигнал серверу завершиться
+    process->closeWriteChannel();
+    if (!process->waitForFinished(300)) {
+        process->kill();
+        process->waitForFinished(300);
+    }
+    delete process;
+    m_buffer.clear();
+    m_sentVersions.clear();
+    m_watchdog.stop();
+}
+
+void CompletionServer::failPendingRequests() {
+    const QSet<int> pending = m_pending;
+    m_pending.clear();
+    for (int id : pending) {
+        emit requestFailed(id);
+    }
+}
+
+void CompletionServer::attachSource(QJsonObject &request, const QString &file, quint64 version,
+                                    const std::function<QString()> &source) {
+    request.insert("file", file);
+    request.insert("version", QString::number(version));
+    const auto sent = m_sentVersions.constFind(file);
+    if (sent == m_sentVersions.constEnd() || sent.value() != version) {
+        request.insert("source", source());
+        m_sentVersions.insert(file, version);
+    }
+}
+
+void CompletionServer::send(const QJsonObject &message) {
+    if (!m_process) return;
+    m_process->write(QJsonDocument(message).toJson(QJsonDocument::Compact) + '\n');
+}
+
+void CompletionServer::sendRequest(const QJsonObject &request) {
+    m_pending.insert(request.value("id").toInt());
+    if (!m_watchdog.isActive()) {
+        m_watchdog.start();
+    }
+    send(request);
+}
+
+void CompletionServer::onReadyRead() {
+    if (!m_process) return;
+    m_buffer += m_process->readAllStandardOutput();
+    int newline;
+    while ((newline = m_buffer.indexOf('\n')) >= 0) {
+        const QByteArray line = m_buffer.left(newline);
+        m_buffer.remove(0, newline + 1);
+        const QJsonObject reply = QJsonDocument::fromJson(line).object();
+        const int id = reply.value("id").toInt();
+        if (id <= 0) continue;
+        m_failedStarts = 0;
+        // Сервер отвечает - отсчет ведется заново для следующего запроса в очереди
+        m_pending.remove(id);
+        if (m_pending.isEmpty()) {
+            m_watchdog.stop();
+        } else {
+            m_watchdog.start();
+        }
+        if (reply.contains("result")) {
+            emit completionsReady(id, reply.value("result").toArray());
+        } else if (reply.contains("diagnostics")) {
+            emit diagnosticsReady(id, reply.value("diagnostics").toArray());
+        } else if (reply.contains("error")) {
+            if (reply.value("error").toString() == "stale") {
+                // У сервера нет текста этой версии - следующий запрос передаст его заново
+                m_sentVersions.clear();
+            }
+            emit requestFailed(id);
+        }
+    }
+}
+
+void CompletionServer::onFinished() {
+    QProcess *process = m_process;
+    if (!process) return;
+    m_process = nullptr;
+    disconnect(process, nullptr, this, nullptr);
+    process->deleteLater();
+    m_buffer.clear();
+    m_sentVersions.clear();
+    m_watchdog.stop();
+    ++m_failedStarts;
+    failPendingRequests();
+    if (m_enabled) {
+        QTimer::singleShot(RESTART_DELAY_MS, this, &CompletionServer::start);
+    }
+}
+
+void CompletionServer::onRequestTimeout() {
+    // Без перезапуска зависший сервер оставил бы дополнение и проверку синтаксиса
+    // без ответов до конца сеанса; завершение процесса обработает onFinished()
+    if (m_process) {
+        m_process->kill();
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+
+class QProcess;
+
+// Фоновый сервер анализа кода (runtime/vuzhyk_completion.py) для дополнения
+// атрибутов ("obj.", "math.") и имен с учетом области видимости, а также для
+// проверки синтаксиса во время набора.
+// Долгоживущий процесс Python, обмен JSON-строками через stdin/stdout.
+// Запросы асинхронные: новый запрос для файла вытесняет ожидающий, ответ на
+// отмененный запрос не испускается. Текст файла передается только при смене
+// версии - сервер хранит его и кэширует разбор. Если ответа на запрос нет
+// слишком долго, сервер считается зависшим и перезапускается.
+class CompletionServer : public QObject {
+    Q_OBJECT
+public:
+    explicit CompletionServer(QObject *parent = nullptr);
+    ~CompletionServer() override;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+    void setPythonPath(const QString &python);
+    void setScript(const QString &script);
+
+    // line - с 1, column - символ начала дополняемого слова (с 0).
+    // source вызывается, только если сервер еще не видел эту версию файла.
+    // Возвращает номер запроса или 0, если сервер недоступен
+    int complete(const QString &file, quint64 version, const std::function<QString()> &source,
+                 int line, int column);
+    // Проверка синтаксиса компилятором выбранного интерпретатора. Текст передается так же, как в complete()
+    int check(const QString &file, quint64 version, const std::function<QString()> &source);
+    void cancel(int id);
+    void closeFile(const QString &file);
+
+signals:
+    void completionsReady(int id, const QJsonArray &items); // [{name, kind}]
+    // [{line, column, endLine, endColumn, message}], пустой массив - ошибок нет
+    void diagnosticsReady(int id, const QJsonArray &diagnostics);
+    // Ответа на запрос не будет: ошибка на сервере, у сервера нет текста этой версии
+    // (повторный запрос передаст его) или процесс завершился/перезапущен
+    void requestFailed(int id);
+    void started(); // Процесс запущен, в том числе после сбоя - можно повторить запросы
+
+private:
+    void start();
+    void stop();
+    void failPendingRequests();
+    void attachSource(QJsonObject &request, const QString &file, quint64 version,
+                      const std::function<QString()> &source);
+    void send(const QJsonObject &message);
+    void sendRequest(const QJsonObject &request);
+    void onReadyRead();
+    void onFinished();
+    void onRequestTimeout();
+
+    QPointer<QProcess> m_process;
+    QString m_pythonPath;
+    QString m_script;
+    bool m_enabled { false };
+    int m_nextId { 1 };
+    int m_failedStarts { 0 };           // Подряд аварийных завершений - чтобы не перезапускать бесконечно
+    QByteArray m_buffer;                // Неполная строка ответа
+    QHash<QString, quint64> m_sentVersions; // Файл -> версия, текст которой уже у сервера
+    QSet<int> m_pending;                // Запросы без ответа
+    QTimer m_watchdog;                  // Перезапуск сервера, если ответа нет слишком долго
+};
@@ -0,0 +1,152 @@
+#include "CompletionTrie.h"
+
+#include <algorithm>
+#include <utility>
+
+CompletionTrie::CompletionTrie(const QStringList &words) {
+    // Сортируем по ключу сравнения; одинаковые без учета регистра слова - по написанию
+    QVector<std::pair<QString, QString>> keyed;
+    keyed.reserve(words.size());
+    for (const QString &word : words) {
+        if (!word.isEmpty()) {
+            keyed.append({ word.toCaseFolded(), word });
+        }
+    }
+    std::sort(keyed.begin(), keyed.end());
+    keyed.erase(std::unique(keyed.begin(), keyed.end()), keyed.end());
+
+    m_nodes.append(Node());
+    m_words.reserve(keyed.size());
+    for (const auto &entry : qAsConst(keyed)) {
+        const int index = m_words.size();
+        m_words.append(entry.second);
+
+        int node = 0;
+        m_nodes[0].end = index + 1;
+        for (const QChar ch : entry.first) {
+            // Слова вставляются по порядку, поэтому нужный потомок - либо последний
+            // добавленный, либо новый после него
+            int child = m_nodes[node].firstChild;
+            int last = -1;
+            while (child != -1 && m_nodes[child].ch != ch) {
+                last = child;
+                child = m_nodes[child].nextSibling;
+            }
+            if (child == -1) {
+                Node created;
+                created.ch = ch;
+                created.begin = index;
+                child = m_nodes.size();
+                m_nodes.append(created);
+                if (last == -1) {
+                    m_nodes[node].firstChild = child;
+                } else {
+                    m_nodes[last].nextSibling = child;
+                }
+            }
+            m_nodes[child].end = index + 1;
+            node = child;
+        }
+    }
+    m_nodes.squeeze();
+}
+
+std::shared_ptr<const CompletionTrie> CompletionTrie::fallback() {
+    static const std::shared_ptr<const CompletionTrie> trie = std::make_shared<const CompletionTrie>(fallbackWords());
+    return trie;
+}
+
+QStringList CompletionTrie::fallbackWords() {
+    return QStringList({
+        // Ключевые слова Python
+        "False","await","else","import","pass","None","break","except","in","raise",
+        "True","class","finally","is","return","and","continue","for","lambda","try",
+        "as","def","from","nonlocal","while","assert","del","global","not","with",
+        "async","elif","if","or","yield",
+        // Встроенные функции
+        "abs","delattr","hash","memoryview","set","all","dict","help","min","setattr",
+        "any","dir","hex","next","slice","ascii","divmod","id","object","sorted",
+        "bin","enumerate","input","oct","staticmethod","bool","eval","int","open","str",
+        "breakpoint","exec","isinstance","ord","sum","bytearray","filter","issubclass","pow","super",
+        "bytes","float","iter","print","tuple","callable","format","len","property","type",
+        "chr","frozenset","list","range","vars","classmethod","getattr","locals","repr","zip",
+        "compile","globals","map","reversed","__import__","complex","hasattr","max","round",
+        // Константы и атрибуты модуля
+        "Ellipsis","NotImplemented","__debug__","__name__","__file__","__doc__",
+        // Встроенные исключения
+        "BaseException","Exception","ArithmeticError","AssertionError","AttributeError",
+        "BlockingIOError","BrokenPipeError","BufferError","BytesWarning",
+        "ChildProcessError","ConnectionAbortError","ConnectionError",
+        "ConnectionRefusedError","ConnectionResetError","DeprecationWarning",
+        "EOFError","EnvironmentError","FileExistsError",
+        "FileNotFoundError","FloatingPointError","FutureWarning","GeneratorExit",
+        "IOError","ImportError","ImportWarning","IndentationError","IndexError",
+        "InterruptedError","IsADirectoryError","KeyError","KeyboardInterrupt",
+        "LookupError","MemoryError","ModuleNotFoundError","NameError",
+        "NotImplementedError","OSError","OverflowError","PendingDeprecationWarning",
+        "PermissionError","ProcessLookupError","RecursionError","ReferenceError",
+        "ResourceWarning","RuntimeError","RuntimeWarning","StopAsyncIteration",
+        "StopIteration","SyntaxError","SyntaxWarning","SystemError","SystemExit",
+        "TabError","TimeoutError","TypeError","UnboundLocalError",
+        "UnicodeDecodeError","UnicodeEncodeError","UnicodeError",
+        "UnicodeTranslateError","UnicodeWarning","UserWarning","ValueError",
+        "Warning","WindowsError","ZeroDivisionError",
+        // Модули стандартной библиотеки
+        "abc","atexit","argparse","array","asyncio","base64","bdb","binascii","bisect",
+        "builtins","bz2","calendar","collections","concurrent","configparser","contextlib",
+        "copy","csv","ctypes","datetime","decimal","difflib","dis","doctest","email","enum",
+        "errno","faulthandler","filecmp","fileinput","fnmatch","fractions","functools",
+        "gc","getopt","getpass","gettext","glob","gzip","hashlib","heapq","hmac","html","http",
+        "imaplib","imp","importlib","inspect","io","ipaddress","itertools","json","keyword",
+        "linecache","locale","logging","lzma","math","mimetypes","mmap","modulefinder",
+        "multiprocessing","netrc","numbers","operator","os","pathlib","pdb","pickle","pipes",
+        "pkgutil","platform","plistlib","poplib","posixpath","pprint","profile","pstats","pty",
+        "pyclbr","pydoc","queue","quopri","random","re","readline","reprlib","resource",
+        "rlcompleter","sched","secrets","select","selectors","shelve","shlex","shutil",
+        "signal","site","smtpd","smtplib","socket","socketserver","sqlite3","ssl","stat",
+        "statistics","string","stringprep","struct","subprocess","symtable","sys","sysconfig",
+        "tabnanny","tarfile","tempfile","termios","textwrap","threading","time","timeit",
+        "tkinter","token","tokenize","traceback","tracemalloc","types","typing","unicodedata",
+        "unittest","urllib","uuid","venv","warnings","wave","weakref","webbrowser","xml",
+        "xmlrpc","zipapp","zipfile","zipimport","zlib"
+    });
+}
+
+QStringList CompletionTrie::wordsWithPrefix(const QString &prefix) const {
+    const int node = findNode(prefix.toCaseFolded());
+    if (node < 0) {
+        return QStringList();
+    }
+    return m_words.mid(m_nodes[node].begin, m_nodes[node].end - m_nodes[node].begin);
+}
+
+bool CompletionTrie::hasLongerWord(const QString &prefix) const {
+    const int node = findNode(prefix.toCaseFolded());
+    return node >= 0 && m_nodes[node].firstChild != -1;
+}
+
+qint64 CompletionTrie::memoryUsage() const {
+    qint64 bytes = sizeof(CompletionTrie) + qint64(m_nodes.capacity()) * sizeof(Node);
+    for (const QString &word : m_words) {
+        bytes += sizeof(QString) + qint64(word.capacity()) * sizeof(QChar);
+    }
+    return bytes;
+}
+
+int CompletionTrie::findNode(const QString &foldedPrefix) const {
+    if (m_nodes.isEmpty()) {
+        return -1;
+    }
+    int node = 0;
+    for (const QChar ch : foldedPrefix) {
+        int child = m_nodes[node].firstChild;
+        while (child != -1 && m_nodes[child].ch != ch) {
+            child = m_nodes[child].nextSibling;
+        }
+        if (child == -1) {
+            return -1;
+        }
+        node = child;
+    }
+    return node;
+}
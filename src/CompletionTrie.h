@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+
+// Неизменяемое префиксное дерево слов для автодополнения (без учета регистра).
+// Строится один раз для интерпретатора и разделяется всеми редакторами через
+// shared_ptr, поэтому запросы из разных вкладок не копируют и не перестраивают его.
+// Слова хранятся отсортированными по ключу сравнения, и поддерево каждого узла
+// соответствует непрерывному диапазону слов: поиск по префиксу стоит
+// O(длина префикса + число найденных слов).
+class CompletionTrie {
+public:
+    explicit CompletionTrie(const QStringList &words);
+
+    static std::shared_ptr<const CompletionTrie> fallback(); // Статический список (до интроспекции)
+    static QStringList fallbackWords();
+
+    QStringList wordsWithPrefix(const QString &prefix) const;
+    bool hasLongerWord(const QString &prefix) const; // Есть слово длиннее, начинающееся с prefix
+    int size() const { return m_words.size(); }
+    qint64 memoryUsage() const; // Приблизительный объем в байтах
+
+private:
+    struct Node {
+        QChar ch;               // Символ ребра из родителя (в нижнем регистре)
+        int firstChild { -1 };
+        int nextSibling { -1 };
+        int begin { 0 };        // Диапазон слов поддерева в m_words
+        int end { 0 };
+    };
+
+    int findNode(const QString &foldedPrefix) const;
+
+    QVector<Node> m_nodes;  // m_nodes[0] - корень
+    QStringList m_words;    // Исходное написание, в порядке ключей сравнения
+};
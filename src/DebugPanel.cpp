@@ -0,0 +1,110 @@
+#include "DebugPanel.h"
+
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QJsonObject>
+#include <QSplitter>
+#include <QTreeWidget>
+
+namespace {
+constexpr int REF_ROLE = Qt::UserRole;          // Номер объекта для запроса expand
+constexpr int LOADED_ROLE = Qt::UserRole + 1;   // Содержимое уже запрошено
+constexpr int PATH_ROLE = Qt::UserRole;         // Кадр стека: путь к файлу
+constexpr int LINE_ROLE = Qt::UserRole + 1;     // Кадр стека: строка (с 1)
+}
+
+DebugPanel::DebugPanel(QWidget *parent)
+    : QWidget(parent) {
+    auto *layout = new QHBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    auto *splitter = new QSplitter(Qt::Horizontal, this);
+
+    m_variablesTree = new QTreeWidget(splitter);
+    m_variablesTree->setHeaderLabels(QStringList() << tr("Имя") << tr("Тип") << tr("Значение"));
+    m_variablesTree->setUniformRowHeights(true);
+    m_variablesTree->header()->setStretchLastSection(true);
+    connect(m_variablesTree, &QTreeWidget::itemExpanded, this, &DebugPanel::onItemExpanded);
+
+    m_stackTree = new QTreeWidget(splitter);
+    m_stackTree->setHeaderLabels(QStringList() << tr("Функция") << tr("Строка") << tr("Файл"));
+    m_stackTree->setRootIsDecorated(false);
+    m_stackTree->setUniformRowHeights(true);
+    connect(m_stackTree, &QTreeWidget::itemClicked, this, &DebugPanel::onStackItemClicked);
+
+    splitter->addWidget(m_variablesTree);
+    splitter->addWidget(m_stackTree);
+    splitter->setStretchFactor(0, 2);
+    splitter->setStretchFactor(1, 1);
+    layout->addWidget(splitter);
+}
+
+void DebugPanel::setStack(const QJsonArray &frames) {
+    m_stackTree->clear();
+    for (const QJsonValue &value : frames) {
+        const QJsonObject frame = value.toObject();
+        const QString path = frame.value("file").toString();
+        auto *item = new QTreeWidgetItem(m_stackTree);
+        item->setText(0, frame.value("function").toString());
+        item->setText(1, QString::number(frame.value("line").toInt()));
+        item->setText(2, QFileInfo(path).fileName());
+        item->setToolTip(2, path);
+        item->setData(0, PATH_ROLE, path);
+        item->setData(0, LINE_ROLE, frame.value("line").toInt());
+    }
+    if (m_stackTree->topLevelItemCount() > 0) {
+        m_stackTree->setCurrentItem(m_stackTree->topLevelItem(0));
+    }
+}
+
+void DebugPanel::setVariables(const QJsonArray &variables) {
+    m_variablesTree->clear();
+    m_pendingItems.clear();
+    addVariables(m_variablesTree->invisibleRootItem(), variables);
+}
+
+void DebugPanel::setChildren(int ref, const QJsonArray &variables) {
+    QTreeWidgetItem *item = m_pendingItems.take(ref);
+    if (!item) return;
+    // Убираем заглушку "Загрузка..."
+    qDeleteAll(item->takeChildren());
+    addVariables(item, variables);
+}
+
+void DebugPanel::clear() {
+    m_variablesTree->clear();
+    m_stackTree->clear();
+    m_pendingItems.clear();
+}
+
+void DebugPanel::onItemExpanded(QTreeWidgetItem *item) {
+    if (item->data(0, LOADED_ROLE).toBool()) return;
+    const int ref = item->data(0, REF_ROLE).toInt();
+    if (ref <= 0) return;
+    item->setData(0, LOADED_ROLE, true);
+    m_pendingItems.insert(ref, item);
+    emit expandRequested(ref);
+}
+
+void DebugPanel::onStackItemClicked(QTreeWidgetItem *item) {
+    emit frameSelected(m_stackTree->indexOfTopLevelItem(item),
+                       item->data(0, PATH_ROLE).toString(),
+                       item->data(0, LINE_ROLE).toInt());
+}
+
+void DebugPanel::addVariables(QTreeWidgetItem *parent, const QJsonArray &variables) {
+    for (const QJsonValue &value : variables) {
+        const QJsonObject variable = value.toObject();
+        auto *item = new QTreeWidgetItem(parent);
+        item->setText(0, variable.value("name").toString());
+        item->setText(1, variable.value("type").toString());
+        item->setText(2, variable.value("value").toString());
+        item->setToolTip(2, variable.value("value").toString());
+        const int ref = variable.value("ref").toInt();
+        if (ref > 0) {
+            // Заглушка, чтобы у узла была стрелка раскрытия
+            item->setData(0, REF_ROLE, ref);
+            new QTreeWidgetItem(item, QStringList() << tr("Загрузка..."));
+        }
+    }
+}
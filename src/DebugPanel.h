@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QWidget>
+#include <QHash>
+#include <QJsonArray>
+
+class QTreeWidget;
+class QTreeWidgetItem;
+
+// Панель отладчика: переменные выбранного кадра и стек вызовов.
+// Значения приходят уже укороченными (reprlib), а содержимое коллекций и объектов
+// запрашивается у отлаживаемого процесса только при раскрытии узла.
+class DebugPanel : public QWidget {
+    Q_OBJECT
+public:
+    explicit DebugPanel(QWidget *parent = nullptr);
+
+    void setStack(const QJsonArray &frames);
+    void setVariables(const QJsonArray &variables);
+    void setChildren(int ref, const QJsonArray &variables);
+    void clear();
+
+signals:
+    void expandRequested(int ref);
+    void frameSelected(int index, const QString &path, int line);
+
+private slots:
+    void onItemExpanded(QTreeWidgetItem *item);
+    void onStackItemClicked(QTreeWidgetItem *item);
+
+private:
+    void addVariables(QTreeWidgetItem *parent, const QJsonArray &variables);
+
+    QTreeWidget *m_variablesTree { nullptr };
+    QTreeWidget *m_stackTree { nullptr };
+    QHash<int, QTreeWidgetItem*> m_pendingItems; // Узлы, ожидающие содержимого от процесса
+};
@@ -0,0 +1,77 @@
+#include "EditorDocument.h"
+
+#include <Qsci/qsciscintilla.h>
+
+EditorDocument::EditorDocument(QsciScintilla *editor)
+    : QObject(editor), m_editor(editor) {
+    connect(m_editor, &QsciScintilla::textChanged, this, [this]() {
+        emit contentsChanged();
+        updateUndoState();
+    });
+    connect(m_editor, &QsciScintilla::modificationChanged, this, [this](bool modified) {
+        emit modificationChanged(modified);
+        // Точка сохранения не меняет стек отмены, но после загрузки файла он сбрасывается
+        updateUndoState();
+    });
+}
+
+bool EditorDocument::isModified() const {
+    return m_editor->SendScintilla(QsciScintillaBase::SCI_GETMODIFY) != 0;
+}
+
+void EditorDocument::setModified(bool modified) {
+    if (!modified) {
+        // modificationChanged придет от Scintilla (SCN_SAVEPOINTREACHED)
+        m_editor->SendScintilla(QsciScintillaBase::SCI_SETSAVEPOINT);
+    }
+}
+
+bool EditorDocument::isEmpty() const {
+    return length() == 0;
+}
+
+bool EditorDocument::isUndoAvailable() const {
+    return m_editor->SendScintilla(QsciScintillaBase::SCI_CANUNDO) != 0;
+}
+
+bool EditorDocument::isRedoAvailable() const {
+    return m_editor->SendScintilla(QsciScintillaBase::SCI_CANREDO) != 0;
+}
+
+int EditorDocument::length() const {
+    return int(m_editor->SendScintilla(QsciScintillaBase::SCI_GETLENGTH));
+}
+
+int EditorDocument::lineCount() const {
+    return int(m_editor->SendScintilla(QsciScintillaBase::SCI_GETLINECOUNT));
+}
+
+int EditorDocument::positionFromLine(int line) const {
+    return int(m_editor->SendScintilla(QsciScintillaBase::SCI_POSITIONFROMLINE, static_cast<unsigned long>(line)));
+}
+
+int EditorDocument::lineFromPosition(int position) const {
+    return int(m_editor->SendScintilla(QsciScintillaBase::SCI_LINEFROMPOSITION, static_cast<unsigned long>(position)));
+}
+
+QString EditorDocument::lineText(int line) const {
+    if (line < 0 || line >= lineCount()) return QString();
+    QString text = m_editor->text(line);
+    while (text.endsWith(QLatin1Char('\n')) || text.endsWith(QLatin1Char('\r'))) {
+        text.chop(1);
+    }
+    return text;
+}
+
+void EditorDocument::updateUndoState() {
+    const bool undo = isUndoAvailable();
+    const bool redo = isRedoAvailable();
+    if (undo != m_undoAvailable) {
+        m_undoAvailable = undo;
+        emit undoAvailable(undo);
+    }
+    if (redo != m_redoAvailable) {
+        m_redoAvailable = redo;
+        emit redoAvailable(redo);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+class QsciScintilla;
+
+// Тонкая обертка над документом Scintilla с подмножеством API QTextDocument,
+// которым пользуется остальной код (флаг изменения и сигналы правок, отмены и повтора).
+// Текст хранится только в самом редакторе: позиции и строки запрашиваются у Scintilla
+// напрямую, поэтому обертка не занимает памяти на копию файла и не отстает от правок.
+class EditorDocument : public QObject {
+    Q_OBJECT
+public:
+    explicit EditorDocument(QsciScintilla *editor);
+
+    bool isModified() const;
+    void setModified(bool modified); // true не поддерживается Scintilla - флаг ставит только правка
+    bool isEmpty() const;
+
+    bool isUndoAvailable() const;
+    bool isRedoAvailable() const;
+
+    // Позиции Scintilla (байты UTF-8); строки - с 0
+    int length() const;
+    int lineCount() const;
+    int positionFromLine(int line) const;
+    int lineFromPosition(int position) const;
+    QString lineText(int line) const; // Без перевода строки
+
+signals:
+    void contentsChanged();
+    void modificationChanged(bool modified);
+    void undoAvailable(bool available);
+    void redoAvailable(bool available);
+
+private:
+    void updateUndoState();
+
+    QsciScintilla *m_editor { nullptr };
+    bool m_undoAvailable { false };
+    bool m_redoAvailable { false };
+};
@@ -0,0 +1,107 @@
+#include "FileLoader.h"
+
+#include <Qsci/qsciscintilla.h>
+
+#include <QByteArray>
+#include <QTimer>
+
+namespace {
+constexpr qint64 CHUNK_SIZE = 1024 * 1024; // Столько байт добавляется за один проход цикла событий
+}
+
+FileLoader::FileLoader(const QString &path, QObject *parent)
+    : QObject(parent), m_file(path) {
+}
+
+bool FileLoader::open(QString *error) {
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (error) *error = m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    // Пустой файл отобразить нельзя; если отображение не удалось, читаем файл по частям
+    m_data = m_size > 0 ? m_file.map(0, m_size) : nullptr;
+
+    // BOM UTF-8 в документ не попадает (как при чтении через QTextStream)
+    QByteArray head = m_data ? QByteArray::fromRawData(reinterpret_cast<const char *>(m_data), int(qMin<qint64>(m_size, 3)))
+                             : m_file.peek(3);
+    if (head.startsWith("\xEF\xBB\xBF")) {
+        m_offset = 3;
+        if (!m_data) m_file.seek(3);
+    }
+    return true;
+}
+
+void FileLoader::load(QsciScintilla *editor) {
+    m_editor = editor;
+    // Отмена для загрузки не нужна: документ открыт с диска, а не правился
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETUNDOCOLLECTION, 0UL);
+    while (m_offset < m_size) {
+        appendChunk(m_size - m_offset);
+    }
+    finish();
+}
+
+void FileLoader::start(QsciScintilla *editor) {
+    m_editor = editor;
+    m_running = true;
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETUNDOCOLLECTION, 0UL);
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETREADONLY, 1UL);
+    // Буфер Scintilla выделяется один раз, а не растет с каждой частью
+    m_editor->SendScintilla(QsciScintillaBase::SCI_ALLOCATE, static_cast<unsigned long>(m_size + 1));
+    QTimer::singleShot(0, this, &FileLoader::appendNextChunk);
+}
+
+void FileLoader::appendChunk(qint64 length) {
+    length = qMin(length, m_size - m_offset);
+    if (m_data) {
+        m_editor->SendScintilla(QsciScintillaBase::SCI_APPENDTEXT, static_cast<unsigned long>(length),
+                                reinterpret_cast<const char *>(m_data + m_offset));
+        m_offset += length;
+        return;
+    }
+    const QByteArray bytes = m_file.read(length);
+    if (bytes.isEmpty()) {
+        m_offset = m_size; // Файл укоротился во время чтения
+        return;
+    }
+    m_editor->SendScintilla(QsciScintillaBase::SCI_APPENDTEXT, static_cast<unsigned long>(bytes.size()),
+                            bytes.constData());
+    m_offset += bytes.size();
+}
+
+void FileLoader::appendNextChunk() {
+    if (!m_running || !m_editor) return;
+    // Между частями редактор закрыт для правки, чтобы ввод не смешался с текстом файла
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETREADONLY, 0UL);
+    appendChunk(CHUNK_SIZE);
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETREADONLY, 1UL);
+    // Документ не считается измененным, пока файл не загружен целиком
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETSAVEPOINT);
+
+    const int percent = m_size > 0 ? int(m_offset * 100 / m_size) : 100;
+    if (percent != m_lastPercent) {
+        m_lastPercent = percent;
+        emit progress(percent);
+    }
+    if (m_offset < m_size) {
+        QTimer::singleShot(0, this, &FileLoader::appendNextChunk);
+        return;
+    }
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETREADONLY, 0UL);
+    finish();
+    m_running = false;
+    emit finished();
+}
+
+void FileLoader::finish() {
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+    m_file.close();
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETUNDOCOLLECTION, 1UL);
+    m_editor->SendScintilla(QsciScintillaBase::SCI_EMPTYUNDOBUFFER);
+    m_editor->SendScintilla(QsciScintillaBase::SCI_SETSAVEPOINT);
+    m_editor->SendScintilla(QsciScintillaBase::SCI_GOTOPOS, 0UL);
+}
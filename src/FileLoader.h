@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QFile>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+class QsciScintilla;
+
+// Загрузка файла в редактор без промежуточных копий: файл отображается в память
+// (QFile::map), а байты UTF-8 передаются Scintilla через SCI_APPENDTEXT.
+// Небольшие файлы загружаются сразу (load), большие - частями между событиями
+// (start), чтобы окно не замирало; ход загрузки сообщается сигналом progress.
+// Пока загрузка идет, документ остается неизмененным и закрыт для правки.
+class FileLoader : public QObject {
+    Q_OBJECT
+public:
+    explicit FileLoader(const QString &path, QObject *parent = nullptr);
+
+    bool open(QString *error); // false - файл не открыт (текст ошибки в error)
+    qint64 size() const { return m_size; }
+
+    void load(QsciScintilla *editor);  // Весь файл синхронно
+    void start(QsciScintilla *editor); // Частями через цикл событий; по окончании - finished()
+    bool isRunning() const { return m_running; }
+
+signals:
+    void progress(int percent);
+    void finished();
+
+private:
+    void appendChunk(qint64 length);
+    void appendNextChunk();
+    void finish();
+
+    QPointer<QsciScintilla> m_editor;
+    QFile m_file;
+    const uchar *m_data { nullptr }; // Отображение файла; nullptr - читаем через QFile
+    qint64 m_size { 0 };
+    qint64 m_offset { 0 };
+    bool m_running { false };
+    int m_lastPercent { -1 };
+};
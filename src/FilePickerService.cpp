@@ -0,0 +1,159 @@
+#include "FilePickerService.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+
+#include <utility>
+
+#ifdef Q_OS_WIN
+#  include <windows.h>
+#endif
+
+FilePickerService::FilePickerService(QObject *parent)
+    : QObject(parent) {
+}
+
+FilePickerService::~FilePickerService() {
+    if (!m_process) return;
+    disconnect(m_process, nullptr, this, nullptr);
+    // Закрытый stdin - сигнал помощнику завершиться
+    m_process->closeWriteChannel();
+    if (!m_process->waitForFinished(300)) {
+        m_process->kill();
+        m_process->waitForFinished(300);
+    }
+}
+
+QString FilePickerService::helperPath() {
+    return QCoreApplication::applicationDirPath() + "/FilePicker.exe";
+}
+
+bool FilePickerService::isAvailable() {
+    return QFile::exists(helperPath());
+}
+
+QStringList FilePickerService::pickerArguments(const QString &filter, const QString &initialDir,
+                                               bool isSave, bool isDirectory) {
+    // Помощнику нужно одно расширение: "Python файлы (*.py *.pyw);;..." -> ".py"
+    QString extension;
+    const QString firstFilter = filter.split(";;").first();
+    const int openBrace = firstFilter.lastIndexOf('(');
+    const int closeBrace = firstFilter.lastIndexOf(')');
+    if (openBrace >= 0 && closeBrace > openBrace) {
+        const QStringList patterns = firstFilter.mid(openBrace + 1, closeBrace - openBrace - 1)
+            .split(' ', QString::SkipEmptyParts);
+        if (!patterns.isEmpty()) {
+            extension = patterns.first();
+            if (extension.startsWith('*')) {
+                extension = extension.mid(1);
+            }
+        }
+    }
+    if (extension.isEmpty()) {
+        extension = ".py";
+    }
+
+    QStringList arguments;
+    arguments << "-e" << extension;
+    if (!initialDir.isEmpty()) {
+        arguments << "-d" << QDir::toNativeSeparators(QDir(initialDir).absolutePath());
+    }
+    if (isSave) {
+        arguments << "-s";
+    }
+    if (isDirectory) {
+        arguments << "--dir";
+    }
+    return arguments;
+}
+
+void FilePickerService::warmUp() {
+    if (isAvailable()) {
+        start();
+    }
+}
+
+void FilePickerService::pick(const QString &filter, const QString &initialDir, bool isSave, bool isDirectory,
+                             Callback callback) {
+    m_queue.enqueue({ pickerArguments(filter, initialDir, isSave, isDirectory), std::move(callback) });
+    sendNext();
+}
+
+void FilePickerService::start() {
+    if (m_process) return;
+    m_process = new QProcess(this);
+    m_process->setProgram(helperPath());
+    m_process->setArguments(QStringList() << "--serve");
+    m_process->setStandardErrorFile(QProcess::nullDevice());
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &FilePickerService::onReadyRead);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &FilePickerService::onFinished);
+    connect(m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            onFinished();
+        }
+    });
+    m_process->start();
+}
+
+void FilePickerService::sendNext() {
+    if (m_busy || m_queue.isEmpty()) return;
+    if (!isAvailable()) {
+        // Помощника нет - отвечаем сразу, чтобы вызывающий не ждал
+        const Request request = m_queue.dequeue();
+        if (request.callback) {
+            request.callback(QString());
+        }
+        sendNext();
+        return;
+    }
+    const Request request = m_queue.dequeue();
+    m_current = request.callback;
+    m_busy = true;
+    start();
+    if (!m_process) return; // Не запустился - onFinished уже ответил на запрос
+#ifdef Q_OS_WIN
+    // Уже запущенному процессу Windows не дает вывести окно на передний план без разрешения
+    AllowSetForegroundWindow(DWORD(m_process->processId()));
+#endif
+    m_process->write(request.arguments.join('\t').toUtf8() + '\n');
+}
+
+void FilePickerService::onReadyRead() {
+    if (!m_process) return;
+    m_buffer += m_process->readAllStandardOutput();
+    int newline;
+    while ((newline = m_buffer.indexOf('\n')) >= 0) {
+        const QString path = QString::fromUtf8(m_buffer.left(newline)).trimmed();
+        m_buffer.remove(0, newline + 1);
+        if (!m_busy) continue;
+        m_busy = false;
+        const Callback callback = std::move(m_current);
+        m_current = nullptr;
+        if (callback) {
+            callback(path);
+        }
+    }
+    sendNext();
+}
+
+void FilePickerService::onFinished() {
+    QProcess *process = m_process;
+    if (!process) return;
+    m_process = nullptr;
+    disconnect(process, nullptr, this, nullptr);
+    process->deleteLater();
+    m_buffer.clear();
+    // Помощник завершился посреди запроса - выбор не состоялся; следующий запрос запустит его заново
+    if (m_busy) {
+        m_busy = false;
+        const Callback callback = std::move(m_current);
+        m_current = nullptr;
+        if (callback) {
+            callback(QString());
+        }
+    }
+    sendNext();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QByteArray>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+class QProcess;
+
+// Системный диалог выбора файла через помощник FilePicker.exe.
+// Помощник запускается один раз с ключом --serve и остается работать между запросами,
+// поэтому запуск процесса и инициализация COM оплачиваются только при первом выборе.
+// Протокол: строка запроса (аргументы через табуляцию) в stdin, строка с путем в stdout;
+// пустая строка - выбор отменен. Запросы выполняются по очереди, результат - в callback.
+class FilePickerService : public QObject {
+    Q_OBJECT
+public:
+    using Callback = std::function<void(const QString &path)>;
+
+    explicit FilePickerService(QObject *parent = nullptr);
+    ~FilePickerService() override;
+
+    static bool isAvailable(); // FilePicker.exe лежит рядом с программой
+    void warmUp();             // Запуск помощника заранее, до первого запроса
+    // filter - в формате QFileDialog ("Python файлы (*.py)"); пустой путь в callback -
+    // отмена или сбой помощника
+    void pick(const QString &filter, const QString &initialDir, bool isSave, bool isDirectory,
+              Callback callback);
+
+private:
+    struct Request {
+        QStringList arguments;
+        Callback callback;
+    };
+
+    static QString helperPath();
+    static QStringList pickerArguments(const QString &filter, const QString &initialDir,
+                                       bool isSave, bool isDirectory);
+    void start();
+    void sendNext();
+    void onReadyRead();
+    void onFinished();
+
+    QPointer<QProcess> m_process;
+    QQueue<Request> m_queue;
+    Callback m_current;       // Запрос, диалог которого сейчас открыт
+    bool m_busy { false };
+    QByteArray m_buffer;      // Неполная строка ответа
+};
@@ -0,0 +1,202 @@
+#include "HelpStore.h"
+
+#include <QPair>
+#include <QtEndian>
+
+#include <algorithm>
+
+// Сгенерированный help_pack.cpp
+extern const unsigned char HELP_PACK_DATA[];
+extern const unsigned int HELP_PACK_SIZE;
+
+namespace {
+constexpr char PACK_MAGIC[] = "VZHP";
+constexpr quint32 PACK_VERSION = 1;
+constexpr int MIN_TERM_LENGTH = 2; // Как в build_help_pack.py
+constexpr int POSTING_BYTES = 4;
+
+// Последовательное чтение пакета с проверкой границ: поврежденный пакет не читается за пределы
+class PackReader {
+public:
+    explicit PackReader(const QByteArray &data)
+        : m_data(data) {
+    }
+
+    int position() const { return m_position; }
+
+    bool skip(qint64 bytes) {
+        if (bytes < 0 || m_position + bytes > m_data.size()) return false;
+        m_position += int(bytes);
+        return true;
+    }
+
+    bool readUInt16(quint16 *value) {
+        if (m_position + 2 > m_data.size()) return false;
+        *value = qFromBigEndian<quint16>(m_data.constData() + m_position);
+        m_position += 2;
+        return true;
+    }
+
+    bool readUInt32(quint32 *value) {
+        if (m_position + 4 > m_data.size()) return false;
+        *value = qFromBigEndian<quint32>(m_data.constData() + m_position);
+        m_position += 4;
+        return true;
+    }
+
+    bool readString(QByteArray *value) {
+        quint16 length = 0;
+        if (!readUInt16(&length) || m_position + length > m_data.size()) return false;
+        *value = m_data.mid(m_position, length);
+        m_position += length;
+        return true;
+    }
+
+private:
+    const QByteArray &m_data;
+    int m_position { 0 };
+};
+
+bool isWordChar(QChar ch) {
+    return ch.isLetterOrNumber() || ch == '_';
+}
+}
+
+HelpStore::HelpStore()
+    : m_data(qUncompress(HELP_PACK_DATA, int(HELP_PACK_SIZE))) {
+    if (!parse()) {
+        m_pages.clear();
+        m_keys.clear();
+        m_terms.clear();
+        m_data.clear();
+    }
+}
+
+bool HelpStore::parse() {
+    if (!m_data.startsWith(PACK_MAGIC)) return false;
+    PackReader reader(m_data);
+    quint32 version = 0;
+    if (!reader.skip(4) || !reader.readUInt32(&version) || version != PACK_VERSION) return false;
+
+    quint32 pageCount = 0;
+    if (!reader.readUInt32(&pageCount)) return false;
+    m_pages.reserve(int(pageCount));
+    for (quint32 i = 0; i < pageCount; ++i) {
+        QByteArray key;
+        Page page;
+        if (!reader.readString(&key) || !reader.readUInt32(&page.offset) || !reader.readUInt32(&page.length)) {
+            return false;
+        }
+        if (qint64(page.offset) + page.length > m_data.size()) return false;
+        m_keys.append(QString::fromUtf8(key));
+        m_pages.insert(m_keys.last(), page);
+    }
+
+    quint32 termCount = 0;
+    if (!reader.readUInt32(&termCount)) return false;
+    m_terms.reserve(int(termCount));
+    for (quint32 i = 0; i < termCount; ++i) {
+        Term term;
+        if (!reader.readString(&term.word) || !reader.readUInt32(&term.count)) return false;
+        term.postings = quint32(reader.position());
+        if (!reader.skip(qint64(term.count) * POSTING_BYTES)) return false;
+        m_terms.append(term);
+    }
+    return true;
+}
+
+QString HelpStore::page(const QString &key) const {
+    const auto it = m_pages.constFind(key);
+    if (it == m_pages.constEnd()) return QString();
+    return QString::fromUtf8(m_data.constData() + it->offset, int(it->length));
+}
+
+void HelpStore::collectPostings(int first, int last, QHash<int, int> *hits) const {
+    for (int i = first; i < last; ++i) {
+        const Term &term = m_terms[i];
+        const char *posting = m_data.constData() + term.postings;
+        for (quint32 j = 0; j < term.count; ++j, posting += POSTING_BYTES) {
+            const int page = qFromBigEndian<quint16>(posting);
+            (*hits)[page] += qFromBigEndian<quint16>(posting + 2);
+        }
+    }
+}
+
+QStringList HelpStore::search(const QString &query, bool *applied) const {
+    // Запрос разбирается так же, как текст страниц при сборке индекса
+    const QString folded = query.toLower();
+    QStringList words;
+    QString word;
+    for (const QChar ch : folded) {
+        if (isWordChar(ch)) {
+            word += ch;
+        } else if (!word.isEmpty()) {
+            words.append(word);
+            word.clear();
+        }
+    }
+    const bool lastIsPrefix = !word.isEmpty();
+    if (lastIsPrefix) {
+        words.append(word);
+    }
+
+    const auto lessWord = [](const Term &term, const QByteArray &word) { return term.word < word; };
+    if (applied) {
+        *applied = false;
+    }
+    QHash<int, int> scores;
+    bool first = true;
+    for (int w = 0; w < words.size(); ++w) {
+        const bool prefix = lastIsPrefix && w == words.size() - 1;
+        if (!prefix && words[w].size() < MIN_TERM_LENGTH) continue; // Таких слов нет в индексе
+        const QByteArray utf8 = words[w].toUtf8();
+        if (applied) {
+            *applied = true;
+        }
+
+        auto begin = std::lower_bound(m_terms.cbegin(), m_terms.cend(), utf8, lessWord);
+        auto end = begin;
+        if (prefix) {
+            while (end != m_terms.cend() && end->word.startsWith(utf8)) ++end;
+        } else if (end != m_terms.cend() && end->word == utf8) {
+            ++end;
+        }
+        QHash<int, int> hits;
+        collectPostings(int(begin - m_terms.cbegin()), int(end - m_terms.cbegin()), &hits);
+
+        // Страница должна содержать все слова запроса
+        if (first) {
+            scores = hits;
+            first = false;
+        } else {
+            for (auto it = scores.begin(); it != scores.end();) {
+                const auto found = hits.constFind(it.key());
+                if (found == hits.constEnd()) {
+                    it = scores.erase(it);
+                } else {
+                    it.value() += found.value();
+                    ++it;
+                }
+            }
+        }
+        if (scores.isEmpty()) break;
+    }
+
+    QVector<QPair<int, int>> ranked; // (вхождения, страница)
+    ranked.reserve(scores.size());
+    for (auto it = scores.constBegin(); it != scores.constEnd(); ++it) {
+        if (it.key() < m_keys.size()) {
+            ranked.append({ it.value(), it.key() });
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const QPair<int, int> &a, const QPair<int, int> &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    QStringList keys;
+    keys.reserve(ranked.size());
+    for (const auto &entry : ranked) {
+        keys.append(m_keys[entry.second]);
+    }
+    return keys;
+}
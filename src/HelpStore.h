@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Страницы справки из пакета, собранного при сборке (cmake/build_help_pack.py из help/*.html).
+// Пакет хранится в программе сжатым и распаковывается один раз при создании хранилища.
+// Таблица ключ -> смещение и обратный индекс слов построены заранее: страница находится
+// за O(1), а поиск - двоичным поиском по отсортированным словам без разбора текста страниц.
+class HelpStore {
+public:
+    HelpStore();
+
+    bool isValid() const { return !m_pages.isEmpty(); }
+    QString page(const QString &key) const; // Пустая строка - страницы нет
+    // Ключи страниц, содержащих все слова запроса, по убыванию числа вхождений.
+    // Последнее слово, если за ним нет разделителя, ищется как префикс (поиск по мере набора).
+    // applied = false - в запросе нет слов, которые могут быть в индексе (только короткие слова
+    // или знаки): это не "ничего не найдено", фильтровать по такому запросу не нужно
+    QStringList search(const QString &query, bool *applied = nullptr) const;
+
+private:
+    struct Page {
+        quint32 offset { 0 };
+        quint32 length { 0 };
+    };
+    struct Term {
+        QByteArray word;          // UTF-8 в нижнем регистре
+        quint32 postings { 0 };   // Смещение пар (страница, вхождения)
+        quint32 count { 0 };
+    };
+
+    bool parse();
+    void collectPostings(int first, int last, QHash<int, int> *hits) const;
+
+    QByteArray m_data;            // Распакованный пакет
+    QHash<QString, Page> m_pages;
+    QStringList m_keys;           // Ключи по номеру страницы в индексе
+    QVector<Term> m_terms;        // По возрастанию байтов UTF-8
+};
@@ -6,6 +6,12 @@
 #include <QSplitter>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
+#include <QHash>
+#include <QLineEdit>
+#include <QSet>
+
+#include "HelpStore.h"
+
 class HelpWidget : public QWidget {
     Q_OBJECT
 
@@ -15,19 +21,29 @@ public:
 
 private slots:
     void onItemClicked(QTreeWidgetItem *item, int column);
+    void onSearchTextChanged(const QString &text);
 
 private:
     void setupUi();
     void createTreeWidget();
     void addTreeItems();
     
+    bool applySearchFilter(QTreeWidgetItem *item, const QSet<QString> *found);
+    
     QString getHelpContent(const QString &key);
+    void rebuildStyles();
     QString wrapWithStyles(const QString &content);
     QString highlightPythonCode(const QString &code);
     
     QSplitter *m_splitter {nullptr};
     QTreeWidget *m_treeWidget {nullptr};
     QTextBrowser *m_contentBrowser {nullptr};
+    QLineEdit *m_searchEdit {nullptr};
+    HelpStore m_helpStore;
+    QHash<QString, QTreeWidgetItem *> m_itemsByKey;
     QString m_theme { "light" };
+    QHash<QString, QString> m_renderedPages; // "тема/ключ" -> оформленный HTML страницы
+    QString m_pageStyles;     // <style> страниц для текущей темы
+    QString m_codeBlockStart; // Начало оформления блока кода для текущей темы
 };
 
@@ -3,10 +3,24 @@
 #include "SettingsWidget.h"
 #include "HelpWidget.h"
 #include "CodeEditor.h"
+#include "EditorDocument.h"
+#include "FileLoader.h"
 #include "TitleBar.h"
 #include "WindowFrameOverlay.h"
 #include "AnimatedMenu.h"
 #include "ConsoleWidget.h"
+#include "OutputView.h"
+#include "ProcessOutputPump.h"
+#include "RunnerChannel.h"
+#include "PythonWorkerPool.h"
+#include "DebugPanel.h"
+#include "PythonEnvironment.h"
+#include "PyrobTaskIndex.h"
+#include "SymbolIndex.h"
+#include "CompletionTrie.h"
+#include "CompletionServer.h"
+#include "StartupTrace.h"
+#include "FilePickerService.h"
 #include "pyrobeditor/PyrobEditorWidget.h"
 // SnakeGame.h включаем для корректного вызова деструктора при удалении
 #include "sea/SnakeGame.h"
@@ -47,7 +61,6 @@
 #include <QKeyEvent>
 #include <QTextBrowser>
 #include <QLineEdit>
-#include <QUrlQuery>
 #include <QVBoxLayout>
 #include <QSet>
 #include <QPainterPath>
@@ -71,6 +84,9 @@
 #include <QColor>
 #include <QPalette>
 #include <QSvgRenderer>
+#include <QIconEngine>
+#include <QStyle>
+#include <QStyleOption>
 #include <QFile>
 #include <QBuffer>
 #include <QByteArray>
@@ -83,12 +99,41 @@
 #include "TitleBar.h"
 #include "WindowFrameOverlay.h"
 #include <QSizePolicy>
-#include <QCryptographicHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <algorithm>
 #include <QPixmapCache>
+#include <QDateTime>
 
 namespace {
 constexpr auto SETTINGS_GROUP = "runtime";
 constexpr auto SETTINGS_PYTHON_PATH = "pythonPath";
+constexpr int DEFAULT_LARGE_FILE_MB = 2; // Файлы от этого размера открываются в режиме большого файла
+constexpr int MAX_LIVE_EDITORS = 50; // Созданных редакторов; остальные вкладки хранят только путь
+constexpr int DEFAULT_UNLOAD_IDLE_MINUTES = 10; // Неизмененный редактор выгружается после такого простоя
+constexpr int UNLOAD_CHECK_INTERVAL_MS = 60 * 1000;
+constexpr int SESSION_SAVE_DELAY_MS = 2000;
+constexpr int STARTUP_FALLBACK_MS = 2000; // Если первая отрисовка так и не пришла (окно свернуто)
+constexpr int FAST_RUN_WORKERS = 1; // Прогретых интерпретаторов: отданный процесс сразу заменяется новым
+
+// Код обертки запуска (runtime/vuzhyk_runner.py), читается из ресурсов один раз
+const QString &runnerScript() {
+    static const QString script = [] {
+        QFile file(":/runtime/vuzhyk_runner.py");
+        return file.open(QIODevice::ReadOnly) ? QString::fromUtf8(file.readAll()) : QString();
+    }();
+    return script;
+}
+
+// Сервер анализа для автодополнения (runtime/vuzhyk_completion.py)
+const QString &completionServerScript() {
+    static const QString script = [] {
+        QFile file(":/runtime/vuzhyk_completion.py");
+        return file.open(QIODevice::ReadOnly) ? QString::fromUtf8(file.readAll()) : QString();
+    }();
+    return script;
+}
 
 // Вспомогательная функция для перекрашивания SVG
 QByteArray recolorSvg(const QString &resourcePath, const QString &newColor) {
@@ -110,8 +155,65 @@ QByteArray recolorSvg(const QString &resourcePath, const QString &newColor) {
     return svgString.toUtf8();
 }
 
-// Вспомогательная функция для создания иконки из SVG ресурса с перекрашиванием
-QIcon createIconFromResource(const QString &resourcePath, const QString &color = "#000000", int size = 24) {
+// Иконка из SVG, растеризуемая при первом запросе нужного размера: иконки скрытых
+// действий не рисуются вовсе, а у видимых - только отображаемый размер
+class SvgIconEngine : public QIconEngine {
+public:
+    explicit SvgIconEngine(const QByteArray &svgData)
+        : m_svgData(svgData) {
+    }
+
+    void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state) override {
+        painter->drawPixmap(rect, pixmap(rect.size(), mode, state));
+    }
+
+    QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state) override {
+        Q_UNUSED(state);
+        const QString key = QString("%1x%2:%3").arg(size.width()).arg(size.height()).arg(int(mode));
+        const auto cached = m_pixmaps.constFind(key);
+        if (cached != m_pixmaps.constEnd()) {
+            return cached.value();
+        }
+        if (!m_renderer) {
+            m_renderer.reset(new QSvgRenderer(m_svgData));
+        }
+        QPixmap result(size);
+        result.fill(Qt::transparent);
+        if (m_renderer->isValid()) {
+            QPainter painter(&result);
+            painter.setRenderHint(QPainter::Antialiasing);
+            m_renderer->render(&painter);
+        }
+        if (mode != QIcon::Normal) {
+            // Неактивные и выделенные состояния - как у обычных иконок Qt
+            QStyleOption option;
+            option.palette = QApplication::palette();
+            result = QApplication::style()->generatedIconPixmap(mode, result, &option);
+        }
+        m_pixmaps.insert(key, result);
+        return result;
+    }
+
+    QIconEngine *clone() const override {
+        return new SvgIconEngine(m_svgData);
+    }
+
+private:
+    QByteArray m_svgData;
+    std::unique_ptr<QSvgRenderer> m_renderer; // Разбирается при первой отрисовке
+    QHash<QString, QPixmap> m_pixmaps;
+};
+
+// Вспомогательная функция для создания иконки из SVG ресурса с перекрашиванием.
+// Иконки кэшируются: тема применяется и в setupActions, и в applyTheme
+QIcon createIconFromResource(const QString &resourcePath, const QString &color = "#000000") {
+    static QHash<QString, QIcon> icons;
+    const QString key = resourcePath + '|' + color;
+    const auto cached = icons.constFind(key);
+    if (cached != icons.constEnd()) {
+        return cached.value();
+    }
+    
     QIcon icon;
     QByteArray svgData;
     
@@ -127,25 +229,10 @@ QIcon createIconFromResource(const QString &resourcePath, const QString &color =
         }
     }
     
-    if (svgData.isEmpty()) {
-        return icon;
-    }
-    
-    // Создаем QSvgRenderer из перекрашенного SVG
-    QSvgRenderer renderer(svgData);
-    if (renderer.isValid()) {
-        // Создаем несколько размеров для лучшего качества
-        for (int s : {16, 24, 32}) {
-            QPixmap pixmap(s, s);
-            pixmap.fill(Qt::transparent);
-            QPainter painter(&pixmap);
-            painter.setRenderHint(QPainter::Antialiasing);
-            renderer.render(&painter);
-            painter.end();
-            icon.addPixmap(pixmap);
-        }
+    if (!svgData.isEmpty()) {
+        icon = QIcon(new SvgIconEngine(svgData));
     }
-    
+    icons.insert(key, icon);
     return icon;
 }
 }
@@ -164,13 +251,16 @@ MainWindow::MainWindow(const QString &theme, QWidget *parent)
     }
     
     setupUi();
+    StartupTrace::mark(QStringLiteral("ui"));
     setupActions();
     setupConnections();
     updateRoundedCorners();
     updateBorderStyle();
+    StartupTrace::mark(QStringLiteral("actions"));
     
     // Применяем тему после инициализации действий
     applyTheme(m_currentTheme);
+    StartupTrace::mark(QStringLiteral("theme"));
     
     // Восстанавливаем состояние окна (включая положение тулбара)
     restoreWindowState();
@@ -181,6 +271,27 @@ MainWindow::MainWindow(const QString &theme, QWidget *parent)
     m_completionUpdateTimer->setInterval(500); // Обновление через 500мс после последнего изменения
     connect(m_completionUpdateTimer, &QTimer::timeout, this, &MainWindow::updateCompletionFromDocument);
     
+    // Проверка синтаксиса - когда набор затих, чтобы не подчеркивать недописанную строку
+    m_syntaxCheckTimer = new QTimer(this);
+    m_syntaxCheckTimer->setSingleShot(true);
+    m_syntaxCheckTimer->setInterval(600);
+    connect(m_syntaxCheckTimer, &QTimer::timeout, this, &MainWindow::requestSyntaxCheck);
+    
+    // Редакторы давно не открывавшихся вкладок выгружаются (вкладка остается)
+    auto *unloadTimer = new QTimer(this);
+    unloadTimer->setInterval(UNLOAD_CHECK_INTERVAL_MS);
+    connect(unloadTimer, &QTimer::timeout, this, &MainWindow::evictIdleTabs);
+    unloadTimer->start();
+    
+    // Снимок сеанса пишется в фоне, не чаще раза в SESSION_SAVE_DELAY_MS
+    m_sessionStore = new SessionStore(this);
+    m_sessionSaveTimer = new QTimer(this);
+    m_sessionSaveTimer->setSingleShot(true);
+    m_sessionSaveTimer->setInterval(SESSION_SAVE_DELAY_MS);
+    connect(m_sessionSaveTimer, &QTimer::timeout, this, [this]() {
+        m_sessionStore->save(currentSession());
+    });
+    
     // Регистрируем глобальный хоткей Shift+F5 для завершения выполнения
 #ifdef _WIN32
     HWND hwnd = reinterpret_cast<HWND>(winId());
@@ -192,8 +303,20 @@ MainWindow::MainWindow(const QString &theme, QWidget *parent)
     }
 #endif
     
-    // Создаем локальный сервер для единого экземпляра приложения
-    setupLocalServer();
+    // Фоновая работа после показа окна: сведения об интерпретаторе для автодополнения
+    // и прогрев интерпретаторов быстрого запуска
+    QTimer::singleShot(0, this, [this]() {
+        requestBaseCompletions();
+        ensureCompletionServer();
+        
+        // Помощник выбора файлов запускается заранее - первый диалог открывается без задержки
+        if (!m_filePicker && FilePickerService::isAvailable()) {
+            m_filePicker = new FilePickerService(this);
+            m_filePicker->warmUp();
+        }
+        
+        ensureWorkerPool();
+    });
 }
 
 void MainWindow::setupUi() {
@@ -274,9 +397,8 @@ void MainWindow::setupUi() {
     outputLayout->setContentsMargins(0, 0, 0, 0);
     outputLayout->setSpacing(0);
     
-    m_output = new QTextBrowser();
-    m_output->setOpenLinks(false);
-    connect(m_output, &QTextBrowser::anchorClicked, this, &MainWindow::onOutputAnchorClicked);
+    m_output = new OutputView();
+    connect(m_output, &OutputView::linkActivated, this, &MainWindow::openFileAt);
     outputLayout->addWidget(m_output);
     
     // Поле ввода для команд input()
@@ -334,6 +456,13 @@ void MainWindow::setupActions() {
     auto *runMenu = new AnimatedMenu(tr("Запуск"), this);
     m_menuBar->addMenu(runMenu);
     m_actRun = runMenu->addAction(tr("Запустить скрипт"));
+    runMenu->addSeparator();
+    m_actStepOver = runMenu->addAction(tr("Шаг с обходом"));
+    m_actStepOver->setShortcut(QKeySequence(Qt::Key_F10));
+    m_actStepInto = runMenu->addAction(tr("Шаг с заходом"));
+    m_actStepInto->setShortcut(QKeySequence(Qt::Key_F11));
+    m_actStepOut = runMenu->addAction(tr("Шаг с выходом"));
+    m_actStepOut->setShortcut(QKeySequence(Qt::SHIFT + Qt::Key_F11));
 
     auto *toolsMenu = new AnimatedMenu(tr("Инструменты"), this);
     m_menuBar->addMenu(toolsMenu);
@@ -412,6 +541,9 @@ void MainWindow::setupActions() {
     connect(m_actTerminate, &QAction::triggered, this, &MainWindow::terminateRun);
     connect(m_actDebug, &QAction::triggered, this, &MainWindow::runScriptWithDebug);
     connect(m_actDebugNext, &QAction::triggered, this, &MainWindow::continueDebug);
+    connect(m_actStepOver, &QAction::triggered, this, &MainWindow::stepOverDebug);
+    connect(m_actStepInto, &QAction::triggered, this, &MainWindow::stepIntoDebug);
+    connect(m_actStepOut, &QAction::triggered, this, &MainWindow::stepOutDebug);
     connect(m_actRunInTerminal, &QAction::triggered, this, &MainWindow::runScriptInTerminal);
     connect(actChoosePy, &QAction::triggered, this, &MainWindow::choosePython);
     connect(actToggleRepl, &QAction::toggled, this, &MainWindow::toggleRepl);
@@ -856,11 +988,14 @@ int MainWindow::findTabByPath(const QString &path) const {
     QString canonicalPath = pathInfo.canonicalFilePath();
     for (int i = 0; i < m_tabWidget->count(); ++i) {
         CodeEditor *editor = getEditorFromTabWidget(i);
+        QString tabPath;
         if (editor && m_editorToPath.contains(editor)) {
-            QString tabPath = m_editorToPath[editor];
-            if (!tabPath.isEmpty() && QFileInfo(tabPath).canonicalFilePath() == canonicalPath) {
-                return i;
-            }
+            tabPath = m_editorToPath[editor];
+        } else {
+            tabPath = m_lazyTabs.value(m_tabWidget->widget(i)).path; // Редактор еще не создан
+        }
+        if (!tabPath.isEmpty() && QFileInfo(tabPath).canonicalFilePath() == canonicalPath) {
+            return i;
         }
     }
     return -1;
@@ -883,71 +1018,20 @@ void MainWindow::setupEditor(CodeEditor *editor) {
     editor->setTheme(m_currentTheme);
 
     // Автодополнение (Ctrl+Space)
-    // Загружаем базовые дополнения только если еще не загружены (кэшируем для всех файлов)
+    // Базовые дополнения общие для всех файлов. Пока интроспекция интерпретатора
+    // идет в фоне (см. requestBaseCompletions), используется статический список
     if (m_cachedBaseCompletions.isEmpty()) {
-        m_cachedBaseCompletions = loadPythonCompletions();
-        if (m_cachedBaseCompletions.isEmpty()) {
-            // Fallback на статический список, если не удалось загрузить из Python
-            m_cachedBaseCompletions = QStringList({
-            // Ключевые слова Python
-            "False","await","else","import","pass","None","break","except","in","raise",
-            "True","class","finally","is","return","and","continue","for","lambda","try",
-            "as","def","from","nonlocal","while","assert","del","global","not","with",
-            "async","elif","if","or","yield",
-            // Встроенные функции
-            "abs","delattr","hash","memoryview","set","all","dict","help","min","setattr",
-            "any","dir","hex","next","slice","ascii","divmod","id","object","sorted",
-            "bin","enumerate","input","oct","staticmethod","bool","eval","int","open","str",
-            "breakpoint","exec","isinstance","ord","sum","bytearray","filter","issubclass","pow","super",
-            "bytes","float","iter","print","tuple","callable","format","len","property","type",
-            "chr","frozenset","list","range","vars","classmethod","getattr","locals","repr","zip",
-            "compile","globals","map","reversed","__import__","complex","hasattr","max","round",
-            // Константы
-            "Ellipsis","NotImplemented","__debug__",
-            // Встроенные исключения
-            "BaseException","Exception","ArithmeticError","AssertionError","AttributeError",
-            "BlockingIOError","BrokenPipeError","BufferError","BytesWarning",
-            "ChildProcessError","ConnectionAbortError","ConnectionError",
-            "ConnectionRefusedError","ConnectionResetError","DeprecationWarning",
-            "EOFError","EnvironmentError","FileExistsError",
-            "FileNotFoundError","FloatingPointError","FutureWarning","GeneratorExit",
-            "IOError","ImportError","ImportWarning","IndentationError","IndexError",
-            "InterruptedError","IsADirectoryError","KeyError","KeyboardInterrupt",
-            "LookupError","MemoryError","ModuleNotFoundError","NameError",
-            "NotImplementedError","OSError","OverflowError","PendingDeprecationWarning",
-            "PermissionError","ProcessLookupError","RecursionError","ReferenceError",
-            "ResourceWarning","RuntimeError","RuntimeWarning","StopAsyncIteration",
-            "StopIteration","SyntaxError","SyntaxWarning","SystemError","SystemExit",
-            "TabError","TimeoutError","TypeError","UnboundLocalError",
-            "UnicodeDecodeError","UnicodeEncodeError","UnicodeError",
-            "UnicodeTranslateError","UnicodeWarning","UserWarning","ValueError",
-            "Warning","WindowsError","ZeroDivisionError",
-            // Модули стандартной библиотеки
-            "abc","atexit","argparse","array","asyncio","base64","bdb","binascii","bisect",
-            "builtins","bz2","calendar","collections","concurrent","configparser","contextlib",
-            "copy","csv","ctypes","datetime","decimal","difflib","dis","doctest","email","enum",
-            "errno","faulthandler","filecmp","fileinput","fnmatch","fractions","functools",
-            "gc","getopt","getpass","gettext","glob","gzip","hashlib","heapq","hmac","html","http",
-            "imaplib","imp","importlib","inspect","io","ipaddress","itertools","json","keyword",
-            "linecache","locale","logging","lzma","math","mimetypes","mmap","modulefinder",
-            "multiprocessing","netrc","numbers","operator","os","pathlib","pdb","pickle","pipes",
-            "pkgutil","platform","plistlib","poplib","posixpath","pprint","profile","pstats","pty",
-            "pyclbr","pydoc","queue","quopri","random","re","readline","reprlib","resource",
-            "rlcompleter","sched","secrets","select","selectors","shelve","shlex","shutil",
-            "signal","site","smtpd","smtplib","socket","socketserver","sqlite3","ssl","stat",
-            "statistics","string","stringprep","struct","subprocess","symtable","sys","sysconfig",
-            "tabnanny","tarfile","tempfile","termios","textwrap","threading","time","timeit",
-            "tkinter","token","tokenize","traceback","tracemalloc","types","typing","unicodedata",
-            "unittest","urllib","uuid","venv","warnings","wave","weakref","webbrowser","xml",
-            "xmlrpc","zipapp","zipfile","zipimport","zlib"
-            });
-        }
+        m_cachedBaseCompletions = CompletionTrie::fallbackWords();
     }
     
     // Создаем QSet для быстрой проверки префиксов (один раз)
     if (m_cachedBaseCompletionsSet.isEmpty() && !m_cachedBaseCompletions.isEmpty()) {
         m_cachedBaseCompletionsSet = QSet<QString>::fromList(m_cachedBaseCompletions);
     }
+    if (!m_baseCompletionTrie) {
+        m_baseCompletionTrie = CompletionTrie::fallback();
+    }
+    editor->setCompletionBase(m_baseCompletionTrie);
     
     // Создаем общую модель для базовых дополнений, если еще не создана
     if (!m_sharedBaseCompletionsModel) {
@@ -960,7 +1044,7 @@ void MainWindow::setupEditor(CodeEditor *editor) {
     
     // Инициализируем кэш слов из файла для этого редактора
     m_fileCompletionsCache[editor] = QStringList();
-    m_fileContentHash[editor] = QString();
+    m_fileSymbolsRevision.remove(editor);
     
     // Обновляем шрифт popup при изменении размера шрифта редактора
     connect(editor, &CodeEditor::fontSizeChanged, this, [editor]() {
@@ -977,11 +1061,20 @@ void MainWindow::setupEditor(CodeEditor *editor) {
     // (сохраняем его в модели completer)
 
     // Обновление списка автодополнения по документу с debounce для оптимизации
-    connect(editor->document(), &QTextDocument::contentsChanged, this, [this]() {
+    connect(editor->document(), &EditorDocument::contentsChanged, this, [this]() {
         if (m_completionUpdateTimer) {
             m_completionUpdateTimer->stop();
             m_completionUpdateTimer->start();
         }
+        if (m_syntaxCheckTimer && m_liveSyntaxCheckEnabled) {
+            m_syntaxCheckTimer->start();
+        }
+    });
+    
+    // Дополнения с учетом области видимости и атрибутов - от фонового сервера анализа;
+    // до его ответа работают словарные дополнения
+    connect(editor, &CodeEditor::semanticCompletionRequested, this, [this, editor]() {
+        requestSemanticCompletion(editor);
     });
     
     // Обновление автокомплита при изменении позиции курсора (для проверки @task)
@@ -996,14 +1089,16 @@ void MainWindow::setupEditor(CodeEditor *editor) {
                 m_completionUpdateTimer->stop();
                 m_completionUpdateTimer->start(100); // 100ms задержка
             }
+            scheduleSessionSave();
         }
     });
+    connect(editor, &CodeEditor::breakpointToggled, this, &MainWindow::scheduleSessionSave);
     
     // Изменение размера шрифта колесиком мыши (Ctrl+колесико)
     connect(editor, &CodeEditor::fontSizeChanged, this, &MainWindow::applyFontSizeToAllEditors);
     
     // Обновляем заголовок окна при изменении документа
-    connect(editor->document(), &QTextDocument::modificationChanged, this, [this, editor]() {
+    connect(editor->document(), &EditorDocument::modificationChanged, this, [this, editor]() {
         updateWindowTitle();
         updateTabText(editor);
     });
@@ -1067,20 +1162,12 @@ void MainWindow::updateWindowTitle() {
 void MainWindow::newFile() {
     CodeEditor *editor = currentEditor();
     if (editor && editor->document()->isModified()) {
-        if (!maybeSave())
+        if (!maybeSave([this]() { newFile(); }))
             return;
     }
     
-    // Ограничиваем количество открытых вкладок для экономии памяти
-    const int MAX_TABS = 50;
-    int codeEditorCount = 0;
-    for (int i = 0; i < m_tabWidget->count(); ++i) {
-        CodeEditor *editor = getEditorFromTabWidget(i);
-        if (editor) codeEditorCount++;
-    }
-    if (codeEditorCount >= MAX_TABS) {
-        QMessageBox::warning(this, tr("Превышен лимит"), 
-            tr("Достигнут максимум %1 открытых вкладок редактора. Закройте некоторые вкладки перед открытием новых.").arg(MAX_TABS));
+    // Число вкладок не ограничено, но созданных редакторов - не больше MAX_LIVE_EDITORS
+    if (!ensureEditorCapacity(nullptr)) {
         return;
     }
     
@@ -1126,20 +1213,12 @@ void MainWindow::newFile() {
 void MainWindow::newPyrobSolution() {
     CodeEditor *editor = currentEditor();
     if (editor && editor->document()->isModified()) {
-        if (!maybeSave())
+        if (!maybeSave([this]() { newPyrobSolution(); }))
             return;
     }
     
-    // Ограничиваем количество открытых вкладок для экономии памяти
-    const int MAX_TABS = 50;
-    int codeEditorCount = 0;
-    for (int i = 0; i < m_tabWidget->count(); ++i) {
-        CodeEditor *editor = getEditorFromTabWidget(i);
-        if (editor) codeEditorCount++;
-    }
-    if (codeEditorCount >= MAX_TABS) {
-        QMessageBox::warning(this, tr("Превышен лимит"), 
-            tr("Достигнут максимум %1 открытых вкладок редактора. Закройте некоторые вкладки перед открытием новых.").arg(MAX_TABS));
+    // Число вкладок не ограничено, но созданных редакторов - не больше MAX_LIVE_EDITORS
+    if (!ensureEditorCapacity(nullptr)) {
         return;
     }
     
@@ -1198,128 +1277,29 @@ QString MainWindow::pythonPath() const {
     return path;
 }
 
-QString MainWindow::showFilePicker(const QString &filter, const QString &initialDir, bool isSave, bool isDirectory) {
-    QString pickerExe = QCoreApplication::applicationDirPath() + "/FilePicker.exe";
-    
-    if (!QFile::exists(pickerExe)) {
-        // Fallback на обычный диалог, если FilePicker.exe не найден
-        QFileDialog dialog(this, isSave ? tr("Сохранить файл") : (isDirectory ? tr("Открыть папку") : tr("Открыть файл")), 
-                          initialDir, filter);
-        dialog.setFileMode(isDirectory ? QFileDialog::Directory : (isSave ? QFileDialog::AnyFile : QFileDialog::ExistingFile));
-        dialog.setAcceptMode(isSave ? QFileDialog::AcceptSave : QFileDialog::AcceptOpen);
-        dialog.setOption(QFileDialog::DontUseNativeDialog, true);
-        if (dialog.exec() == QDialog::Accepted) {
-            return dialog.selectedFiles().first();
-        }
-        return QString();
-    }
-    
-    QProcess process;
-    QStringList args;
-    
-    // Извлекаем расширение из фильтра
-    QString extension;
-    if (!filter.isEmpty()) {
-        QString firstFilter;
-        if (filter.contains(";;")) {
-            // Берем первый фильтр из списка
-            firstFilter = filter.split(";;").first();
-        } else {
-            firstFilter = filter;
-        }
-        
-        // Извлекаем паттерн: "Python файлы (*.py)" -> ".py"
-        // Ищем последнюю открывающую скобку и соответствующую закрывающую
-        int openBrace = firstFilter.lastIndexOf('(');
-        int closeBrace = firstFilter.lastIndexOf(')');
-        
-        if (openBrace >= 0 && closeBrace > openBrace) {
-            QString pattern = firstFilter.mid(openBrace + 1, closeBrace - openBrace - 1).trimmed();
-            
-            // Если паттерн содержит несколько расширений, берем первое
-            // "*.py *.pyw" -> "*.py"
-            if (pattern.contains(" ")) {
-                QStringList parts = pattern.split(" ", QString::SkipEmptyParts);
-                if (!parts.isEmpty()) {
-                    pattern = parts.first();
-                }
-            }
-            
-            // Убираем возможные пробелы и звездочку
-            pattern = pattern.trimmed();
-            if (pattern.startsWith("*")) {
-                pattern = pattern.mid(1);
-            }
-            
-            extension = pattern;
-        } else {
-            // Если формат не распознан, пробуем найти паттерн в скобках другим способом
-            if (firstFilter.contains("(") && firstFilter.contains(")")) {
-                int start = firstFilter.indexOf("(");
-                int end = firstFilter.indexOf(")");
-                if (start < end) {
-                    QString pattern = firstFilter.mid(start + 1, end - start - 1).trimmed();
-                    if (pattern.contains(" ")) {
-                        pattern = pattern.split(" ").first();
-                    }
-                    if (pattern.startsWith("*")) {
-                        pattern = pattern.mid(1);
-                    }
-                    extension = pattern;
-                }
-            }
-        }
-    }
-    
-    // Если расширение не найдено, используем дефолтное .py
-    if (extension.isEmpty()) {
-        extension = ".py";
-    }
-    
-    // Передаем расширение как обязательный параметр
-    args << "-e" << extension;
-    if (!initialDir.isEmpty()) {
-        // Нормализуем путь: делаем абсолютным и заменяем слеши на обратные для Windows
-        QDir dir(initialDir);
-        QString normalizedDir = dir.absolutePath();
-        normalizedDir.replace('/', '\\');
-        args << "-d" << normalizedDir;
-    }
-    if (isSave) {
-        args << "-s";
-    }
-    if (isDirectory) {
-        args << "--dir";
-    }
-    
-    process.start(pickerExe, args);
-    if (!process.waitForStarted(5000)) {
-        // Если процесс не запустился, возвращаем пустую строку
-        return QString();
-    }
-    
-    // Неблокирующее ожидание с обработкой событий UI
-    QElapsedTimer timer;
-    timer.start();
-    const int timeoutMs = 30000; // Таймаут 30 секунд
-    
-    // Обрабатываем события, пока процесс не завершится или не истечет таймаут
-    while (process.state() == QProcess::Running && timer.elapsed() < timeoutMs) {
-        QApplication::processEvents(QEventLoop::AllEvents, 100);
-        QThread::msleep(10); // Небольшая задержка, чтобы не нагружать CPU
+void MainWindow::pickFile(const QString &filter, const QString &initialDir, bool isSave, bool isDirectory,
+                          std::function<void(const QString &)> onPicked) {
+    if (!FilePickerService::isAvailable()) {
+        onPicked(showFallbackFileDialog(filter, initialDir, isSave, isDirectory));
+        return;
     }
-    
-    if (process.state() == QProcess::Running) {
-        // Таймаут истек
-        process.kill();
-        process.waitForFinished(1000);
-        return QString();
+    if (!m_filePicker) {
+        m_filePicker = new FilePickerService(this);
     }
-    
-    QByteArray output = process.readAllStandardOutput();
-    QString path = QString::fromUtf8(output).trimmed();
-    
-    return path;
+    m_filePicker->pick(filter, initialDir, isSave, isDirectory, std::move(onPicked));
+}
+
+QString MainWindow::showFallbackFileDialog(const QString &filter, const QString &initialDir, bool isSave, bool isDirectory) {
+    // Обычный диалог, если FilePicker.exe не найден
+    QFileDialog dialog(this, isSave ? tr("Сохранить файл") : (isDirectory ? tr("Открыть папку") : tr("Открыть файл")), 
+                      initialDir, filter);
+    dialog.setFileMode(isDirectory ? QFileDialog::Directory : (isSave ? QFileDialog::AnyFile : QFileDialog::ExistingFile));
+    dialog.setAcceptMode(isSave ? QFileDialog::AcceptSave : QFileDialog::AcceptOpen);
+    dialog.setOption(QFileDialog::DontUseNativeDialog, true);
+    if (dialog.exec() == QDialog::Accepted) {
+        return dialog.selectedFiles().first();
+    }
+    return QString();
 }
 
 QString MainWindow::saveUnsavedToTemp(CodeEditor *editor) {
@@ -1372,28 +1352,28 @@ void MainWindow::openFile() {
             }
         } else if (editor->document()->isModified()) {
             // Для непустых или сохраненных файлов показываем диалог только если файл изменен
-            if (!maybeSave())
+            if (!maybeSave([this]() { openFile(); }))
                 return;
         }
     }
     
-    QString selectedPath = showFilePicker(
+    pickFile(
         "Python файлы (*.py)", // Фильтр для извлечения расширения
         QString(), // Директория не передается из редактора кода
         false,
-        false
-    );
-    
-    if (selectedPath.isEmpty()) return;
-    
-    // Проверяем, не открыт ли файл уже в другой вкладке
-    int existingTab = findTabByPath(selectedPath);
-    if (existingTab >= 0) {
-        m_tabWidget->setCurrentIndex(existingTab);
-        return;
-    }
-    
-    loadFromPath(selectedPath);
+        false,
+        [this](const QString &selectedPath) {
+            if (selectedPath.isEmpty()) return;
+            
+            // Проверяем, не открыт ли файл уже в другой вкладке
+            int existingTab = findTabByPath(selectedPath);
+            if (existingTab >= 0) {
+                m_tabWidget->setCurrentIndex(existingTab);
+                return;
+            }
+            
+            loadFromPath(selectedPath);
+        });
 }
 
 void MainWindow::saveFile() {
@@ -1409,22 +1389,29 @@ void MainWindow::saveFile() {
 }
 
 void MainWindow::saveFileAs() {
-    CodeEditor *editor = currentEditor();
+    saveEditorAs(currentEditor());
+}
+
+void MainWindow::saveEditorAs(CodeEditor *editor, std::function<void()> onSaved) {
     if (!editor) return;
     
-    QString currentPath = m_editorToPath.value(editor, QString());
-    QString selectedPath = showFilePicker(
+    // Окно не ждет диалога: пока он открыт, вкладку могут закрыть или переключить
+    QPointer<CodeEditor> editorPtr = editor;
+    pickFile(
         "Python файлы (*.py)", // Фильтр для извлечения расширения
         QString(), // Директория не передается из редактора кода
         true,
-        false
-    );
-    
-    if (selectedPath.isEmpty()) return;
-    // Гарантируем расширение .py по умолчанию
-    if (!selectedPath.endsWith(".py", Qt::CaseInsensitive))
-        selectedPath += ".py";
-    saveToPath(selectedPath);
+        false,
+        [this, editorPtr, onSaved](const QString &path) {
+            if (path.isEmpty() || !editorPtr) return;
+            // Гарантируем расширение .py по умолчанию
+            QString selectedPath = path;
+            if (!selectedPath.endsWith(".py", Qt::CaseInsensitive))
+                selectedPath += ".py";
+            if (saveToPath(selectedPath, editorPtr) && onSaved) {
+                onSaved();
+            }
+        });
 }
 
 void MainWindow::saveAll() {
@@ -1520,8 +1507,8 @@ void MainWindow::runScript() {
     }
 
     m_runningFilePath = filePath;
-    m_stderrBuffer.clear();
-    m_stdoutBuffer.clear();
+    m_exceptionReported = false;
+    m_consoleTraceback.reset();
 
     QFileInfo fi(filePath);
     
@@ -1535,11 +1522,8 @@ void MainWindow::runScript() {
             m_console->setPythonPath(python);
             // Подключаем сигналы
             connect(m_console, &ConsoleWidget::outputReceived, this, [this](const QString &text, bool isError) {
-                if (isError) {
-                    m_stderrBuffer += text;
-                } else {
-                    m_stdoutBuffer += text;
-                }
+                Q_UNUSED(isError);
+                m_consoleTraceback.feed(text);
             });
             connect(m_console, &ConsoleWidget::commandFinished, this, [this](int exitCode) {
                 onProcessFinished(exitCode, QProcess::NormalExit);
@@ -1568,61 +1552,72 @@ void MainWindow::runScript() {
         m_console->ensureStarted(); // Убеждаемся, что консоль запущена
         m_console->writeCommand(command);
     } else {
-        // Вывод виден - запускаем через QProcess и выводим в QTextBrowser
+        // Вывод виден - запускаем через QProcess и выводим в OutputView
         m_scriptRunningInConsole = false;
         
         if (m_output) {
             m_output->clear();
         }
         
-        m_process = new QProcess(this);
+        // В режиме быстрого запуска берем заранее запущенный интерпретатор;
+        // если готового нет (или он упал), запускаем свежий процесс как обычно.
+        // Пул настраивается при запуске и при изменении настроек, а не при каждом запуске скрипта
+        QProcess *worker = m_workerPool ? m_workerPool->takeWorker(this) : nullptr;
+        m_runUsesWarmWorker = (worker != nullptr);
+        
+        m_process = worker ? worker : new QProcess(this);
         connect(m_process, &QProcess::started, this, &MainWindow::onProcessStarted);
-        connect(m_process, &QProcess::readyReadStandardOutput, this, &MainWindow::onProcessStdout);
-        connect(m_process, &QProcess::readyReadStandardError, this, &MainWindow::onProcessStderr);
+        m_outputPump = new ProcessOutputPump(m_process, m_process);
+        connect(m_outputPump, &ProcessOutputPump::textReady, this, &MainWindow::onProcessOutput);
+        connect(m_outputPump, &ProcessOutputPump::statsUpdated, this, &MainWindow::onOutputStatsUpdated);
+        connect(m_outputPump, &ProcessOutputPump::firstOutput, this, &MainWindow::onFirstOutput);
         connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
                 this, &MainWindow::onProcessFinished);
 
-        m_process->setProgram(python);
-        
-        // Обертываем скрипт в код, который выводит полный traceback для всех ошибок
-        QString escapedPath = filePath;
-        escapedPath.replace('\\', "\\\\");
-        escapedPath.replace('\'', "\\'");
-        
-        QString wrapperScript = QString(
-            "import sys\n"
-            "import traceback\n"
-            "import runpy\n"
-            "\n"
-            "# Устанавливаем excepthook для вывода полного traceback\n"
-            "def excepthook(exc_type, exc_value, exc_traceback):\n"
-            "    if exc_type != SystemExit:\n"
-            "        traceback.print_exception(exc_type, exc_value, exc_traceback, file=sys.stderr)\n"
-            "    sys.__excepthook__(exc_type, exc_value, exc_traceback)\n"
-            "\n"
-            "sys.excepthook = excepthook\n"
-            "\n"
-            "try:\n"
-            "    runpy.run_path(r'%1', run_name='__main__')\n"
-            "except SystemExit:\n"
-            "    raise\n"
-            "except Exception as e:\n"
-            "    # Выводим полный traceback для всех исключений\n"
-            "    traceback.print_exc()\n"
-            "    sys.exit(1)\n"
-        ).arg(escapedPath);
-        
-        m_process->setArguments(QStringList() << "-c" << wrapperScript);
-        m_process->setWorkingDirectory(fi.absolutePath());
-        m_process->setProcessChannelMode(QProcess::SeparateChannels);
+        // Обертка выводит полный traceback и сразу сообщает об исключении по служебному каналу
+        m_runnerChannel = new RunnerChannel(m_process);
+        connect(m_runnerChannel, &RunnerChannel::messageReceived, this, &MainWindow::onRunnerMessage);
+        const QString channelName = m_runnerChannel->listen() ? m_runnerChannel->fullServerName() : QString();
         
         // Показываем поле ввода когда процесс запущен
         if (m_outputInput && !m_outputModeIsConsole) {
             m_outputInput->setVisible(true);
         }
         
-        m_process->start();
+        if (worker) {
+            // Прогретый процесс ждет задание первой строкой stdin
+            QJsonObject job;
+            job.insert("script", filePath);
+            job.insert("cwd", fi.absolutePath());
+            job.insert("channel", channelName);
+            m_process->write(QJsonDocument(job).toJson(QJsonDocument::Compact) + '\n');
+            onProcessStarted();
+        } else {
+            m_process->setProgram(python);
+            m_process->setArguments(QStringList() << "-c" << runnerScript() << filePath << channelName);
+            m_process->setWorkingDirectory(fi.absolutePath());
+            m_process->setProcessChannelMode(QProcess::SeparateChannels);
+            m_process->start();
+        }
+    }
+}
+
+void MainWindow::ensureWorkerPool() {
+    QSettings settings;
+    if (!settings.value(QString("%1/fastRun").arg(SETTINGS_GROUP), false).toBool()) {
+        // Быстрый запуск выключен: пул не создается, а созданный завершает свои процессы
+        if (m_workerPool) {
+            m_workerPool->setEnabled(false);
+        }
+        return;
+    }
+    if (!m_workerPool) {
+        m_workerPool = new PythonWorkerPool(this);
+        m_workerPool->setScript(runnerScript());
+        m_workerPool->setPoolSize(FAST_RUN_WORKERS);
     }
+    m_workerPool->setPythonPath(detectPythonExecutable());
+    m_workerPool->setEnabled(true);
 }
 
 void MainWindow::runScriptInTerminal() {
@@ -1775,6 +1770,10 @@ void MainWindow::terminateRun() {
     // Сбрасываем флаг отладки
     m_isDebugging = false;
     m_currentBreakpointLine = -1;
+    clearDebugLine();
+    if (m_debugPanel) {
+        m_debugPanel->clear();
+    }
     
     // Отменяем регистрацию глобального хоткея F9
 #ifdef _WIN32
@@ -1845,8 +1844,8 @@ void MainWindow::runScriptWithDebug() {
     }
     
     m_runningFilePath = filePath;
-    m_stderrBuffer.clear();
-    m_stdoutBuffer.clear();
+    m_exceptionReported = false;
+    m_consoleTraceback.reset();
     m_isDebugging = true;
     m_currentBreakpointLine = -1;
     
@@ -1864,183 +1863,41 @@ void MainWindow::runScriptWithDebug() {
     
     m_process = new QProcess(this);
     connect(m_process, &QProcess::started, this, &MainWindow::onProcessStarted);
-    connect(m_process, &QProcess::readyReadStandardOutput, this, &MainWindow::onProcessStdout);
-    connect(m_process, &QProcess::readyReadStandardError, this, &MainWindow::onProcessStderr);
+    m_outputPump = new ProcessOutputPump(m_process, m_process);
+    connect(m_outputPump, &ProcessOutputPump::textReady, this, &MainWindow::onProcessOutput);
+    connect(m_outputPump, &ProcessOutputPump::statsUpdated, this, &MainWindow::onOutputStatsUpdated);
     connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
             this, &MainWindow::onProcessFinished);
     
-    m_process->setProgram(python);
-    
-    // Создаем временный файл для синхронизации
-    QString syncFile = QDir::temp().absoluteFilePath("vuzhyk_debug_sync_" + QString::number(QCoreApplication::applicationPid()) + ".txt");
-    QFile::remove(syncFile); // Удаляем старый файл, если есть
-    
-    // Формируем отладочный скрипт
-    QString escapedPath = filePath;
-    escapedPath.replace('\\', "\\\\");
-    escapedPath.replace('\'', "\\'");
-    
-    QString escapedSyncFile = syncFile;
-    escapedSyncFile.replace('\\', "\\\\");
-    escapedSyncFile.replace('\'', "\\'");
-    
-    // Формируем список точек останова для Python
-    QStringList breakpointLines;
-    for (int line : m_debugBreakpoints) {
-        breakpointLines << QString::number(line + 1); // Python использует 1-based индексацию
-    }
-    QString breakpointsStr = "{" + breakpointLines.join(", ") + "}";
-    
-    QString debugScript = QString(
-        "import sys\n"
-        "import traceback\n"
-        "import runpy\n"
-        "import os\n"
-        "import time\n"
-        "\n"
-        "# Отключаем буферизацию для немедленного вывода\n"
-        "sys.stdout.reconfigure(line_buffering=True)\n"
-        "sys.stderr.reconfigure(line_buffering=True)\n"
-        "\n"
-        "# Точки останова\n"
-        "breakpoints = %1\n"
-        "sync_file = r'%2'\n"
-        "current_file = r'%3'\n"
-        "\n"
-        "# Функция trace для остановки на точках останова\n"
-        "def trace_debug(frame, event, arg):\n"
-        "    if event == 'line':\n"
-        "        filename = frame.f_code.co_filename\n"
-        "        lineno = frame.f_lineno\n"
-        "        # Нормализуем пути для сравнения (абсолютные пути, одинаковые разделители)\n"
-        "        # os уже импортирован в начале скрипта\n"
-        "        normalized_filename = os.path.normpath(os.path.abspath(filename))\n"
-        "        normalized_current_file = os.path.normpath(os.path.abspath(current_file))\n"
-        "        # Проверяем, совпадает ли файл и номер строки с точкой останова\n"
-        "        if normalized_filename == normalized_current_file and lineno in breakpoints:\n"
-        "            # Принудительно выводим буфер перед остановкой\n"
-        "            sys.stdout.flush()\n"
-        "            sys.stderr.flush()\n"
-        "            # Записываем информацию о точке останова в файл\n"
-        "            with open(sync_file, 'w') as f:\n"
-        "                f.write(f'BREAKPOINT:{lineno}\\n')\n"
-        "            # Ждем, пока файл не будет удален (сигнал продолжения)\n"
-        "            # Используем неблокирующий механизм для GUI приложений\n"
-        "            import threading\n"
-        "            import queue\n"
-        "            \n"
-        "            # Пытаемся обработать события GUI, если это GUI приложение\n"
-        "            try:\n"
-        "                # Для tkinter\n"
-        "                import tkinter as tk\n"
-        "                root = tk._default_root\n"
-        "                if root:\n"
-        "                    while os.path.exists(sync_file):\n"
-        "                        root.update_idletasks()\n"
-        "                        time.sleep(0.01)\n"
-        "                    # После продолжения добавляем перенос строки для корректного форматирования вывода\n"
-        "                    sys.stdout.write('\\n')\n"
-        "                    sys.stdout.flush()\n"
-        "                    return trace_debug\n"
-        "            except:\n"
-        "                pass\n"
-        "            \n"
-        "            try:\n"
-        "                # Для PyQt/PySide\n"
-        "                from PyQt5.QtWidgets import QApplication\n"
-        "                app = QApplication.instance()\n"
-        "                if app:\n"
-        "                    while os.path.exists(sync_file):\n"
-        "                        app.processEvents()\n"
-        "                        time.sleep(0.01)\n"
-        "            except:\n"
-        "                pass\n"
-        "            \n"
-        "            try:\n"
-        "                # Для PySide2\n"
-        "                from PySide2.QtWidgets import QApplication\n"
-        "                app = QApplication.instance()\n"
-        "                if app:\n"
-        "                    while os.path.exists(sync_file):\n"
-        "                        app.processEvents()\n"
-        "                        time.sleep(0.01)\n"
-        "                    # После продолжения добавляем перенос строки для корректного форматирования вывода\n"
-        "                    sys.stdout.write('\\n')\n"
-        "                    sys.stdout.flush()\n"
-        "                    return trace_debug\n"
-        "            except:\n"
-        "                pass\n"
-        "            \n"
-        "            try:\n"
-        "                # Для PySide6\n"
-        "                from PySide6.QtWidgets import QApplication\n"
-        "                app = QApplication.instance()\n"
-        "                if app:\n"
-        "                    while os.path.exists(sync_file):\n"
-        "                        app.processEvents()\n"
-        "                        time.sleep(0.01)\n"
-        "                    # После продолжения добавляем перенос строки для корректного форматирования вывода\n"
-        "                    sys.stdout.write('\\n')\n"
-        "                    sys.stdout.flush()\n"
-        "                    return trace_debug\n"
-        "            except:\n"
-        "                pass\n"
-        "            \n"
-        "            try:\n"
-        "                # Для PyQt6\n"
-        "                from PyQt6.QtWidgets import QApplication\n"
-        "                app = QApplication.instance()\n"
-        "                if app:\n"
-        "                    while os.path.exists(sync_file):\n"
-        "                        app.processEvents()\n"
-        "                        time.sleep(0.01)\n"
-        "                    # После продолжения добавляем перенос строки для корректного форматирования вывода\n"
-        "                    sys.stdout.write('\\n')\n"
-        "                    sys.stdout.flush()\n"
-        "                    return trace_debug\n"
-        "            except:\n"
-        "                pass\n"
-        "            \n"
-        "            # Если это не GUI приложение, используем обычное ожидание\n"
-        "            # Но все равно периодически выводим буфер\n"
-        "            while os.path.exists(sync_file):\n"
-        "                sys.stdout.flush()\n"
-        "                sys.stderr.flush()\n"
-        "                time.sleep(0.1)\n"
-        "            \n"
-        "            # После продолжения (когда файл удален) всегда добавляем перенос строки\n"
-        "            # Это гарантирует, что вывод начнется с новой строки после каждого брейкпоинта\n"
-        "            sys.stdout.write('\\n')\n"
-        "            sys.stdout.flush()\n"
-        "    return trace_debug\n"
-        "\n"
-        "# Устанавливаем excepthook для вывода полного traceback\n"
-        "def excepthook(exc_type, exc_value, exc_traceback):\n"
-        "    if exc_type != SystemExit:\n"
-        "        traceback.print_exception(exc_type, exc_value, exc_traceback, file=sys.stderr)\n"
-        "    sys.__excepthook__(exc_type, exc_value, exc_traceback)\n"
-        "\n"
-        "sys.excepthook = excepthook\n"
-        "sys.settrace(trace_debug)\n"
-        "\n"
-        "try:\n"
-        "    runpy.run_path(current_file, run_name='__main__')\n"
-        "except SystemExit:\n"
-        "    raise\n"
-        "except Exception as e:\n"
-        "    traceback.print_exc()\n"
-        "    sys.exit(1)\n"
-        "finally:\n"
-        "    # Принудительно выводим оставшийся буфер\n"
-        "    sys.stdout.flush()\n"
-        "    sys.stderr.flush()\n"
-        "    # Удаляем файл синхронизации при завершении\n"
-        "    if os.path.exists(sync_file):\n"
-        "        os.remove(sync_file)\n"
-    ).arg(breakpointsStr, escapedSyncFile, escapedPath);
+    // Отладчик работает по служебному каналу обертки: скрипт блокируется на чтении
+    // команды, а IDE получает событие останова сразу, без опроса файлов
+    m_runnerChannel = new RunnerChannel(m_process);
+    connect(m_runnerChannel, &RunnerChannel::messageReceived, this, &MainWindow::onRunnerMessage);
+    connect(m_runnerChannel, &RunnerChannel::connected, this, [this]() {
+        // Обертка ждет точки останова и команду continue до запуска скрипта
+        QJsonArray lines;
+        for (int line : qAsConst(m_debugBreakpoints)) {
+            lines.append(line + 1); // Python использует 1-based индексацию
+        }
+        QJsonObject breakpoints;
+        breakpoints.insert("command", "breakpoints");
+        breakpoints.insert("lines", lines);
+        m_runnerChannel->send(breakpoints);
+        sendDebugCommand("continue");
+    });
+    if (!m_runnerChannel->listen()) {
+        m_isDebugging = false;
+        m_runningFilePath.clear();
+        m_process->deleteLater();
+        m_process = nullptr;
+        QMessageBox::critical(this, tr("Отладка"), tr("Не удалось создать канал отладки."));
+        return;
+    }
     
+    m_process->setProgram(python);
     // Используем флаг -u для отключения буферизации вывода
-    m_process->setArguments(QStringList() << "-u" << "-c" << debugScript);
+    m_process->setArguments(QStringList() << "-u" << "-c" << runnerScript()
+                                          << "--debug" << filePath << m_runnerChannel->fullServerName());
     m_process->setWorkingDirectory(fi.absolutePath());
     m_process->setProcessChannelMode(QProcess::SeparateChannels);
     
@@ -2049,16 +1906,6 @@ void MainWindow::runScriptWithDebug() {
     env.insert("PYTHONUNBUFFERED", "1");
     m_process->setProcessEnvironment(env);
     
-    // Сохраняем путь к файлу синхронизации для continueDebug
-    m_debugSyncFile = syncFile;
-    
-    // Запускаем таймер для проверки файла синхронизации
-    if (!m_debugTimer) {
-        m_debugTimer = new QTimer(this);
-        connect(m_debugTimer, &QTimer::timeout, this, &MainWindow::checkDebugSyncFile);
-    }
-    m_debugTimer->start(100); // Проверяем каждые 100 мс
-    
     // Регистрируем глобальный хоткей F9
 #ifdef _WIN32
     HWND hwnd = reinterpret_cast<HWND>(winId());
@@ -2080,16 +1927,86 @@ void MainWindow::runScriptWithDebug() {
 }
 
 void MainWindow::continueDebug() {
-    if (!m_isDebugging || m_debugSyncFile.isEmpty()) {
+    if (!m_isDebugging || m_currentBreakpointLine < 0) {
         return;
     }
     
-    // Удаляем файл синхронизации, чтобы продолжить выполнение
-    if (QFile::exists(m_debugSyncFile)) {
-        QFile::remove(m_debugSyncFile);
+    resumeDebug("continue");
+    statusBar()->showMessage(tr("Продолжение выполнения..."));
+}
+
+void MainWindow::stepOverDebug() {
+    resumeDebug("step", "over");
+}
+
+void MainWindow::stepIntoDebug() {
+    resumeDebug("step", "into");
+}
+
+void MainWindow::stepOutDebug() {
+    resumeDebug("step", "out");
+}
+
+void MainWindow::resumeDebug(const QString &command, const QString &stepMode) {
+    if (!m_isDebugging || m_currentBreakpointLine < 0) {
+        return;
     }
     
-    statusBar()->showMessage(tr("Продолжение выполнения..."));
+    m_currentBreakpointLine = -1;
+    clearDebugLine();
+    // Номера объектов для раскрытия действуют только до продолжения
+    if (m_debugPanel) {
+        m_debugPanel->clear();
+    }
+    
+    QJsonObject arguments;
+    if (!stepMode.isEmpty()) {
+        arguments.insert("mode", stepMode);
+    }
+    sendDebugCommand(command, arguments);
+}
+
+void MainWindow::sendDebugCommand(const QString &command, const QJsonObject &arguments) {
+    if (!m_runnerChannel) return;
+    QJsonObject message = arguments;
+    message.insert("command", command);
+    m_runnerChannel->send(message);
+}
+
+void MainWindow::onDebugBreak(const QJsonObject &message) {
+    const int lineNumber = message.value("line").toInt() - 1; // Конвертируем в 0-based
+    m_currentBreakpointLine = lineNumber;
+    
+    // Подсвечиваем строку в редакторе
+    CodeEditor *editor = currentEditor();
+    if (editor) {
+        // QScintilla использует номера строк напрямую (0-based)
+        if (lineNumber >= 0 && lineNumber < editor->lines()) {
+            editor->setCursorPosition(lineNumber, 0);
+            editor->ensureLineVisible(lineNumber);
+            editor->setDebugLine(lineNumber);
+        }
+    }
+    
+    // Стек и переменные верхнего кадра; содержимое объектов - по раскрытию узлов
+    ensureDebugDock();
+    m_debugDock->show();
+    m_debugDock->raise();
+    sendDebugCommand("stack");
+    QJsonObject frame;
+    frame.insert("frame", 0);
+    sendDebugCommand("locals", frame);
+    
+    statusBar()->showMessage(tr("Остановка на строке %1. F9 - продолжить, F10/F11/Shift+F11 - шаг.").arg(lineNumber + 1));
+}
+
+void MainWindow::clearDebugLine() {
+    for (int i = 0; i < m_tabWidget->count(); ++i) {
+        CodeEditor *editor = getEditorFromTabWidget(i);
+        if (editor) {
+            editor->setDebugLine(-1);
+        }
+    }
 }
 
 void MainWindow::onOutputInputReturnPressed() {
@@ -2101,23 +2018,8 @@ void MainWindow::onOutputInputReturnPressed() {
     
     // Показываем введенный текст в выводе в новой строке
     if (m_output) {
-        // Перемещаем курсор в конец и добавляем новую строку
-        QTextCursor cursor = m_output->textCursor();
-        cursor.movePosition(QTextCursor::End);
-        // Убеждаемся, что мы на новой строке
-        if (!cursor.atBlockStart()) {
-            cursor.insertText("\n");
-        }
-        // Добавляем введенный текст
-        cursor.insertText(text);
-        // Добавляем перенос строки после введенного текста
-        cursor.insertText("\n");
-        cursor.movePosition(QTextCursor::End);
-        m_output->setTextCursor(cursor);
-        // Прокручиваем к концу
-        QTextCursor scrollCursor = m_output->textCursor();
-        scrollCursor.movePosition(QTextCursor::End);
-        m_output->setTextCursor(scrollCursor);
+        m_output->ensureNewLine();
+        m_output->appendText(text + "\n");
     }
     
     if (text.isEmpty()) {
@@ -2132,96 +2034,37 @@ void MainWindow::onOutputInputReturnPressed() {
     m_outputInput->clear();
 }
 
-void MainWindow::checkDebugSyncFile() {
-    if (!m_isDebugging || m_debugSyncFile.isEmpty()) {
-        if (m_debugTimer) {
-            m_debugTimer->stop();
-        }
-        return;
-    }
-    
-    // Проверяем файл синхронизации
-    if (QFile::exists(m_debugSyncFile)) {
-        QFile file(m_debugSyncFile);
-        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QTextStream in(&file);
-            QString line = in.readLine();
-            if (line.startsWith("BREAKPOINT:")) {
-                int lineNumber = line.mid(11).toInt() - 1; // Конвертируем в 0-based
-                m_currentBreakpointLine = lineNumber;
-                
-                // Подсвечиваем строку в редакторе
-                CodeEditor *editor = currentEditor();
-                if (editor) {
-                    // QScintilla использует номера строк напрямую (0-based)
-                    if (lineNumber >= 0 && lineNumber < editor->lines()) {
-                        editor->setCursorPosition(lineNumber, 0);
-                        editor->ensureLineVisible(lineNumber);
-                    }
-                }
-                
-                statusBar()->showMessage(tr("Остановка на строке %1. Нажмите F9 для продолжения.").arg(lineNumber + 1));
-            }
-            file.close();
-        }
-    }
-    
-    // Проверяем, завершился ли процесс
-    if (m_process && m_process->state() == QProcess::NotRunning) {
-        m_isDebugging = false;
-        m_currentBreakpointLine = -1;
-        if (m_debugTimer) {
-            m_debugTimer->stop();
-        }
-        if (QFile::exists(m_debugSyncFile)) {
-            QFile::remove(m_debugSyncFile);
-        }
-        m_debugSyncFile.clear();
-        
-        // Отменяем регистрацию глобального хоткея
-#ifdef _WIN32
-        if (m_hotkeyRegistered) {
-            HWND hwnd = reinterpret_cast<HWND>(winId());
-            if (hwnd) {
-                UnregisterHotKey(hwnd, HOTKEY_ID);
-            }
-            m_hotkeyRegistered = false;
-        }
-#endif
-    }
-}
-
 void MainWindow::choosePython() {
     const QString startDir = QFileInfo(configuredPythonPath()).absolutePath();
-    QString selectedPath = showFilePicker(
+    pickFile(
         tr("Исполняемые (*.exe);;Все файлы (*.*)"),
         startDir,
         false,
-        false
-    );
-    
-    if (selectedPath.isEmpty()) return;
-    QSettings s;
-    s.beginGroup(SETTINGS_GROUP);
-    s.setValue(SETTINGS_PYTHON_PATH, selectedPath);
-    s.endGroup();
-    statusBar()->showMessage(tr("Выбран Python: %1").arg(selectedPath), 3000);
+        false,
+        [this](const QString &selectedPath) {
+            if (selectedPath.isEmpty()) return;
+            QSettings s;
+            s.beginGroup(SETTINGS_GROUP);
+            s.setValue(SETTINGS_PYTHON_PATH, selectedPath);
+            s.endGroup();
+            statusBar()->showMessage(tr("Выбран Python: %1").arg(selectedPath), 3000);
+        });
 }
 
 void MainWindow::openProjectFolder() {
-    QString selectedDir = showFilePicker(
+    pickFile(
         QString(),
         m_fsModel ? m_fsModel->rootPath() : QDir::currentPath(),
         false,
-        true
-    );
-    
-    if (selectedDir.isEmpty()) return;
-    ensureProjectDock();
-    m_fsModel->setRootPath(selectedDir);
-    m_fsView->setRootIndex(m_fsModel->index(selectedDir));
-    if (m_projectDock)
-        m_projectDock->show();
+        true,
+        [this](const QString &selectedDir) {
+            if (selectedDir.isEmpty()) return;
+            ensureProjectDock();
+            m_fsModel->setRootPath(selectedDir);
+            m_fsView->setRootIndex(m_fsModel->index(selectedDir));
+            if (m_projectDock)
+                m_projectDock->show();
+        });
 }
 
 void MainWindow::startRepl() {
@@ -2292,49 +2135,84 @@ void MainWindow::onProcessStarted() {
     }
 }
 
-void MainWindow::onProcessStdout() {
-    QByteArray data = m_process->readAllStandardOutput();
-    // Пробуем разные кодировки для правильного отображения
-    QString text;
-    text = QString::fromUtf8(data);
-    if (text.isEmpty() || text.contains(QChar::ReplacementCharacter)) {
-        text = QString::fromLocal8Bit(data);
+void MainWindow::onProcessOutput(const QString &text, bool isError) {
+    // Текст приходит уже декодированным и собранным за кадр (см. ProcessOutputPump)
+    appendOutput(text, isError);
+}
+
+void MainWindow::onFirstOutput(qint64 latencyMs) {
+    statusBar()->showMessage(m_runUsesWarmWorker
+                                 ? tr("Выполняется... первый вывод через %1 мс (быстрый запуск)").arg(latencyMs)
+                                 : tr("Выполняется... первый вывод через %1 мс").arg(latencyMs));
+}
+
+void MainWindow::onRunnerMessage(const QJsonObject &message) {
+    const QString event = message.value("event").toString();
+    if (event == "break") {
+        onDebugBreak(message);
+        return;
     }
-    
-    if (!text.isEmpty()) {
-        // Ограничиваем размер буфера для экономии памяти
-        const int MAX_BUFFER_SIZE = 100000; // Максимум ~100К символов
-        if (m_stdoutBuffer.length() > MAX_BUFFER_SIZE) {
-            m_stdoutBuffer = m_stdoutBuffer.right(80000); // Оставляем последние 80К
+    if (event == "stack" || event == "locals" || event == "children") {
+        if (!m_debugPanel) return;
+        if (event == "stack") {
+            m_debugPanel->setStack(message.value("frames").toArray());
+        } else if (event == "locals") {
+            m_debugPanel->setVariables(message.value("variables").toArray());
+        } else {
+            m_debugPanel->setChildren(message.value("ref").toInt(), message.value("variables").toArray());
         }
-        m_stdoutBuffer += text;
-        appendOutput(text, false);
+        return;
     }
-}
-
-void MainWindow::onProcessStderr() {
-    QByteArray data = m_process->readAllStandardError();
-    // Пробуем разные кодировки для правильного отображения
-    QString text;
-    text = QString::fromUtf8(data);
-    if (text.isEmpty() || text.contains(QChar::ReplacementCharacter)) {
-        text = QString::fromLocal8Bit(data);
+    if (event != "exception" || m_exceptionReported) {
+        return;
     }
     
-    if (!text.isEmpty()) {
-        // Ограничиваем размер буфера для экономии памяти
-        const int MAX_BUFFER_SIZE = 100000; // Максимум ~100К символов
-        if (m_stderrBuffer.length() > MAX_BUFFER_SIZE) {
-            m_stderrBuffer = m_stderrBuffer.right(80000); // Оставляем последние 80К
-        }
-        m_stderrBuffer += text;
-        appendOutput(text, true);
+    // Запись об исключении приходит в момент ошибки - подсвечиваем сразу, не дожидаясь завершения
+    QVector<TracebackFrame> frames;
+    const QJsonArray jsonFrames = message.value("frames").toArray();
+    for (const QJsonValue &value : jsonFrames) {
+        const QJsonObject obj = value.toObject();
+        TracebackFrame frame;
+        frame.path = obj.value("file").toString();
+        frame.line = obj.value("line").toInt();
+        frame.function = obj.value("function").toString();
+        frames.append(frame);
+    }
+    // Место ошибки (для SyntaxError его нет среди кадров)
+    if (message.contains("file")) {
+        TracebackFrame frame;
+        frame.path = message.value("file").toString();
+        frame.line = message.value("line").toInt();
+        frames.append(frame);
+    }
+    
+    m_exceptionReported = true;
+    parseErrorAndHighlight(frames);
+    statusBar()->showMessage(tr("Ошибка: %1: %2")
+                                 .arg(message.value("type").toString(), message.value("message").toString()));
+}
+
+void MainWindow::onOutputStatsUpdated(qint64 bytesPerSecond, qint64 droppedLines) {
+    if (!m_process || m_process->state() != QProcess::Running) return;
+    QString message = tr("Выполняется... вывод %1 КБ/с").arg(bytesPerSecond / 1024);
+    if (droppedLines > 0) {
+        message += tr(", пропущено строк: %1").arg(droppedLines);
     }
+    statusBar()->showMessage(message);
 }
 
 void MainWindow::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
     Q_UNUSED(status);
     
+    // Выводим остаток, накопленный за последний кадр
+    qint64 droppedLines = 0;
+    qint64 firstOutputMs = -1;
+    if (m_outputPump) {
+        m_outputPump->flush();
+        droppedLines = m_outputPump->droppedLines();
+        firstOutputMs = m_outputPump->firstOutputLatency();
+    }
+    
     // Скрываем поле ввода когда процесс завершен
     if (m_outputInput) {
         m_outputInput->setVisible(false);
@@ -2345,13 +2223,10 @@ void MainWindow::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
     if (m_isDebugging) {
         m_isDebugging = false;
         m_currentBreakpointLine = -1;
-        if (m_debugTimer) {
-            m_debugTimer->stop();
-        }
-        if (QFile::exists(m_debugSyncFile)) {
-            QFile::remove(m_debugSyncFile);
+        clearDebugLine();
+        if (m_debugPanel) {
+            m_debugPanel->clear();
         }
-        m_debugSyncFile.clear();
         
         // Отменяем регистрацию глобального хоткея
 #ifdef _WIN32
@@ -2365,37 +2240,36 @@ void MainWindow::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
 #endif
     }
     
-    statusBar()->showMessage(tr("Готов"));
+    if (!m_scriptRunningInConsole && firstOutputMs >= 0) {
+        statusBar()->showMessage(tr("Готов (первый вывод через %1 мс)").arg(firstOutputMs));
+    } else {
+        statusBar()->showMessage(tr("Готов"));
+    }
     
     // Выводим сообщение о завершении только если скрипт был запущен через QProcess (не через консоль)
     if (!m_scriptRunningInConsole) {
+        if (droppedLines > 0) {
+            appendOutput(tr("\n[Пропущено строк вывода: %1]").arg(droppedLines), false);
+        }
         appendOutput(QString("\n[Process exited with code %1]\n").arg(exitCode), exitCode != 0);
     }
     
-    // Парсим ошибки и подсвечиваем строку с ошибкой
-    // Проверяем как stderr, так и stdout (ошибки могут выводиться через print)
-    QString allErrors = m_stderrBuffer + m_stdoutBuffer;
-    if (!allErrors.isEmpty()) {
-        // Проверяем наличие сообщений об ошибках
-        bool hasError = allErrors.contains("Error:") || 
-                       allErrors.contains("Ошибка:") ||
-                       allErrors.contains("FileNotFoundError") ||
-                       allErrors.contains("IndexError") ||
-                       allErrors.contains("KeyError") ||
-                       allErrors.contains("ZeroDivisionError") ||
-                       allErrors.contains("TypeError") ||
-                       allErrors.contains("ValueError") ||
-                       allErrors.contains("division by zero") ||
-                       allErrors.contains("Traceback") ||
-                       exitCode != 0;
-        
-        if (hasError) {
-            parseErrorAndHighlight(allErrors);
+    // Запись об исключении могла прийти по служебному каналу одновременно с завершением
+    if (m_runnerChannel) {
+        m_runnerChannel->drain();
+    }
+    
+    // Если обертка не сообщила об исключении (консоль, старый вывод),
+    // используем кадры трассировки, уже распознанные при выводе
+    if (!m_exceptionReported) {
+        const QVector<TracebackFrame> frames = m_scriptRunningInConsole
+            ? m_consoleTraceback.frames()
+            : (m_output ? m_output->tracebackFrames() : QVector<TracebackFrame>());
+        if (!frames.isEmpty()) {
+            parseErrorAndHighlight(frames);
         }
     }
     
-    m_stderrBuffer.clear();
-    m_stdoutBuffer.clear();
     m_runningFilePath.clear();
     m_scriptRunningInConsole = false; // Сбрасываем флаг
 }
@@ -2419,7 +2293,7 @@ void MainWindow::onReplFinished(int exitCode, QProcess::ExitStatus status) {
     appendReplOutput(QString("\n[REPL exited with code %1]\n").arg(exitCode), exitCode != 0);
 }
 
-bool MainWindow::maybeSave() {
+bool MainWindow::maybeSave(const std::function<void()> &retry) {
     CodeEditor *editor = currentEditor();
     if (!editor || !editor->document()->isModified())
         return true;
@@ -2444,20 +2318,27 @@ bool MainWindow::maybeSave() {
         QMessageBox::Save);
     if (ret == QMessageBox::Save) {
         if (filePath.isEmpty()) {
-            saveFileAs();
-        } else {
-            saveToPath(filePath);
+            // Ответ диалога придет позже; сохраненный файл уже не изменен, и повтор действия пройдет дальше
+            saveEditorAs(editor, retry);
+            return false;
         }
-        return !editor->document()->isModified();
+        return saveToPath(filePath, editor);
     }
     if (ret == QMessageBox::Cancel)
         return false;
     return true;
 }
 
-bool MainWindow::saveToPath(const QString &path) {
-    CodeEditor *editor = currentEditor();
+bool MainWindow::saveToPath(const QString &path, CodeEditor *editor) {
+    if (!editor) {
+        editor = currentEditor();
+    }
     if (!editor) return false;
+    if (editor->isLoading()) {
+        // Иначе на диск попала бы только загруженная часть файла
+        statusBar()->showMessage(tr("Файл еще загружается"), 3000);
+        return false;
+    }
     
     QFile f(path);
     if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
@@ -2474,6 +2355,7 @@ bool MainWindow::saveToPath(const QString &path) {
     int currentIndex = m_tabWidget->currentIndex();
     m_editorToPath[editor] = path;
     updateTabText(editor);
+    scheduleSessionSave();
     
     updateWindowTitle();
     statusBar()->showMessage(tr("Сохранено: %1").arg(QDir::toNativeSeparators(path)), 3000);
@@ -2499,7 +2381,7 @@ void MainWindow::openFileFromPath(const QString &path) {
             }
         } else if (editor->document()->isModified()) {
             // Для непустых или сохраненных файлов показываем диалог только если файл изменен
-            if (!maybeSave())
+            if (!maybeSave([this, path]() { openFileFromPath(path); }))
                 return;
         }
     }
@@ -2507,7 +2389,7 @@ void MainWindow::openFileFromPath(const QString &path) {
     loadFromPath(path);
 }
 
-void MainWindow::loadFromPath(const QString &path) {
+void MainWindow::loadFromPath(const QString &path, bool activate) {
     // Удаляем кавычки, если они есть
     QString cleanPath = path.trimmed();
     if (cleanPath.startsWith('"') && cleanPath.endsWith('"')) {
@@ -2539,54 +2421,131 @@ void MainWindow::loadFromPath(const QString &path) {
         return;
     }
     
-    QFile f(normalizedPath);
-    if (!f.open(QIODevice::ReadOnly)) {
-        QMessageBox::critical(this, tr("Ошибка чтения"), 
-            tr("Не удалось открыть файл:\n%1\n\n%2").arg(normalizedPath, f.errorString()));
+    // Вкладка хранит только путь - редактор создается, когда ее впервые покажут
+    LazyTab tab;
+    tab.path = normalizedPath;
+    const int index = addLazyTab(tab);
+    QWidget *container = m_tabWidget->widget(index);
+    if (!activate) {
         return;
     }
-    QTextStream ts(&f);
-    ts.setCodec("UTF-8");
-    const QString text = ts.readAll();
-    f.close();
-    
-    // Ограничиваем количество открытых вкладок для экономии памяти
-    const int MAX_TABS = 50;
-    int codeEditorCount = 0;
-    for (int i = 0; i < m_tabWidget->count(); ++i) {
-        CodeEditor *editor = getEditorFromTabWidget(i);
-        if (editor) codeEditorCount++;
-    }
-    if (codeEditorCount >= MAX_TABS) {
-        QMessageBox::warning(this, tr("Превышен лимит"), 
-            tr("Достигнут максимум %1 открытых вкладок редактора. Закройте некоторые вкладки перед открытием новых.").arg(MAX_TABS));
+    // Переключение создает редактор (onTabChanged)
+    m_tabWidget->setCurrentIndex(index);
+    CodeEditor *editor = getEditorFromWidget(container);
+    if (!editor) {
         return;
     }
     
-    // Создаем новую вкладку с обёрткой для анимации
+    // Анимируем появление вкладки только если это не инициализация
+    if (!m_isInitializing) {
+        animateTabOpening(container, m_tabWidget->indexOf(container));
+    }
+    
+    updateWindowTitle();
+    if (!editor->isLoading()) {
+        statusBar()->showMessage(tr("Открыто: %1").arg(QDir::toNativeSeparators(normalizedPath)), 3000);
+    }
+}
+
+QWidget *MainWindow::createTabContainer() {
+    // Обёртка вкладки (для анимации); редактор добавляется в нее при создании
     QWidget *container = new QWidget(m_tabWidget);
     QVBoxLayout *layout = new QVBoxLayout(container);
     layout->setContentsMargins(0, 0, 0, 0);
     layout->setSpacing(0);
-    
-    CodeEditor *editor = new CodeEditor(container);
-    setupEditor(editor);
-    editor->setPlainText(text);
-    editor->document()->setModified(false);
-    layout->addWidget(editor);
-    
-    // Убеждаемся, что контейнер и редактор правильно растягиваются
     container->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    editor->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    return container;
+}
+
+int MainWindow::addLazyTab(const LazyTab &tab, int position) {
+    QWidget *container = createTabContainer();
+    m_lazyTabs.insert(container, tab);
+    const QString title = QFileInfo(tab.path).fileName();
+    const int index = position < 0 ? m_tabWidget->addTab(container, title)
+                                   : m_tabWidget->insertTab(position, container, title);
+    m_tabWidget->setTabToolTip(index, QDir::toNativeSeparators(tab.path));
+    scheduleSessionSave();
+    return index;
+}
+
+CodeEditor *MainWindow::materializeTab(QWidget *container) {
+    auto lazy = m_lazyTabs.find(container);
+    if (lazy == m_lazyTabs.end()) {
+        return getEditorFromWidget(container);
+    }
+    if (!ensureEditorCapacity(container)) {
+        return nullptr;
+    }
+    const LazyTab tab = lazy.value();
     
-    QFileInfo fi(normalizedPath);
-    int index = m_tabWidget->addTab(container, fi.fileName());
-    m_editorToPath[editor] = normalizedPath;
-    m_tabWidget->setCurrentIndex(index);
+    // Файл отображается в память и передается редактору без промежуточного QString
+    auto *loader = new FileLoader(tab.path);
+    QString readError;
+    if (!loader->open(&readError)) {
+        delete loader;
+        QMessageBox::critical(this, tr("Ошибка чтения"), 
+            tr("Не удалось открыть файл:\n%1\n\n%2").arg(tab.path, readError));
+        // Вкладка без файла не нужна; удаляем после выхода из обработчика переключения
+        QPointer<QWidget> containerPtr = container;
+        QTimer::singleShot(0, this, [this, containerPtr]() {
+            if (!containerPtr) return;
+            m_lazyTabs.remove(containerPtr);
+            m_tabLastActive.remove(containerPtr);
+            const int index = m_tabWidget->indexOf(containerPtr);
+            if (index >= 0) {
+                m_tabWidget->removeTab(index);
+            }
+            containerPtr->deleteLater();
+        });
+        return nullptr;
+    }
+    m_lazyTabs.erase(lazy);
     
-    // Анимируем появление вкладки только если это не инициализация
-    if (!m_isInitializing) {
-        animateTabOpening(container, index);
+    CodeEditor *editor = new CodeEditor(container);
+    setupEditor(editor);
+    m_editorToPath[editor] = tab.path;
+    loader->setParent(editor);
+    const qint64 largeFileBytes =
+        QSettings().value("editor/largeFileSizeMB", DEFAULT_LARGE_FILE_MB).toLongLong() * 1024 * 1024;
+    if (loader->size() >= largeFileBytes) {
+        // Большой файл (журналы, сгенерированные данные): вкладка открывается сразу,
+        // текст догружается частями, без сворачивания и индекса слов
+        editor->enterLargeFileMode();
+        editor->setLoading(true);
+        const QString fileName = QFileInfo(tab.path).fileName();
+        connect(loader, &FileLoader::progress, this, [this, fileName](int percent) {
+            statusBar()->showMessage(tr("Загрузка %1: %2%").arg(fileName).arg(percent));
+        });
+        connect(loader, &FileLoader::finished, this, [this, editor, loader, tab]() {
+            editor->setLoading(false);
+            loader->deleteLater();
+            if (tab.line >= 0) {
+                editor->setCursorPosition(tab.line, tab.index);
+                editor->setFirstVisibleLine(tab.firstVisibleLine);
+            }
+            for (int line : tab.breakpoints) {
+                editor->setBreakpoint(line, true);
+            }
+            updateWindowTitle();
+            statusBar()->showMessage(tr("Открыто: %1").arg(QDir::toNativeSeparators(tab.path)), 3000);
+        });
+        loader->start(editor);
+    } else {
+        loader->load(editor);
+        delete loader;
+        // Выгруженная ранее вкладка возвращается к прежнему месту
+        if (tab.line >= 0) {
+            editor->setCursorPosition(tab.line, tab.index);
+            editor->setFirstVisibleLine(tab.firstVisibleLine);
+        }
+        for (int line : tab.breakpoints) {
+            editor->setBreakpoint(line, true);
+        }
+    }
+    container->layout()->addWidget(editor);
+    editor->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    if (container == m_tabWidget->currentWidget()) {
+        editor->setFocus();
     }
     
     // Обновляем автодополнение после загрузки содержимого файла
@@ -2601,9 +2560,204 @@ void MainWindow::loadFromPath(const QString &path) {
             }
         }
     });
+    return editor;
+}
+
+bool MainWindow::canEvictTab(QWidget *container) const {
+    if (!container || container == m_tabWidget->currentWidget() || m_lazyTabs.contains(container)) {
+        return false;
+    }
+    CodeEditor *editor = getEditorFromWidget(container);
+    // Выгружаются только редакторы, которые можно без потерь открыть с диска заново
+    return editor && !m_editorToPath.value(editor).isEmpty() && !editor->document()->isModified()
+        && !editor->isLoading() && editor->breakpoints().isEmpty()
+        && !(m_process && m_process->state() != QProcess::NotRunning);
+}
+
+void MainWindow::evictTab(QWidget *container) {
+    CodeEditor *editor = getEditorFromWidget(container);
+    if (!editor) return;
     
-    updateWindowTitle();
-    statusBar()->showMessage(tr("Открыто: %1").arg(QDir::toNativeSeparators(normalizedPath)), 3000);
+    LazyTab tab { m_editorToPath.value(editor) };
+    editor->getCursorPosition(&tab.line, &tab.index);
+    tab.firstVisibleLine = editor->firstVisibleLine();
+    forgetEditor(editor);
+    delete editor;
+    m_lazyTabs.insert(container, tab);
+}
+
+void MainWindow::evictIdleTabs() {
+    const int idleMinutes = QSettings().value("editor/unloadIdleMinutes", DEFAULT_UNLOAD_IDLE_MINUTES).toInt();
+    if (idleMinutes <= 0 || !m_tabWidget) return;
+    
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < m_tabWidget->count(); ++i) {
+        QWidget *container = m_tabWidget->widget(i);
+        if (canEvictTab(container) && now - m_tabLastActive.value(container, 0) >= qint64(idleMinutes) * 60 * 1000) {
+            evictTab(container);
+        }
+    }
+}
+
+bool MainWindow::ensureEditorCapacity(QWidget *keep) {
+    int liveEditors = 0;
+    for (int i = 0; i < m_tabWidget->count(); ++i) {
+        if (getEditorFromTabWidget(i)) ++liveEditors;
+    }
+    // Сверх лимита выгружаем давно не открывавшиеся вкладки - сами вкладки не закрываются
+    while (liveEditors >= MAX_LIVE_EDITORS) {
+        QWidget *oldest = nullptr;
+        for (int i = 0; i < m_tabWidget->count(); ++i) {
+            QWidget *container = m_tabWidget->widget(i);
+            if (container != keep && canEvictTab(container)
+                && (!oldest || m_tabLastActive.value(container, 0) < m_tabLastActive.value(oldest, 0))) {
+                oldest = container;
+            }
+        }
+        if (!oldest) {
+            QMessageBox::warning(this, tr("Превышен лимит"), 
+                tr("Открыто %1 редакторов с несохраненными изменениями или точками останова. "
+                   "Сохраните или закройте некоторые вкладки перед открытием новых.").arg(MAX_LIVE_EDITORS));
+            return false;
+        }
+        evictTab(oldest);
+        --liveEditors;
+    }
+    return true;
+}
+
+void MainWindow::forgetEditor(CodeEditor *editor) {
+    // Ключ файла на сервере анализа строится по пути - закрываем до удаления пути
+    if (m_completionServer) {
+        m_completionServer->closeFile(completionFileKey(editor));
+    }
+    m_editorToPath.remove(editor);
+    // Очищаем кэш автодополнений для этого редактора
+    m_fileCompletionsCache.remove(editor);
+    m_fileSymbolsRevision.remove(editor);
+    m_editorCompletionsModels.remove(editor);
+    if (m_syntaxCheckEditor == editor) {
+        m_syntaxCheckId = 0;
+        m_syntaxCheckEditor = nullptr;
+    }
+}
+
+Session MainWindow::currentSession() const {
+    Session session;
+    if (!m_tabWidget) return session;
+    for (int i = 0; i < m_tabWidget->count(); ++i) {
+        QWidget *container = m_tabWidget->widget(i);
+        SessionFile file;
+        const auto lazy = m_lazyTabs.constFind(container);
+        if (lazy != m_lazyTabs.constEnd()) {
+            // Вкладка без редактора - позиция хранится в ней самой
+            file.path = lazy->path;
+            file.line = qMax(0, lazy->line);
+            file.index = lazy->index;
+            file.firstVisibleLine = lazy->firstVisibleLine;
+            file.breakpoints = lazy->breakpoints;
+        } else {
+            CodeEditor *editor = getEditorFromWidget(container);
+            if (!editor) continue; // Настройки, справка, редактор pyrob
+            file.path = m_editorToPath.value(editor);
+            editor->getCursorPosition(&file.line, &file.index);
+            file.firstVisibleLine = editor->firstVisibleLine();
+            file.breakpoints = editor->breakpoints().values();
+            std::sort(file.breakpoints.begin(), file.breakpoints.end());
+        }
+        if (file.path.isEmpty()) continue; // Несохраненный новый файл
+        if (container == m_tabWidget->currentWidget()) {
+            session.activeIndex = session.files.size();
+        }
+        session.files.append(file);
+    }
+    return session;
+}
+
+void MainWindow::scheduleSessionSave() {
+    // Таймер не перезапускается - при непрерывном наборе снимок все равно пишется
+    if (m_sessionReady && !m_sessionSaveTimer->isActive()) {
+        m_sessionSaveTimer->start();
+    }
+}
+
+void MainWindow::restoreSession() {
+    StartupTrace::mark(QStringLiteral("session restore"));
+    const Session session = m_sessionStore->load();
+    m_pendingSessionFiles = session.files;
+    m_pendingActiveIndex = -1;
+    
+    // Сначала только активная вкладка - она нужна для первого кадра
+    if (session.activeIndex >= 0 && session.activeIndex < session.files.size()) {
+        const SessionFile &active = session.files.at(session.activeIndex);
+        if (QFileInfo(active.path).isFile()) {
+            CodeEditor *initial = currentEditor();
+            if (initial && initial->property("isInitialFile").toBool()
+                && m_editorToPath.value(initial).isEmpty() && initial->document()->isEmpty()) {
+                initial->document()->setModified(false);
+                closeTab(m_tabWidget->currentIndex());
+            }
+            LazyTab tab;
+            tab.path = active.path;
+            tab.line = active.line;
+            tab.index = active.index;
+            tab.firstVisibleLine = active.firstVisibleLine;
+            tab.breakpoints = active.breakpoints;
+            const int index = addLazyTab(tab);
+            m_sessionActiveTab = m_tabWidget->widget(index);
+            m_tabWidget->setCurrentIndex(index); // Создает редактор (onTabChanged)
+            m_pendingActiveIndex = session.activeIndex;
+        }
+    }
+    
+    // Остальные вкладки - после того как окно нарисовано
+    StartupTrace::watchFirstPaint(this, [this]() {
+        QTimer::singleShot(0, this, &MainWindow::finishStartup);
+    });
+    QTimer::singleShot(STARTUP_FALLBACK_MS, this, &MainWindow::finishStartup);
+}
+
+void MainWindow::finishStartup() {
+    if (m_startupFinished) return;
+    m_startupFinished = true;
+    
+    // Вкладки сеанса встают вокруг активной в прежнем порядке; файлы, уже открытые
+    // из командной строки, и удаленные с диска пропускаются
+    const bool hasActive = m_sessionActiveTab && m_tabWidget->indexOf(m_sessionActiveTab) >= 0;
+    int position = hasActive ? m_tabWidget->indexOf(m_sessionActiveTab) : -1;
+    for (int i = 0; i < m_pendingSessionFiles.size(); ++i) {
+        if (i == m_pendingActiveIndex) {
+            position = hasActive ? m_tabWidget->indexOf(m_sessionActiveTab) + 1 : -1;
+            continue;
+        }
+        const SessionFile &file = m_pendingSessionFiles.at(i);
+        if (!QFileInfo(file.path).isFile() || findTabByPath(file.path) >= 0) {
+            continue;
+        }
+        LazyTab tab;
+        tab.path = file.path;
+        tab.line = file.line;
+        tab.index = file.index;
+        tab.firstVisibleLine = file.firstVisibleLine;
+        tab.breakpoints = file.breakpoints;
+        addLazyTab(tab, position);
+        if (position >= 0) {
+            ++position;
+        }
+    }
+    m_pendingSessionFiles.clear();
+    m_pendingActiveIndex = -1;
+    m_sessionReady = true;
+    scheduleSessionSave();
+    
+    StartupTrace::markInteractive();
+    QSettings settings;
+    settings.setValue("startup/firstPaintMs", StartupTrace::firstPaintMs());
+    settings.setValue("startup/interactiveMs", StartupTrace::interactiveMs());
+    if (StartupTrace::firstPaintMs() >= 0) {
+        statusBar()->showMessage(tr("Запуск: окно за %1 мс, готово к работе за %2 мс")
+                                     .arg(StartupTrace::firstPaintMs()).arg(StartupTrace::interactiveMs()), 5000);
+    }
 }
 
 QString MainWindow::embeddedPythonPath() const {
@@ -2669,6 +2823,16 @@ void MainWindow::onTabCloseRequested(int index) {
 }
 
 void MainWindow::onTabChanged(int index) {
+    // Время ухода с вкладки - по нему выгружаются давно не открывавшиеся редакторы
+    if (m_activeTabContainer) {
+        m_tabLastActive.insert(m_activeTabContainer, QDateTime::currentMSecsSinceEpoch());
+    }
+    m_activeTabContainer = m_tabWidget ? m_tabWidget->widget(index) : nullptr;
+    if (m_activeTabContainer && m_lazyTabs.contains(m_activeTabContainer)) {
+        materializeTab(m_activeTabContainer);
+    }
+    scheduleSessionSave();
+    
     // Обновляем индекс вкладки настроек, если она была перемещена
     if (m_settingsWidget && m_tabWidget) {
         for (int i = 0; i < m_tabWidget->count(); ++i) {
@@ -2693,6 +2857,11 @@ void MainWindow::onTabChanged(int index) {
     // (анимация уже запущена из tabBarClicked, если переключение было по клику)
     m_previousTabIndex = index;
     
+    // Подчеркивание ошибки во вновь открытой вкладке может быть устаревшим
+    if (m_syntaxCheckTimer && m_liveSyntaxCheckEnabled) {
+        m_syntaxCheckTimer->start();
+    }
+    
     // Периодически очищаем кэши Qt для предотвращения накопления памяти
     m_tabSwitchCount++;
     if (m_tabSwitchCount >= 10) { // Каждые 10 переключений
@@ -2858,31 +3027,35 @@ void MainWindow::closeTab(int index) {
             
             if (ret == QMessageBox::Save) {
                 if (filePath.isEmpty()) {
-                    // Сохраняем как новый файл
-                    QString path = showFilePicker(
+                    // Сохраняем как новый файл. Путь выбирается асинхронно: вкладка остается
+                    // открытой, а после записи закрытие повторяется - уже без вопроса
+                    QPointer<QWidget> container = tabWidget;
+                    QPointer<CodeEditor> editorPtr = editor;
+                    pickFile(
                         tr("Python файлы (*.py);;Все файлы (*.*)"),
                         QString(),
                         true,
-                        false
-                    );
-                    
-                    if (path.isEmpty()) {
-                        // Восстанавливаем текущую вкладку
-                        if (currentIndex == index) {
-                            m_tabWidget->setCurrentIndex(index);
-                        }
-                        return;
-                    }
-                    if (!path.endsWith(".py", Qt::CaseInsensitive))
-                        path += ".py";
-                    
-                    QFile f(path);
-                    if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-                        QTextStream ts(&f);
-                        ts.setCodec("UTF-8");
-                        ts << editor->toPlainText();
-                        f.close();
-                    }
+                        false,
+                        [this, container, editorPtr](const QString &selectedPath) {
+                            if (selectedPath.isEmpty() || !container || !editorPtr) return;
+                            QString path = selectedPath;
+                            if (!path.endsWith(".py", Qt::CaseInsensitive))
+                                path += ".py";
+                            
+                            QFile f(path);
+                            if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                                QMessageBox::critical(this, tr("Ошибка записи"),
+                                    tr("Не удалось сохранить файл %1: %2").arg(path, f.errorString()));
+                                return;
+                            }
+                            QTextStream ts(&f);
+                            ts.setCodec("UTF-8");
+                            ts << editorPtr->toPlainText();
+                            f.close();
+                            editorPtr->document()->setModified(false);
+                            closeTab(m_tabWidget->indexOf(container));
+                        });
+                    return;
                 } else {
                     QFile f(filePath);
                     if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
@@ -2899,12 +3072,11 @@ void MainWindow::closeTab(int index) {
     
     // Удаляем из карты только редакторы
     if (editor) {
-        m_editorToPath.remove(editor);
-        // Очищаем кэш автодополнений для этого редактора
-        m_fileCompletionsCache.remove(editor);
-        m_fileContentHash.remove(editor);
-        m_editorCompletionsModels.remove(editor);
+        forgetEditor(editor);
     }
+    m_lazyTabs.remove(tabWidget);
+    m_tabLastActive.remove(tabWidget);
+    scheduleSessionSave();
     
     // Обновляем индекс вкладки настроек, если закрываемая вкладка была перед ней
     if (m_settingsTabIndex >= 0 && index < m_settingsTabIndex) {
@@ -3047,88 +3219,13 @@ void MainWindow::closeAllTabsExceptCurrent() {
 
 void MainWindow::appendOutput(const QString &text, bool isError) {
     if (!m_output) return;
-    
-    auto linkify = [&](const QString &t) {
-        // Поиск строк трассировки: File "path", line N
-        static QRegExp rx("File \"([^\"]+)\", line (\\d+)");
-        QString html = QString(t).toHtmlEscaped();
-        int pos = 0;
-        while ((pos = rx.indexIn(t, pos)) != -1) {
-            const QString path = rx.cap(1);
-            const QString line = rx.cap(2);
-            const QString orig = QString("File \"%1\", line %2").arg(path, line);
-            const QString repl = QString("<a href=\"vuzhyk://open?path=%1&line=%2\">%3</a>")
-                                  .arg(QString(path).toHtmlEscaped(), QString(line).toHtmlEscaped(), QString(orig).toHtmlEscaped());
-            html.replace(QString(orig).toHtmlEscaped(), repl);
-            pos += rx.matchedLength();
-        }
-        return html;
-    };
-
-    if (isError) {
-        m_output->insertHtml(QString("<span style='color:#b00020'>%1</span><br/>").arg(linkify(text)));
-    } else {
-        QString html = QString(text).toHtmlEscaped();
-        html.replace("\n", "<br/>");
-        m_output->insertHtml(QString("%1").arg(html));
-    }
-    
-    // Оптимизация памяти: ограничиваем размер вывода
-    const int MAX_OUTPUT_LENGTH = 500000; // Максимум ~500К символов
-    QString currentText = m_output->toPlainText();
-    if (currentText.length() > MAX_OUTPUT_LENGTH) {
-        // Оставляем последние 400К символов
-        QString trimmed = currentText.right(400000);
-        m_output->setPlainText(trimmed);
-        m_output->moveCursor(QTextCursor::End);
-    }
+    // Разбиение на строки, ссылки трассировки и ограничение памяти - внутри OutputView
+    m_output->appendText(text, isError);
 }
 
 void MainWindow::appendReplOutput(const QString &text, bool isError) {
-    auto linkify = [&](const QString &t) {
-        static QRegExp rx("File \"([^\"]+)\", line (\\d+)");
-        QString html = QString(t).toHtmlEscaped();
-        int pos = 0;
-        while ((pos = rx.indexIn(t, pos)) != -1) {
-            const QString path = rx.cap(1);
-            const QString line = rx.cap(2);
-            const QString orig = QString("File \"%1\", line %2").arg(path, line);
-            const QString repl = QString("<a href=\"vuzhyk://open?path=%1&line=%2\">%3</a>")
-                                  .arg(QString(path).toHtmlEscaped(), QString(line).toHtmlEscaped(), QString(orig).toHtmlEscaped());
-            html.replace(QString(orig).toHtmlEscaped(), repl);
-            pos += rx.matchedLength();
-        }
-        return html;
-    };
-    if (isError) {
-        m_replOutput->insertHtml(QString("<span style='color:#b00020'>%1</span><br/>").arg(linkify(text)));
-    } else {
-        QString html = QString(text).toHtmlEscaped();
-        html.replace("\n", "<br/>");
-        m_replOutput->insertHtml(QString("%1").arg(html));
-    }
-    
-    // Оптимизация памяти: ограничиваем размер вывода REPL
-    const int MAX_REPL_OUTPUT_LENGTH = 500000; // Максимум ~500К символов
-    QString currentText = m_replOutput->toPlainText();
-    if (currentText.length() > MAX_REPL_OUTPUT_LENGTH) {
-        // Оставляем последние 400К символов
-        QString trimmed = currentText.right(400000);
-        m_replOutput->setPlainText(trimmed);
-        m_replOutput->moveCursor(QTextCursor::End);
-    }
-}
-
-void MainWindow::onOutputAnchorClicked(const QUrl &url) {
-    if (url.scheme() != "vuzhyk") return;
-    QUrlQuery q(url);
-    const QString path = q.queryItemValue("path");
-    const int line = q.queryItemValue("line").toInt();
-    openFileAt(path, line);
-}
-
-void MainWindow::onReplAnchorClicked(const QUrl &url) {
-    onOutputAnchorClicked(url);
+    if (!m_replOutput) return;
+    m_replOutput->appendText(text, isError);
 }
 
 void MainWindow::onFsDoubleClicked(const QModelIndex &index) {
@@ -3172,12 +3269,6 @@ void MainWindow::updateCompletionFromDocument() {
     // Проверка completer не нужна, так как мы используем QsciAPIs для автокомплита
     // Продолжаем работу даже если completer равен nullptr
     
-    // Вычисляем хеш текущего содержимого файла
-    const QString currentContent = editor->toPlainText();
-    QCryptographicHash hash(QCryptographicHash::Md5);
-    hash.addData(currentContent.toUtf8());
-    QString currentHash = hash.result().toHex();
-    
     // Получаем текущую позицию курсора для проверки контекста
     int currentLine, currentIndex;
     editor->getCursorPosition(&currentLine, &currentIndex);
@@ -3205,367 +3296,276 @@ void MainWindow::updateCompletionFromDocument() {
         }
     }
     
-    // Загружаем задачи pyrob только если курсор находится в контексте "def "
+    // Задачи pyrob нужны только если курсор находится в контексте "def "
+    // (индекс строится в фоне, запрос к нему не обращается к диску)
     QStringList pyrobTasks;
-    if (isInDefContext) {
-        pyrobTasks = loadPyrobTasks();
+    if (isInDefContext && m_pyrobTaskIndex) {
+        pyrobTasks = m_pyrobTaskIndex->tasks();
+    }
+    
+    // Слова файла берутся из инкрементального индекса редактора (обновляется по правкам,
+    // без копирования и разбора всего текста). Ревизия индекса меняется только при
+    // изменении набора идентификаторов, поэтому правка внутри строки и перемещение
+    // курсора не вызывают пересчета
+    SymbolIndex *symbolIndex = editor->symbolIndex();
+    const auto cachedRevision = m_fileSymbolsRevision.constFind(editor);
+    if (cachedRevision == m_fileSymbolsRevision.constEnd() || cachedRevision.value() != symbolIndex->revision()) {
+        // Исключаем слова, которые являются началом базовых слов (недописанные имена)
+        QStringList fileWords;
+        for (const QString &w : symbolIndex->identifiers()) {
+            if (w.length() >= 3 && !(m_baseCompletionTrie && m_baseCompletionTrie->hasLongerWord(w))) {
+                fileWords.append(w);
+            }
+        }
+        m_fileCompletionsCache[editor] = fileWords;
+        m_fileSymbolsRevision[editor] = symbolIndex->revision();
     }
     
-    // Если содержимое не изменилось с последнего раза, используем кэш
-    // Включаем контекст def в ключ кэша
-    QString cacheKey = currentHash + QString("_def_%1").arg(isInDefContext ? 1 : 0);
-    if (m_fileContentHash.contains(editor) && m_fileContentHash[editor] == cacheKey) {
-        // Содержимое не изменилось - используем кэш
-        QStringList cachedFileWords = m_fileCompletionsCache[editor];
-        
-        // Объединяем базовые слова, кэшированные слова из файла и задачи pyrob
+    // Слой редактора: слова файла и задачи pyrob (только в контексте "def ").
+    // Базовое дерево общее, объединение выполняется при показе списка, поэтому
+    // здесь ничего не перестраивается; при неизменных словах вызов ничего не делает
+    QStringList pyrobTasksForAPI;
+    for (const QString &task : qAsConst(pyrobTasks)) {
+        if (task.length() > 1) {
+            pyrobTasksForAPI.append(task);
+        }
+    }
+    const QStringList deltaWords = m_fileCompletionsCache.value(editor) + pyrobTasksForAPI;
+    editor->setCompletionWords(deltaWords);
+    updateTabCompletionInfo(editor);
+    
+    // Модель completer для этого редактора (на случай, если используется QCompleter).
+    // Объединение с базовыми словами выполняется только при наличии модели
+    auto *model = m_editorCompletionsModels.value(editor);
+    if (model) {
         QSet<QString> allSet = m_cachedBaseCompletionsSet;
-        for (const QString &word : cachedFileWords) {
+        for (const QString &word : m_fileCompletionsCache.value(editor)) {
             allSet.insert(word);
         }
-        // Добавляем задачи pyrob только если в контексте def
-        if (isInDefContext) {
-            for (const QString &task : pyrobTasks) {
-                if (!task.isEmpty() && task.length() > 1) {
-                    allSet.insert(task);
-                }
-            }
+        for (const QString &task : qAsConst(pyrobTasksForAPI)) {
+            allSet.insert(task);
         }
-        
-        // Преобразуем в отсортированный список
         QStringList all = QStringList::fromSet(allSet);
         all.sort(Qt::CaseInsensitive);
-        
-        // Обновляем модель completer для этого редактора (если используется)
-        // Проверяем, что модель существует перед использованием
-        if (m_editorCompletionsModels.contains(editor)) {
-            auto *model = m_editorCompletionsModels.value(editor);
-            if (model) {
-                model->setStringList(all);
-            }
-        }
-        
-        // Обновляем API лексера для встроенного автокомплита QScintilla
-        // Проверяем, что редактор валиден и лексер инициализирован перед вызовом
-        if (editor) {
-            QsciLexer *lexer = editor->lexer();
-            if (lexer) {
-                // Используем QTimer для отложенного вызова, чтобы убедиться, что лексер полностью инициализирован
-                // Используем QPointer для безопасной проверки, что редактор еще существует
-                QPointer<CodeEditor> editorPtr = editor;
-                QTimer::singleShot(50, this, [editorPtr, pyrobTasks]() {
-                    if (editorPtr && editorPtr->lexer()) {
-                        try {
-                            editorPtr->updateAPIs(pyrobTasks);
-                        } catch (...) {
-                            // Игнорируем ошибки при обновлении API
-                        }
-                    }
-                });
-            }
-        }
-        
-        return; // Выходим, не пересчитывая слова
-    }
-    
-    // Содержимое изменилось - пересчитываем слова из файла
-    const QString text = currentContent;
-    const QStringList lines = text.split('\n');
-    
-    // Извлекаем идентификаторы из текста
-    QRegExp idRx("\\b[A-Za-z_][A-Za-z0-9_]*\\b");
-    QSet<QString> ids;
-    int pos = 0;
-    while ((pos = idRx.indexIn(text, pos)) != -1) {
-        const QString w = idRx.cap(0);
-        if (w.length() > 1) {
-            ids.insert(w);
-        }
-        pos += idRx.matchedLength();
-    }
-    
-    // Импорты: import xxx, from yyy import zzz
-    QRegExp importRx("^(?:from\\s+([A-Za-z_][A-Za-z0-9_\\.]*)\\s+import\\s+([A-Za-z_][A-Za-z0-9_]*(?:\\s*,\\s*[A-Za-z_][A-Za-z0-9_]*)*))|(?:import\\s+([A-Za-z_][A-Za-z0-9_]*(?:\\s*,\\s*[A-Za-z_][A-Za-z0-9_]*)*))$");
-    importRx.setCaseSensitivity(Qt::CaseInsensitive);
-    importRx.setMinimal(true);
-    for (const QString &ln : lines) {
-        if (importRx.indexIn(ln) >= 0) {
-            const QString fromMods = importRx.cap(1);
-            const QString imported = importRx.cap(2);
-            const QString mods = importRx.cap(3);
-            auto addCSV = [&](const QString &csv){ 
-                for (const QString &p : csv.split(',', QString::SkipEmptyParts)) {
-                    QString trimmed = p.trimmed();
-                    if (trimmed.length() > 1 && !trimmed.contains('.')) {
-                        ids.insert(trimmed);
-                    }
-                }
-            };
-            if (!fromMods.isEmpty()) {
-                addCSV(fromMods);
-                if (!imported.isEmpty()) addCSV(imported);
-            } else if (!mods.isEmpty()) {
-                addCSV(mods);
-            }
-        }
+        model->setStringList(all);
     }
+}
+
+void MainWindow::updateTabCompletionInfo(CodeEditor *editor) {
+    if (!m_tabWidget || !editor) return;
+    const int index = m_tabWidget->indexOf(editor->parentWidget());
+    if (index < 0) return;
     
-    // Фильтруем слова из файла (исключаем префиксы базовых слов)
-    // Используем QSet для быстрой проверки вместо линейного поиска
-    QStringList fileWords;
-    for (const QString &w : ids) {
-        if (w.length() >= 3) {
-            bool isPrefix = false;
-            // Проверяем, является ли слово префиксом какого-либо базового слова
-            // Используем QSet для быстрой проверки (O(1) вместо O(n))
-            for (const QString &baseWord : m_cachedBaseCompletionsSet) {
-                if (baseWord.length() > w.length() && baseWord.startsWith(w, Qt::CaseInsensitive)) {
-                    isPrefix = true;
-                    break;
-                }
+    // Память автодополнения по вкладке: собственный слой редактора и общий словарь
+    const QString path = m_editorToPath.value(editor);
+    QString info = tr("Автодополнение: %1 КБ (слова файла: %2)")
+        .arg(qMax<qint64>(1, editor->completionMemoryUsage() / 1024))
+        .arg(m_fileCompletionsCache.value(editor).size());
+    if (m_baseCompletionTrie) {
+        info += tr("\nОбщий словарь: %1 слов, %2 КБ")
+            .arg(m_baseCompletionTrie->size())
+            .arg(qMax<qint64>(1, m_baseCompletionTrie->memoryUsage() / 1024));
+    }
+    m_tabWidget->setTabToolTip(index, path.isEmpty() ? info : QDir::toNativeSeparators(path) + "\n" + info);
+}
+
+void MainWindow::requestBaseCompletions() {
+    if (!m_pythonEnvironment) {
+        m_pythonEnvironment = new PythonEnvironment(this);
+        connect(m_pythonEnvironment, &PythonEnvironment::completionsReady,
+                this, &MainWindow::onBaseCompletionsReady);
+    }
+    // Из дискового кэша ответ приходит сразу, иначе - после фоновой интроспекции
+    m_pythonEnvironment->requestCompletions(detectPythonExecutable());
+    
+    if (!m_pyrobTaskIndex) {
+        m_pyrobTaskIndex = new PyrobTaskIndex(this);
+        connect(m_pyrobTaskIndex, &PyrobTaskIndex::tasksChanged, this, &MainWindow::invalidateFileCompletions);
+    }
+    m_pyrobTaskIndex->setSearchPaths(pyrobSearchPaths());
+}
+
+QStringList MainWindow::pyrobSearchPaths() const {
+    // Каталоги sys.path интерпретатора (известны после интроспекции)
+    // и стандартные расположения site-packages встроенного Python
+    QStringList paths;
+    if (m_pythonEnvironment) {
+        paths = m_pythonEnvironment->sitePaths();
+    }
+    const QString pythonDir = QFileInfo(detectPythonExecutable()).absolutePath();
+    paths << QDir(pythonDir).filePath("Lib/site-packages")
+          << QDir(QCoreApplication::applicationDirPath()).filePath("python/Lib/site-packages");
+    paths.removeDuplicates();
+    return paths;
+}
+
+void MainWindow::invalidateFileCompletions() {
+    // Слова файлов пересчитываются при следующем обновлении
+    m_fileSymbolsRevision.clear();
+    if (currentEditor()) {
+        QTimer::singleShot(0, this, &MainWindow::updateCompletionFromDocument);
+    }
+}
+
+void MainWindow::ensureCompletionServer() {
+    if (!m_completionServer) {
+        m_completionServer = new CompletionServer(this);
+        m_completionServer->setScript(completionServerScript());
+        connect(m_completionServer, &CompletionServer::completionsReady,
+                this, &MainWindow::onSemanticCompletionsReady);
+        connect(m_completionServer, &CompletionServer::diagnosticsReady,
+                this, &MainWindow::onDiagnosticsReady);
+        connect(m_completionServer, &CompletionServer::requestFailed,
+                this, &MainWindow::onAnalysisRequestFailed);
+        connect(m_completionServer, &CompletionServer::started, this, [this]() {
+            // После перезапуска сервера подчеркивание ошибки текущей вкладки обновляется без правки
+            if (m_liveSyntaxCheckEnabled) {
+                m_syntaxCheckTimer->start();
             }
-            if (!isPrefix) {
-                fileWords.append(w);
+        });
+    }
+    QSettings settings;
+    m_semanticCompletionEnabled = settings.value(QString("%1/semanticCompletion").arg(SETTINGS_GROUP), true).toBool();
+    m_liveSyntaxCheckEnabled = settings.value(QString("%1/liveSyntaxCheck").arg(SETTINGS_GROUP), true).toBool();
+    m_completionServer->setPythonPath(detectPythonExecutable());
+    // Один процесс обслуживает и дополнение, и проверку синтаксиса
+    m_completionServer->setEnabled(m_semanticCompletionEnabled || m_liveSyntaxCheckEnabled);
+    
+    if (!m_liveSyntaxCheckEnabled) {
+        m_syntaxCheckTimer->stop();
+        m_syntaxCheckId = 0;
+        for (int i = 0; i < m_tabWidget->count(); ++i) {
+            if (CodeEditor *editor = getEditorFromWidget(m_tabWidget->widget(i))) {
+                editor->clearSyntaxError();
             }
         }
+    } else {
+        // Новый интерпретатор может по-другому понимать синтаксис - перепроверяем
+        m_syntaxCheckTimer->start();
     }
+}
+
+QString MainWindow::completionFileKey(CodeEditor *editor) const {
+    // Путь нужен серверу для модулей рядом с файлом; у несохраненных - условное имя
+    const QString path = m_editorToPath.value(editor);
+    return path.isEmpty() ? QString("untitled:%1").arg(quintptr(editor)) : path;
+}
+
+void MainWindow::requestSemanticCompletion(CodeEditor *editor) {
+    if (!m_completionServer || !m_semanticCompletionEnabled || !editor || editor->isLargeFile()) return;
+    
+    // Предыдущий запрос больше не нужен - сервер его пропустит
+    if (m_semanticRequestId > 0) {
+        m_completionServer->cancel(m_semanticRequestId);
+        m_semanticRequestId = 0;
+    }
+    int line = 0;
+    int column = 0;
+    if (!editor->semanticCompletionContext(&line, &column)) return;
+    
+    // Текст копируется, только если сервер еще не видел эту версию документа
+    QPointer<CodeEditor> editorPtr = editor;
+    m_semanticRequestId = m_completionServer->complete(
+        completionFileKey(editor), editor->symbolIndex()->modificationCount(),
+        [editorPtr]() { return editorPtr ? editorPtr->text() : QString(); },
+        line, column);
+    m_semanticRequestEditor = editor;
+}
+
+void MainWindow::onSemanticCompletionsReady(int id, const QJsonArray &items) {
+    if (id != m_semanticRequestId) return;
+    m_semanticRequestId = 0;
+    if (!m_semanticRequestEditor) return;
     
-    // Добавляем задачи pyrob в автокомплит только если курсор в контексте "def "
-    QStringList pyrobTasksForAPI;
-    if (isInDefContext) {
-        for (const QString &task : pyrobTasks) {
-            if (!task.isEmpty() && task.length() > 1) {
-                fileWords.append(task);
-                pyrobTasksForAPI.append(task); // Также добавляем в API для QScintilla автокомплита
-            }
+    QStringList words;
+    words.reserve(items.size());
+    for (const QJsonValue &item : items) {
+        words.append(item.toObject().value("name").toString());
+    }
+    m_semanticRequestEditor->setSemanticCompletions(words);
+}
+
+void MainWindow::requestSyntaxCheck() {
+    CodeEditor *editor = currentEditor();
+    // Большие файлы не отправляются серверу: передача и компиляция заняли бы секунды
+    if (!m_completionServer || !m_liveSyntaxCheckEnabled || !editor || editor->isLargeFile()) return;
+    
+    const quint64 version = editor->symbolIndex()->modificationCount();
+    if (m_syntaxCheckId > 0) {
+        // Эта версия уже проверяется - ждем ответа
+        if (m_syntaxCheckEditor == editor && m_syntaxCheckVersion == version) return;
+        // Более новая правка вытесняет прежнюю проверку
+        m_completionServer->cancel(m_syntaxCheckId);
+        m_syntaxCheckId = 0;
+    }
+    QPointer<CodeEditor> editorPtr = editor;
+    m_syntaxCheckId = m_completionServer->check(
+        completionFileKey(editor), version,
+        [editorPtr]() { return editorPtr ? editorPtr->text() : QString(); });
+    m_syntaxCheckEditor = editor;
+    m_syntaxCheckVersion = version;
+    m_syntaxCheckIsRetry = false;
+}
+
+void MainWindow::onDiagnosticsReady(int id, const QJsonArray &diagnostics) {
+    if (id != m_syntaxCheckId) return;
+    m_syntaxCheckId = 0;
+    CodeEditor *editor = m_syntaxCheckEditor;
+    // Ответ на уже измененный текст не показываем - таймер запросит новую проверку
+    if (!editor || !m_liveSyntaxCheckEnabled
+        || editor->symbolIndex()->modificationCount() != m_syntaxCheckVersion) {
+        return;
+    }
+    if (diagnostics.isEmpty()) {
+        editor->clearSyntaxError();
+        return;
+    }
+    const QJsonObject error = diagnostics.first().toObject();
+    const int line = error.value("line").toInt(1) - 1;
+    editor->setSyntaxError(line, error.value("column").toInt(),
+                           error.value("endLine").toInt(line + 1) - 1, error.value("endColumn").toInt(),
+                           error.value("message").toString());
+}
+
+void MainWindow::onAnalysisRequestFailed(int id) {
+    // Ответа не будет - иначе ожидание этого запроса блокировало бы следующие
+    if (id == m_semanticRequestId) {
+        m_semanticRequestId = 0;
+    }
+    if (id == m_syntaxCheckId) {
+        m_syntaxCheckId = 0;
+        // Один повтор: после "stale" сервер получит текст заново; повторная ошибка ждет следующей правки
+        if (!m_syntaxCheckIsRetry) {
+            requestSyntaxCheck();
+            m_syntaxCheckIsRetry = true;
         }
     }
+}
+
+void MainWindow::onBaseCompletionsReady(const QStringList &completions, bool fromCache) {
+    Q_UNUSED(fromCache);
+    m_cachedBaseCompletions = completions;
+    m_cachedBaseCompletionsSet = QSet<QString>::fromList(m_cachedBaseCompletions);
     
-    // Обновляем кэш для этого редактора
-    m_fileCompletionsCache[editor] = fileWords;
-    // Сохраняем хеш содержимого файла
-    m_fileContentHash[editor] = cacheKey;
-    
-    // Обновляем API лексера для встроенного автокомплита QScintilla
-    // Всегда добавляем задачи pyrob в API
-    if (editor) {
-        QsciLexer *lexer = editor->lexer();
-        if (lexer) {
-            // Используем QTimer для отложенного вызова, чтобы убедиться, что лексер полностью инициализирован
-            // Используем QPointer для безопасной проверки, что редактор еще существует
-            QPointer<CodeEditor> editorPtr = editor;
-            QTimer::singleShot(50, this, [editorPtr, pyrobTasksForAPI]() {
-                if (editorPtr && editorPtr->lexer()) {
-                    try {
-                        editorPtr->updateAPIs(pyrobTasksForAPI);
-                    } catch (...) {
-                        // Игнорируем ошибки при обновлении API
-                    }
-                }
-            });
+    // Одно дерево на интерпретатор, общее для всех вкладок
+    m_baseCompletionTrie = std::make_shared<const CompletionTrie>(m_cachedBaseCompletions);
+    if (m_tabWidget) {
+        for (int i = 0; i < m_tabWidget->count(); ++i) {
+            if (CodeEditor *editor = getEditorFromTabWidget(i)) {
+                editor->setCompletionBase(m_baseCompletionTrie);
+            }
         }
     }
-    
-    // Объединяем базовые слова (из кэша) и слова из файла
-    // Используем QSet напрямую для избежания промежуточных списков
-    QSet<QString> allSet = m_cachedBaseCompletionsSet;
-    for (const QString &word : fileWords) {
-        allSet.insert(word);
+    if (m_sharedBaseCompletionsModel) {
+        m_sharedBaseCompletionsModel->setStringList(m_cachedBaseCompletions);
     }
     
-    // Преобразуем в отсортированный список
-    QStringList all = QStringList::fromSet(allSet);
-    all.sort(Qt::CaseInsensitive);
-    
-    // Обновляем модель completer для этого редактора (на случай, если используется QCompleter)
-    auto *model = m_editorCompletionsModels.value(editor);
-    if (model) {
-        model->setStringList(all);
+    if (m_pyrobTaskIndex) {
+        m_pyrobTaskIndex->setSearchPaths(pyrobSearchPaths());
     }
-}
-
-QStringList MainWindow::loadPythonCompletions() {
-    QStringList result;
     
-    // Пытаемся получить путь к Python
-    const QString python = detectPythonExecutable();
-    if (python.isEmpty() || !QFile::exists(python)) {
-        return result; // Возвращаем пустой список, будет использован fallback
-    }
-    
-    // Создаем временный Python скрипт для получения списка команд
-    QString script = 
-        "import keyword\n"
-        "import sys\n"
-        "import pkgutil\n"
-        "\n"
-        "result = []\n"
-        "\n"
-        "# Ключевые слова Python\n"
-        "result.extend(keyword.kwlist)\n"
-        "\n"
-        "# Встроенные функции и объекты\n"
-        "builtins_list = dir(__builtins__)\n"
-        "for item in builtins_list:\n"
-        "    if not item.startswith('_'):\n"
-        "        result.append(item)\n"
-        "    elif item in ['__debug__', '__import__']:\n"
-        "        result.append(item)\n"
-        "\n"
-        "# Константы\n"
-        "result.extend(['Ellipsis', 'NotImplemented', '__debug__'])\n"
-        "\n"
-        "# Исключения из __builtins__\n"
-        "exceptions = [name for name in dir(__builtins__) if isinstance(getattr(__builtins__, name, None), type) and issubclass(getattr(__builtins__, name, None), BaseException) if hasattr(__builtins__, name)]\n"
-        "try:\n"
-        "    exceptions = [name for name in dir(__builtins__) if name[0].isupper()]\n"
-        "    for exc in exceptions:\n"
-        "        obj = getattr(__builtins__, exc, None)\n"
-        "        if isinstance(obj, type) and issubclass(obj, BaseException):\n"
-        "            result.append(exc)\n"
-        "except:\n"
-        "    pass\n"
-        "\n"
-        "# Модули стандартной библиотеки\n"
-        "try:\n"
-        "    for importer, modname, ispkg in pkgutil.iter_modules():\n"
-        "        if not modname.startswith('_') and '.' not in modname:\n"
-        "            result.append(modname)\n"
-        "except:\n"
-        "    # Если не удалось загрузить модули, используем популярные\n"
-        "    stdlib_modules = ['sys', 'os', 'json', 'datetime', 'time', 'random', 'math', 're', 'collections',\n"
-        "                     'itertools', 'functools', 'operator', 'pathlib', 'urllib', 'socket', 'threading',\n"
-        "                     'multiprocessing', 'subprocess', 'sqlite3', 'csv', 'pickle', 'hashlib', 'base64']\n"
-        "    result.extend(stdlib_modules)\n"
-        "\n"
-        "# Pyrob API\n"
-        "try:\n"
-        "    import pyrob.api\n"
-        "    pyrob_items = dir(pyrob.api)\n"
-        "    for item in pyrob_items:\n"
-        "        if not item.startswith('_'):\n"
-        "            result.append(item)\n"
-        "    # Также добавляем task и run_tasks из pyrob\n"
-        "    try:\n"
-        "        import pyrob\n"
-        "        if hasattr(pyrob, 'task'):\n"
-        "            result.append('task')\n"
-        "        if hasattr(pyrob, 'run_tasks'):\n"
-        "            result.append('run_tasks')\n"
-        "    except:\n"
-        "        pass\n"
-        "except ImportError:\n"
-        "    # Pyrob не установлен, используем базовый список\n"
-        "    pyrob_api = ['move_left', 'move_right', 'move_up', 'move_down', 'wall_is_above', 'wall_is_beneath',\n"
-        "                 'wall_is_on_the_left', 'wall_is_on_the_right', 'fill_cell', 'cell_is_filled', 'mov',\n"
-        "                 'task', 'run_tasks']\n"
-        "    result.extend(pyrob_api)\n"
-        "\n"
-        "# Удаляем дубликаты и сортируем\n"
-        "result = sorted(set(result))\n"
-        "\n"
-        "# Выводим результат, разделенный запятыми\n"
-        "print(','.join(result))\n";
-    
-    // Запускаем Python скрипт
-    QProcess process;
-    process.setProgram(python);
-    process.setArguments(QStringList() << "-c" << script);
-    process.setProcessChannelMode(QProcess::SeparateChannels);
-    
-    process.start();
-    if (!process.waitForFinished(5000)) { // Таймаут 5 секунд
-        process.kill();
-        return result; // Возвращаем пустой список при ошибке
-    }
-    
-    // Читаем вывод
-    QByteArray output = process.readAllStandardOutput();
-    QString outputStr = QString::fromUtf8(output).trimmed();
-    
-    if (!outputStr.isEmpty()) {
-        result = outputStr.split(',', QString::SkipEmptyParts);
-        // Очищаем от лишних пробелов
-        for (QString &item : result) {
-            item = item.trimmed();
-        }
-        // Удаляем пустые элементы
-        result.removeAll(QString());
-    }
-    
-    return result;
-}
-
-QStringList MainWindow::loadPyrobTasks() {
-    QStringList result;
-    
-    // Пытаемся получить путь к Python
-    const QString python = detectPythonExecutable();
-    if (python.isEmpty() || !QFile::exists(python)) {
-        return result; // Возвращаем пустой список, если Python не найден
-    }
-    
-    // Создаем Python скрипт для получения списка задач из папки pyrob/tasks
-    QString script =
-        "import os\n"
-        "import sys\n"
-        "\n"
-        "tasks = []\n"
-        "\n"
-        "# Пытаемся импортировать pyrob и найти папку tasks\n"
-        "try:\n"
-        "    import pyrob\n"
-        "    pyrob_path = pyrob.__file__\n"
-        "    pyrob_dir = os.path.dirname(pyrob_path)\n"
-        "    tasks_dir = os.path.join(pyrob_dir, 'tasks')\n"
-        "except ImportError:\n"
-        "    # Если pyrob не найден через импорт, пробуем стандартные пути\n"
-        "    python_dir = os.path.dirname(sys.executable)\n"
-        "    # Пробуем путь для встроенного Python\n"
-        "    tasks_dir = os.path.join(python_dir, 'Lib', 'site-packages', 'pyrob', 'tasks')\n"
-        "    if not os.path.exists(tasks_dir):\n"
-        "        # Пробуем путь относительно executable\n"
-        "        app_dir = os.path.dirname(os.path.dirname(python_dir))\n"
-        "        tasks_dir = os.path.join(app_dir, 'python', 'Lib', 'site-packages', 'pyrob', 'tasks')\n"
-        "\n"
-        "# Получаем список .py файлов из папки tasks\n"
-        "if os.path.exists(tasks_dir):\n"
-        "    for filename in os.listdir(tasks_dir):\n"
-        "        if filename.endswith('.py') and filename != '__init__.py':\n"
-        "            # Убираем расширение .py\n"
-        "            task_name = filename[:-3]\n"
-        "            tasks.append(task_name)\n"
-        "\n"
-        "# Выводим результат, разделенный запятыми\n"
-        "print(','.join(sorted(tasks)))\n";
-    
-    // Запускаем Python скрипт
-    QProcess process;
-    process.setProgram(python);
-    process.setArguments(QStringList() << "-c" << script);
-    process.setProcessChannelMode(QProcess::SeparateChannels);
-    
-    process.start();
-    if (!process.waitForFinished(5000)) { // Таймаут 5 секунд
-        process.kill();
-        return result; // Возвращаем пустой список при ошибке
-    }
-    
-    // Читаем вывод
-    QByteArray output = process.readAllStandardOutput();
-    QString outputStr = QString::fromUtf8(output).trimmed();
-    
-    if (!outputStr.isEmpty()) {
-        result = outputStr.split(',', QString::SkipEmptyParts);
-        // Очищаем от лишних пробелов
-        for (QString &item : result) {
-            item = item.trimmed();
-        }
-        // Удаляем пустые элементы
-        result.removeAll(QString());
-    }
-    
-    return result;
+    // Слова файлов фильтровались по старому списку
+    invalidateFileCompletions();
 }
 
 void MainWindow::setupEditorCompletions(CodeEditor *editor, QStringListModel *baseModel) {
@@ -3688,9 +3688,9 @@ void MainWindow::ensureReplDock() {
     QWidget *replWidget = new QWidget(m_replDock);
     auto *replLayout = new QVBoxLayout(replWidget);
     replLayout->setContentsMargins(4,4,4,4);
-    m_replOutput = new QTextBrowser(replWidget);
-    m_replOutput->setOpenLinks(false);
-    connect(m_replOutput, &QTextBrowser::anchorClicked, this, &MainWindow::onReplAnchorClicked);
+    m_replOutput = new OutputView(replWidget);
+    m_replOutput->setTheme(m_currentTheme);
+    connect(m_replOutput, &OutputView::linkActivated, this, &MainWindow::openFileAt);
     m_replInput = new QTextEdit(replWidget);
     m_replInput->setPlaceholderText(tr("Введите код. Ctrl+Enter — выполнить, Shift+Enter — новая строка"));
     m_replInput->installEventFilter(this);
@@ -3702,6 +3702,29 @@ void MainWindow::ensureReplDock() {
     m_replDock->hide();
 }
 
+void MainWindow::ensureDebugDock() {
+    if (m_debugDock)
+        return;
+    m_debugDock = new QDockWidget(tr("Отладка"), this);
+    m_debugDock->setObjectName("DebugDock");
+    m_debugPanel = new DebugPanel(m_debugDock);
+    connect(m_debugPanel, &DebugPanel::expandRequested, this, [this](int ref) {
+        QJsonObject arguments;
+        arguments.insert("ref", ref);
+        sendDebugCommand("expand", arguments);
+    });
+    connect(m_debugPanel, &DebugPanel::frameSelected, this, [this](int index, const QString &path, int line) {
+        QJsonObject arguments;
+        arguments.insert("frame", index);
+        sendDebugCommand("locals", arguments);
+        openFileAt(path, line);
+    });
+    m_debugDock->setWidget(m_debugPanel);
+    addDockWidget(Qt::BottomDockWidgetArea, m_debugDock);
+    tabifyDockWidget(m_outputDock, m_debugDock);
+    m_debugDock->hide();
+}
+
 void MainWindow::ensureProjectDock() {
     if (m_projectDock)
         return;
@@ -4099,6 +4122,14 @@ void MainWindow::applyTheme(const QString &theme) {
         }
     }
     
+    // Обновляем тему панели вывода
+    if (m_output) {
+        m_output->setTheme(theme);
+    }
+    if (m_replOutput) {
+        m_replOutput->setTheme(theme);
+    }
+    
     // Обновляем тему справки
     if (m_helpWidget) {
         m_helpWidget->setTheme(theme);
@@ -4116,21 +4147,45 @@ void MainWindow::applyTheme(const QString &theme) {
 }
 
 void MainWindow::closeEvent(QCloseEvent *event) {
+    // Ответы "Не сохранять" действуют только для повтора после сохранения в диалоге;
+    // новое закрытие (в том числе после отмены) снова спрашивает обо всех вкладках
+    if (!m_closeRetry) {
+        m_closeDiscarded.clear();
+    }
+    m_closeRetry = false;
+    
     // Проверяем наличие несохраненных изменений во всех вкладках
     if (m_tabWidget) {
         for (int i = 0; i < m_tabWidget->count(); ++i) {
             CodeEditor *editor = getEditorFromTabWidget(i);
-            if (editor && editor->document()->isModified()) {
+            if (editor && editor->document()->isModified() && !m_closeDiscarded.contains(editor)) {
                 // Переключаемся на вкладку с изменениями
                 m_tabWidget->setCurrentIndex(i);
-                if (!maybeSave()) {
+                // Если путь выбирается в диалоге, окно закрывается повторно после сохранения
+                // (из очереди событий: вложенный close() во время closeEvent ничего не делает)
+                if (!maybeSave([this]() {
+                        QTimer::singleShot(0, this, [this]() {
+                            m_closeRetry = true;
+                            close();
+                        });
+                    })) {
                     event->ignore();
                     return;
                 }
+                // Изменения остались - выбрано "Не сохранять"
+                if (editor->document()->isModified()) {
+                    m_closeDiscarded.append(editor);
+                }
             }
         }
     }
     
+    // Снимок сеанса - синхронно, пока вкладки еще на месте
+    if (m_sessionReady) {
+        m_sessionSaveTimer->stop();
+        m_sessionStore->saveNow(currentSession());
+    }
+    
     // Завершаем все процессы терминалов
 #ifdef _WIN32
     for (QProcess *terminalProcess : m_terminalProcesses) {
@@ -4221,6 +4276,22 @@ void MainWindow::openSettings() {
             if (m_console) {
                 m_console->setPythonPath(python);
             }
+            // Прогретые интерпретаторы перезапускаются с новым путем
+            if (m_workerPool) {
+                ensureWorkerPool();
+            }
+            // Дополнения нового интерпретатора (из кэша или фоновой интроспекции)
+            requestBaseCompletions();
+            ensureCompletionServer();
+        });
+        connect(m_settingsWidget, &SettingsWidget::fastRunChanged, this, [this]() {
+            ensureWorkerPool();
+        });
+        connect(m_settingsWidget, &SettingsWidget::semanticCompletionChanged, this, [this]() {
+            ensureCompletionServer();
+        });
+        connect(m_settingsWidget, &SettingsWidget::liveSyntaxCheckChanged, this, [this]() {
+            ensureCompletionServer();
         });
         connect(m_settingsWidget, &SettingsWidget::showStatusMessage, this,
                 [this](const QString &message, int timeoutMs) {
@@ -4841,163 +4912,33 @@ void MainWindow::animateTabSwitch(int fromIndex, int toIndex, std::function<void
     toAnimation->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
-void MainWindow::parseErrorAndHighlight(const QString &errorText) {
+void MainWindow::parseErrorAndHighlight(const QVector<TracebackFrame> &frames) {
     if (m_runningFilePath.isEmpty()) {
         return;
     }
     
-    
-    // Ищем паттерн: File "path", line N
-    // Может быть несколько вариантов:
-    //   File "path", line N, in <module>
-    //   File "path", line N, in function
-    QRegularExpression rx(R"(File\s+["']([^"']+)["'],\s+line\s+(\d+))");
-    QRegularExpressionMatchIterator it = rx.globalMatch(errorText);
-    
     QList<int> errorLines;
     QFileInfo runningFile(m_runningFilePath);
     QString runningFileName = runningFile.fileName();
     QString runningAbsolutePath = runningFile.absoluteFilePath();
     
     // Собираем все строки, которые соответствуют выполняемому файлу
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString filePath = match.captured(1);
-        int lineNumber = match.captured(2).toInt();
-        
+    for (const TracebackFrame &frame : frames) {
         // Нормализуем пути для сравнения
-        QFileInfo errorFile(filePath);
+        QFileInfo errorFile(frame.path);
         QString errorAbsolutePath = errorFile.absoluteFilePath();
         QString errorFileName = errorFile.fileName();
         
         // Сравниваем абсолютные пути или имена файлов
         if (QFileInfo(runningAbsolutePath) == QFileInfo(errorAbsolutePath) ||
             runningFileName == errorFileName) {
-            int lineIndex = lineNumber - 1; // Нумерация строк в QTextDocument начинается с 0
+            int lineIndex = frame.line - 1; // Нумерация строк в QScintilla начинается с 0
             if (!errorLines.contains(lineIndex)) {
                 errorLines.append(lineIndex);
             }
         }
     }
     
-    // Если не нашли строки в traceback, пытаемся найти их по типу ошибки и анализу кода
-    if (errorLines.isEmpty()) {
-        CodeEditor *editor = currentEditor();
-        if (editor) {
-            QString editorPath = m_editorToPath.value(editor, QString());
-            QFileInfo editorFile(editorPath);
-            
-            // Проверяем, что это тот же файл
-            if (editorFile.absoluteFilePath() == runningAbsolutePath ||
-                editorFile.fileName() == runningFileName) {
-                
-                QString code = editor->toPlainText();
-                QStringList lines = code.split('\n');
-                
-                // Анализируем ошибки и ищем соответствующие строки в коде
-                // FileNotFoundError - ищем open() или похожие операции с файлами
-                if (errorText.contains("FileNotFoundError") || errorText.contains("No such file or directory")) {
-                    // Сначала ищем строки с open() внутри функций
-                    for (int i = 0; i < lines.size(); ++i) {
-                        QString line = lines[i].trimmed();
-                        // Ищем строки с open() или read_config_file() и т.д.
-                        if (line.contains("open(") || line.contains("read_config_file(") || 
-                            line.contains("with open(")) {
-                            // Проверяем, что это не комментарий
-                            if (!line.startsWith("#")) {
-                                errorLines.append(i);
-                            }
-                        }
-                    }
-                    // Если не нашли, ищем вызовы функций, которые могут вызывать open()
-                    if (errorLines.isEmpty()) {
-                        for (int i = 0; i < lines.size(); ++i) {
-                            QString line = lines[i].trimmed();
-                            // Ищем вызовы функций, которые могут работать с файлами
-                            if ((line.contains("read_config_file(") || line.contains("config_file(") ||
-                                 line.contains("read_file(") || line.contains("load_file(")) &&
-                                !line.startsWith("#")) {
-                                errorLines.append(i);
-                            }
-                        }
-                    }
-                }
-                
-                // IndexError - ищем обращения к спискам/массивам
-                if (errorText.contains("IndexError") || errorText.contains("list index out of range") ||
-                    errorText.contains("index out of range")) {
-                    for (int i = 0; i < lines.size(); ++i) {
-                        QString line = lines[i].trimmed();
-                        if (line.startsWith("#")) continue;
-                        
-                        // Ищем строки с обращением к элементам списка более точно
-                        // lines[0], lines[1], lines[2] и т.д.
-                        QRegularExpression indexRx(R"(\w+\[\s*\d+\s*\])");
-                        if (indexRx.match(line).hasMatch()) {
-                            if (!errorLines.contains(i)) {
-                                errorLines.append(i);
-                            }
-                        }
-                        // Также ищем прямые обращения к lines[0], lines[1], lines[2]
-                        if (line.contains("lines[0]") || line.contains("lines[1]") || 
-                            line.contains("lines[2]")) {
-                            if (!errorLines.contains(i)) {
-                                errorLines.append(i);
-                            }
-                        }
-                    }
-                }
-                
-                // KeyError - ищем обращения к словарям
-                if (errorText.contains("KeyError")) {
-                    for (int i = 0; i < lines.size(); ++i) {
-                        QString line = lines[i].trimmed();
-                        if (!line.startsWith("#") && line.contains("['") && line.contains("']")) {
-                            errorLines.append(i);
-                        }
-                    }
-                }
-                
-                // ZeroDivisionError - ищем деление
-                if (errorText.contains("ZeroDivisionError") || errorText.contains("division by zero")) {
-                    for (int i = 0; i < lines.size(); ++i) {
-                        QString line = lines[i].trimmed();
-                        if (line.startsWith("#")) continue;
-                        
-                        // Ищем строки с делением, особенно деление на len()
-                        if ((line.contains(" / ") || line.contains("/")) && 
-                            (line.contains("len(") || line.contains("/ 0") || line.contains("/0"))) {
-                            if (!errorLines.contains(i)) {
-                                errorLines.append(i);
-                            }
-                        }
-                        // Также ищем паттерн sum(...) / len(...)
-                        if (line.contains("sum(") && line.contains("/") && line.contains("len(")) {
-                            if (!errorLines.contains(i)) {
-                                errorLines.append(i);
-                            }
-                        }
-                    }
-                }
-                
-                // TypeError - ищем операции с неправильными типами
-                if (errorText.contains("TypeError")) {
-                    for (int i = 0; i < lines.size(); ++i) {
-                        QString line = lines[i].trimmed();
-                        if (line.startsWith("#")) continue;
-                        
-                        // Ищем строки с sum(), которые могут вызвать TypeError
-                        if (line.contains("sum(") && !line.contains("int(") && !line.contains("float(")) {
-                            if (!errorLines.contains(i)) {
-                                errorLines.append(i);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-    
     // Подсвечиваем все строки с ошибками в текущем редакторе
     if (!errorLines.isEmpty()) {
         CodeEditor *editor = currentEditor();
@@ -5028,11 +4969,8 @@ void MainWindow::toggleOutputMode() {
             
             // Подключаем сигналы для парсинга ошибок из консоли
             connect(m_console, &ConsoleWidget::outputReceived, this, [this](const QString &text, bool isError) {
-                if (isError) {
-                    m_stderrBuffer += text;
-                } else {
-                    m_stdoutBuffer += text;
-                }
+                Q_UNUSED(isError);
+                m_consoleTraceback.feed(text);
             });
             
             connect(m_console, &ConsoleWidget::commandFinished, this, [this](int exitCode) {
@@ -5157,52 +5095,29 @@ void MainWindow::applySnapOnRelease() {
 #endif
 }
 
-void MainWindow::setupLocalServer()
-{
-    // Создаем локальный сервер для единого экземпляра приложения
-    QString serverName = "VuzhykIDE_SingleInstance";
-    m_localServer = new QLocalServer(this);
-    
-    // Удаляем старый сервер, если он существует
-    QLocalServer::removeServer(serverName);
-    
-    // Пытаемся запустить сервер
-    if (m_localServer->listen(serverName)) {
-        connect(m_localServer, &QLocalServer::newConnection, this, &MainWindow::onNewConnection);
+void MainWindow::handleInstanceRequest(const InstanceRequest &request) {
+    // Сначала окно - вкладки открываются лениво и не задерживают его появление
+    show();
+    setWindowState((windowState() & ~Qt::WindowMinimized) | Qt::WindowActive);
+    raise();
+    activateWindow();
+    if (request.action == QLatin1String("open")) {
+        openInstanceFiles(request.files);
     }
 }
 
-void MainWindow::onNewConnection()
-{
-    // Обрабатываем новое подключение от другого экземпляра
-    QLocalSocket *socket = m_localServer->nextPendingConnection();
-    if (!socket) return;
-    
-    connect(socket, &QLocalSocket::readyRead, this, &MainWindow::readSocketData);
-    connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
-}
-
-void MainWindow::readSocketData()
-{
-    // Читаем данные из сокета (пути к файлам для открытия)
-    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
-    if (!socket) return;
-    
-    QByteArray data = socket->readAll();
-    QStringList filePaths = QString::fromUtf8(data).split('\n', QString::SkipEmptyParts);
-    
-    // Открываем файлы
-    for (const QString &filePath : filePaths) {
-        QString cleanPath = filePath.trimmed();
-        if (!cleanPath.isEmpty()) {
-            openFileFromPath(cleanPath);
+void MainWindow::openInstanceFiles(const QVector<InstanceFile> &files) {
+    for (const InstanceFile &file : files) {
+        // Уже открытый файл только активируется
+        const int existingTab = findTabByPath(file.path);
+        if (existingTab >= 0) {
+            m_tabWidget->setCurrentIndex(existingTab);
+        } else {
+            openFileFromPath(file.path);
+        }
+        if (file.line > 0) {
+            openFileAt(file.path, file.line);
         }
     }
-    
-    // Активируем окно
-    raise();
-    activateWindow();
-    show();
-    setWindowState((windowState() & ~Qt::WindowMinimized) | Qt::WindowActive);
 }
 
@@ -17,8 +17,13 @@
 #include <QMap>
 #include <QTimer>
 #include <functional>
-#include <QLocalServer>
-#include <QLocalSocket>
+#include <memory>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "SessionStore.h"
+#include "SingleInstance.h"
+#include "TracebackParser.h"
 
 class CodeEditor;
 class TitleBar;
@@ -28,6 +33,16 @@ class HelpWidget;
 class PyrobEditorWidget;
 class SnakeGame;
 class ConsoleWidget;
+class OutputView;
+class ProcessOutputPump;
+class RunnerChannel;
+class PythonWorkerPool;
+class DebugPanel;
+class PythonEnvironment;
+class PyrobTaskIndex;
+class CompletionTrie;
+class CompletionServer;
+class FilePickerService;
 class QStringListModel;
 class QPropertyAnimation;
 
@@ -36,6 +51,11 @@ class MainWindow : public QMainWindow {
 public:
     explicit MainWindow(const QString &theme = QString(), QWidget *parent = nullptr);
     void openFileFromPath(const QString &path);
+    // Восстановление прошлого сеанса: активная вкладка открывается сразу,
+    // остальные добавляются после первой отрисовки окна (finishStartup)
+    void restoreSession();
+    void openInstanceFiles(const QVector<InstanceFile> &files); // Файлы из командной строки
+    void handleInstanceRequest(const InstanceRequest &request); // Запрос от другого запуска IDE
 
 private slots:
     void newFile();
@@ -49,7 +69,9 @@ private slots:
     void runScriptInTerminal();
     void terminateRun();
     void continueDebug();
-    void checkDebugSyncFile();
+    void stepOverDebug();
+    void stepIntoDebug();
+    void stepOutDebug();
     void onOutputInputReturnPressed();
     void choosePython();
     void toggleRepl(bool enabled);
@@ -60,16 +82,16 @@ private slots:
     void sendReplInput();
 
     void onProcessStarted();
-    void onProcessStdout();
-    void onProcessStderr();
+    void onProcessOutput(const QString &text, bool isError);
+    void onOutputStatsUpdated(qint64 bytesPerSecond, qint64 droppedLines);
+    void onRunnerMessage(const QJsonObject &message);
+    void onFirstOutput(qint64 latencyMs);
     void onProcessFinished(int exitCode, QProcess::ExitStatus status);
 
     void onReplStarted();
     void onReplStdout();
     void onReplStderr();
     void onReplFinished(int exitCode, QProcess::ExitStatus status);
-    void onOutputAnchorClicked(const QUrl &url);
-    void onReplAnchorClicked(const QUrl &url);
     void onFsDoubleClicked(const QModelIndex &index);
     void onTabCloseRequested(int index);
     void onTabChanged(int index);
@@ -82,18 +104,23 @@ private slots:
     void openPyrobEditor();
     void openSnakeGame();
 
-private slots:
-    void onNewConnection();
-    void readSocketData();
-
 private:
     void setupUi();
     void setupActions();
     void setupConnections();
-    void setupLocalServer();
-    bool maybeSave();
-    bool saveToPath(const QString &path);
-    void loadFromPath(const QString &path);
+    QString showFallbackFileDialog(const QString &filter, const QString &initialDir, bool isSave, bool isDirectory);
+    void ensureWorkerPool();
+    void sendDebugCommand(const QString &command, const QJsonObject &arguments = QJsonObject());
+    void resumeDebug(const QString &command, const QString &stepMode = QString());
+    void onDebugBreak(const QJsonObject &message);
+    void clearDebugLine();
+    // true - действие можно продолжать. Если для сохранения нужно выбрать путь, выбор идет
+    // асинхронно: возвращается false, а после успешного сохранения вызывается retry
+    bool maybeSave(const std::function<void()> &retry);
+    bool saveToPath(const QString &path, CodeEditor *editor = nullptr); // По умолчанию - текущий редактор
+    void saveEditorAs(CodeEditor *editor, std::function<void()> onSaved = {});
+    // activate = false - вкладка добавляется в фоне, редактор создается при первом показе
+    void loadFromPath(const QString &path, bool activate = true);
     QString detectPythonExecutable() const;
     QString embeddedPythonPath() const;
     QString configuredPythonPath() const;
@@ -107,10 +134,21 @@ private:
     void keyPressEvent(QKeyEvent *event) override;
     void openFileAt(const QString &path, int line);
     void updateCompletionFromDocument();
-    QStringList loadPythonCompletions();
-    QStringList loadPyrobTasks();
+    void updateTabCompletionInfo(CodeEditor *editor); // Подсказка вкладки с памятью автодополнения
+    void requestBaseCompletions();
+    void onBaseCompletionsReady(const QStringList &completions, bool fromCache);
+    QStringList pyrobSearchPaths() const;
+    void invalidateFileCompletions();
+    void ensureCompletionServer();
+    void requestSemanticCompletion(CodeEditor *editor);
+    void onSemanticCompletionsReady(int id, const QJsonArray &items);
+    void requestSyntaxCheck();
+    void onDiagnosticsReady(int id, const QJsonArray &diagnostics);
+    void onAnalysisRequestFailed(int id);
+    QString completionFileKey(CodeEditor *editor) const;
     void setupEditorCompletions(CodeEditor *editor, QStringListModel *baseModel);
     void ensureReplDock();
+    void ensureDebugDock();
     void ensureProjectDock();
     bool nativeEvent(const QByteArray &eventType, void *message, long *result) override;
     void resizeEvent(QResizeEvent *event) override;
@@ -128,6 +166,26 @@ private:
     CodeEditor *getEditorFromWidget(QWidget *widget) const;
     void updateTabText(CodeEditor *editor);
     int findTabByPath(const QString &path) const;
+    
+    // Ленивые вкладки: до первого показа (или после выгрузки) вкладка хранит только путь
+    struct LazyTab {
+        QString path;
+        int line { -1 };            // Позиция курсора и прокрутки выгруженного редактора
+        int index { 0 };
+        int firstVisibleLine { 0 };
+        QList<int> breakpoints;     // Из сохраненного сеанса
+    };
+    QWidget *createTabContainer();
+    int addLazyTab(const LazyTab &tab, int position = -1); // position -1 - в конец
+    CodeEditor *materializeTab(QWidget *container); // nullptr - файл не открылся или нет места
+    bool canEvictTab(QWidget *container) const;
+    void evictTab(QWidget *container);
+    void evictIdleTabs();
+    bool ensureEditorCapacity(QWidget *keep); // Выгружает старые редакторы сверх лимита
+    void forgetEditor(CodeEditor *editor);    // Убирает редактор из карт MainWindow
+    Session currentSession() const;
+    void scheduleSessionSave();
+    void finishStartup();
     void setupEditor(CodeEditor *editor);
     void updateWindowTitle();
     void applyFontSizeToAllEditors(int size);
@@ -135,10 +193,12 @@ private:
     void loadShortcutsFromSettings();
     void animateTabOpening(QWidget *widget, int tabIndex);
     void animateTabSwitch(int fromIndex, int toIndex, std::function<void()> onFinished = {});
-    void parseErrorAndHighlight(const QString &errorText);
+    void parseErrorAndHighlight(const QVector<TracebackFrame> &frames);
     
 public:
-    QString showFilePicker(const QString &filter, const QString &initialDir = QString(), bool isSave = false, bool isDirectory = false);
+    // Асинхронный выбор: onPicked вызывается с путем (пустым при отмене) после закрытия диалога
+    void pickFile(const QString &filter, const QString &initialDir, bool isSave, bool isDirectory,
+                  std::function<void(const QString &)> onPicked);
     QString pythonPath() const; // Возвращает путь к текущему интерпретатору Python
 
 private:
@@ -155,26 +215,28 @@ private:
     SnakeGame *m_snakeGame { nullptr };
     QWidget *m_snakeGameContainer { nullptr };
     int m_snakeGameTabIndex { -1 }; // Индекс вкладки игры
-    QTextBrowser *m_output {nullptr};
+    OutputView *m_output {nullptr}; // Панель вывода программы
     QLineEdit *m_outputInput {nullptr}; // Поле ввода для input()
     ConsoleWidget *m_console {nullptr};
     QStackedWidget *m_outputStack {nullptr};
     QDockWidget *m_outputDock {nullptr};
     bool m_outputModeIsConsole {false}; // false = вывод, true = консоль
     bool m_scriptRunningInConsole {false}; // Флаг: скрипт запущен в консоли или через QProcess
-    QTextBrowser *m_replOutput {nullptr};
+    OutputView *m_replOutput {nullptr};
     QTextEdit *m_replInput {nullptr};
     QPointer<QProcess> m_process;
+    QPointer<ProcessOutputPump> m_outputPump; // Пакетное чтение вывода m_process
     QPointer<QProcess> m_replProcess;
     QList<QProcess*> m_terminalProcesses; // Список процессов терминалов для завершения при закрытии IDE
     QString m_runningFilePath; // Путь к файлу, который выполняется
-    QString m_stderrBuffer; // Буфер для накопления stderr
-    QString m_stdoutBuffer; // Буфер для накопления stdout
+    QPointer<RunnerChannel> m_runnerChannel; // Служебный канал обертки запуска
+    bool m_exceptionReported { false }; // Обертка уже прислала запись об исключении
+    PythonWorkerPool *m_workerPool { nullptr }; // Прогретые интерпретаторы для быстрого запуска
+    bool m_runUsesWarmWorker { false }; // Текущий запуск выполняется прогретым интерпретатором
+    TracebackParser m_consoleTraceback; // Распознавание трассировки при запуске в консоли
     bool m_isDebugging { false }; // Флаг отладки
     int m_currentBreakpointLine { -1 }; // Текущая строка с точкой останова
     QSet<int> m_debugBreakpoints; // Точки останова для отладки
-    QString m_debugSyncFile; // Файл для синхронизации отладки
-    QTimer *m_debugTimer { nullptr }; // Таймер для проверки файла синхронизации
     bool m_hotkeyRegistered { false }; // Флаг регистрации глобального хоткея F9
     bool m_terminateHotkeyRegistered { false }; // Флаг регистрации глобального хоткея Shift+F5
     static const int HOTKEY_ID = 1; // ID для глобального хоткея F9
@@ -185,6 +247,8 @@ private:
     QTreeView *m_fsView { nullptr };
     QDockWidget *m_replDock { nullptr };
     QDockWidget *m_projectDock { nullptr };
+    QDockWidget *m_debugDock { nullptr };
+    DebugPanel *m_debugPanel { nullptr }; // Переменные и стек вызовов при останове
     QMenuBar *m_menuBar { nullptr };
     TitleBar *m_titleBar { nullptr };
     WindowFrameOverlay *m_frameOverlay { nullptr };
@@ -195,13 +259,38 @@ private:
     bool m_animationsEnabled { true }; // Флаг включения анимаций (можно отключить для экономии памяти)
     int m_tabSwitchCount { 0 }; // Счетчик переключений вкладок для периодической очистки кэшей
     QStringList m_cachedBaseCompletions; // Кэш базовых дополнений (один для всех файлов)
-    QSet<QString> m_cachedBaseCompletionsSet; // QSet для быстрой проверки префиксов
+    QSet<QString> m_cachedBaseCompletionsSet; // QSet для объединения со словами файла
+    std::shared_ptr<const CompletionTrie> m_baseCompletionTrie; // Базовые дополнения, общие для всех редакторов
     QStringListModel *m_sharedBaseCompletionsModel { nullptr }; // Общая модель для базовых дополнений
+    PythonEnvironment *m_pythonEnvironment { nullptr }; // Фоновая интроспекция интерпретатора с дисковым кэшем
     QMap<CodeEditor*, QStringList> m_fileCompletionsCache; // Кэш слов из файлов для каждого редактора
-    QMap<CodeEditor*, QString> m_fileContentHash; // Хеш содержимого файла для отслеживания изменений
+    QMap<CodeEditor*, quint64> m_fileSymbolsRevision; // Ревизия SymbolIndex, по которой собраны слова файла
     QMap<CodeEditor*, QStringListModel*> m_editorCompletionsModels; // Модели completer для каждого редактора
+    QMap<QWidget*, LazyTab> m_lazyTabs;       // Контейнер вкладки без редактора -> файл
+    QMap<QWidget*, qint64> m_tabLastActive;    // Контейнер -> когда с вкладки ушли (мс)
+    QPointer<QWidget> m_activeTabContainer;
     QMap<CodeEditor*, QString> m_editorTaskMarker; // Маркер для отслеживания добавленных задач в документ
-    QStringList m_cachedPyrobTasks; // Кэш задач pyrob (загружается один раз)
+    PyrobTaskIndex *m_pyrobTaskIndex { nullptr }; // Задачи pyrob (сканируются в фоне)
+    CompletionServer *m_completionServer { nullptr }; // Фоновый анализ кода для дополнения атрибутов
+    int m_semanticRequestId { 0 }; // Последний запрос к серверу анализа (ответы на старые отбрасываются)
+    QPointer<CodeEditor> m_semanticRequestEditor;
+    bool m_semanticCompletionEnabled { true };
+    bool m_liveSyntaxCheckEnabled { true };
+    QTimer *m_syntaxCheckTimer { nullptr }; // Проверка синтаксиса после паузы в наборе
+    int m_syntaxCheckId { 0 };              // Последний запрос проверки (ответы на старые отбрасываются)
+    quint64 m_syntaxCheckVersion { 0 };     // Версия документа (modificationCount), отправленная на проверку
+    QPointer<CodeEditor> m_syntaxCheckEditor;
+    bool m_syntaxCheckIsRetry { false };    // Текущая проверка - повтор после неудачи (повторяем один раз)
+    SessionStore *m_sessionStore { nullptr };
+    FilePickerService *m_filePicker { nullptr }; // Постоянный помощник FilePicker.exe
+    QList<QPointer<CodeEditor>> m_closeDiscarded; // "Не сохранять" при закрытии окна, которое повторится после сохранения
+    bool m_closeRetry { false };                  // closeEvent - повтор после сохранения в диалоге
+    QTimer *m_sessionSaveTimer { nullptr };  // Не чаще раза в пару секунд при наборе и перемещениях
+    bool m_sessionReady { false };           // До восстановления сеанса снимок не пишется - иначе затрется
+    bool m_startupFinished { false };
+    QVector<SessionFile> m_pendingSessionFiles; // Вкладки сеанса, добавляемые после первой отрисовки
+    int m_pendingActiveIndex { -1 };            // Индекс уже открытой активной вкладки в m_pendingSessionFiles
+    QPointer<QWidget> m_sessionActiveTab;
     QAction *m_actNew { nullptr };
     QAction *m_actOpen { nullptr };
     QAction *m_actSave { nullptr };
@@ -216,10 +305,12 @@ private:
     QAction *m_actTerminate { nullptr };
     QAction *m_actDebug { nullptr };
     QAction *m_actDebugNext { nullptr };
+    QAction *m_actStepOver { nullptr };
+    QAction *m_actStepInto { nullptr };
+    QAction *m_actStepOut { nullptr };
     QAction *m_actRunInTerminal { nullptr };
     
     // Single instance support
-    QLocalServer *m_localServer { nullptr };
     
     // Aero Snap support
     bool m_isDragging { false };
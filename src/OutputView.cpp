@@ -0,0 +1,460 @@
+#include "OutputView.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QContextMenuEvent>
+#include <QFontMetrics>
+#include <QKeyEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+
+namespace {
+constexpr int TEXT_MARGIN = 4;          // Отступ текста от левого края
+constexpr int TAB_WIDTH = 8;            // Ширина табуляции в символах
+constexpr int MAX_LINE_LENGTH = 16384;  // Более длинные строки переносятся принудительно
+}
+
+OutputView::OutputView(QWidget *parent)
+    : QAbstractScrollArea(parent) {
+    QFont outputFont("Consolas");
+    outputFont.setStyleHint(QFont::Monospace);
+    outputFont.setPointSize(10);
+    setFont(outputFont);
+
+    setFocusPolicy(Qt::ClickFocus);
+    viewport()->setMouseTracking(true);
+    viewport()->setCursor(Qt::IBeamCursor);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+
+    m_lines = QVector<Line>(m_maxLines);
+    updateMetrics();
+    pushLine();
+}
+
+void OutputView::appendText(const QString &text, bool isError) {
+    if (text.isEmpty()) return;
+
+    QScrollBar *vbar = verticalScrollBar();
+    const bool stickToBottom = vbar->value() >= vbar->maximum();
+    const qint64 firstSerialBefore = m_firstSerial;
+
+    // Разбиваем порцию на строки; незавершенная строка остается открытой до следующего '\n'
+    int from = 0;
+    while (from <= text.length()) {
+        int newline = text.indexOf(QLatin1Char('\n'), from);
+        if (newline < 0) {
+            appendToLastLine(text, from, text.length(), isError);
+            break;
+        }
+        appendToLastLine(text, from, newline, isError);
+        finishLine(lineAt(m_count - 1));
+        pushLine();
+        from = newline + 1;
+    }
+
+    // Вытесняем старые строки, если превышен лимит по символам
+    while (m_totalChars > m_maxChars && m_count > 1) {
+        dropFrontLine();
+    }
+
+    // Выделение, ушедшее за начало буфера, обрезаем
+    if (hasSelection()) {
+        TextPos &first = (m_selAnchor.line < m_selCursor.line) ? m_selAnchor : m_selCursor;
+        TextPos &last = (m_selAnchor.line < m_selCursor.line) ? m_selCursor : m_selAnchor;
+        if (last.line < m_firstSerial) {
+            m_selAnchor = m_selCursor = TextPos();
+        } else if (first.line < m_firstSerial) {
+            first.line = m_firstSerial;
+            first.column = 0;
+        }
+    }
+
+    updateScrollBars();
+    if (stickToBottom) {
+        vbar->setValue(vbar->maximum());
+    } else {
+        // Сохраняем видимую область на месте при вытеснении строк сверху
+        vbar->setValue(vbar->value() - int(m_firstSerial - firstSerialBefore));
+    }
+    viewport()->update();
+}
+
+void OutputView::ensureNewLine() {
+    if (m_count > 0 && !lineAt(m_count - 1).text.isEmpty()) {
+        appendText(QStringLiteral("\n"));
+    }
+}
+
+void OutputView::clear() {
+    m_lines = QVector<Line>(m_maxLines);
+    m_firstSerial += m_count;
+    m_head = 0;
+    m_count = 0;
+    m_totalChars = 0;
+    m_maxLineLength = 0;
+    m_selAnchor = m_selCursor = TextPos();
+    m_selecting = false;
+    m_traceback.reset();
+    pushLine();
+    updateScrollBars();
+    verticalScrollBar()->setValue(0);
+    horizontalScrollBar()->setValue(0);
+    viewport()->update();
+}
+
+void OutputView::setMaxLines(int maxLines) {
+    m_maxLines = qMax(2, maxLines);
+    clear();
+}
+
+void OutputView::setMaxChars(int maxChars) {
+    m_maxChars = qMax(1024, maxChars);
+    while (m_totalChars > m_maxChars && m_count > 1) {
+        dropFrontLine();
+    }
+    updateScrollBars();
+    viewport()->update();
+}
+
+void OutputView::setTheme(const QString &theme) {
+    if (theme == "dark") {
+        m_backgroundColor = QColor("#232323");
+        m_textColor = QColor("#ffffff");
+        m_errorColor = QColor("#ff6b6b");
+        m_linkColor = QColor("#4aa3ff");
+        m_selectionColor = QColor("#264f78");
+    } else {
+        m_backgroundColor = QColor("#ffffff");
+        m_textColor = QColor("#000000");
+        m_errorColor = QColor("#b00020");
+        m_linkColor = QColor("#0000ee");
+        m_selectionColor = QColor("#add6ff");
+    }
+    viewport()->update();
+}
+
+OutputView::Line &OutputView::lineAt(int index) {
+    return m_lines[(m_head + index) % m_lines.size()];
+}
+
+const OutputView::Line &OutputView::lineAt(int index) const {
+    return m_lines.at((m_head + index) % m_lines.size());
+}
+
+void OutputView::pushLine() {
+    if (m_count == m_lines.size()) {
+        dropFrontLine();
+    }
+    m_lines[(m_head + m_count) % m_lines.size()] = Line();
+    ++m_count;
+}
+
+void OutputView::dropFrontLine() {
+    Line &front = m_lines[m_head];
+    m_totalChars -= front.text.length();
+    front = Line(); // Освобождаем память строки сразу
+    m_head = (m_head + 1) % m_lines.size();
+    --m_count;
+    ++m_firstSerial;
+}
+
+void OutputView::appendToLastLine(const QString &text, int from, int to, bool isError) {
+    if (from >= to) return;
+
+    Line *line = &lineAt(m_count - 1);
+    line->isError = line->isError || isError;
+
+    const QChar *data = text.constData();
+    int runStart = from;
+    auto flushRun = [&](int runEnd) {
+        while (runStart < runEnd) {
+            // Слишком длинную строку переносим, чтобы не раздувать одну запись буфера
+            if (line->text.length() >= MAX_LINE_LENGTH) {
+                m_maxLineLength = qMax(m_maxLineLength, line->text.length());
+                finishLine(*line);
+                pushLine();
+                line = &lineAt(m_count - 1);
+                line->isError = isError;
+            }
+            const int chunk = qMin(runEnd - runStart, MAX_LINE_LENGTH - line->text.length());
+            line->text.append(data + runStart, chunk);
+            m_totalChars += chunk;
+            runStart += chunk;
+        }
+    };
+
+    for (int i = from; i < to; ++i) {
+        const QChar ch = data[i];
+        if (ch == QLatin1Char('\r')) {
+            flushRun(i);
+            runStart = i + 1;
+        } else if (ch == QLatin1Char('\t')) {
+            flushRun(i);
+            runStart = i + 1;
+            const int spaces = TAB_WIDTH - line->text.length() % TAB_WIDTH;
+            line->text.append(QString(spaces, QLatin1Char(' ')));
+            m_totalChars += spaces;
+        }
+    }
+    flushRun(to);
+
+    m_maxLineLength = qMax(m_maxLineLength, line->text.length());
+}
+
+void OutputView::finishLine(Line &line) {
+    // Строка разбирается один раз, когда она завершена, поэтому ссылка,
+    // разорванная между порциями вывода, распознается целиком
+    line.links = m_traceback.parseLine(line.text);
+}
+
+void OutputView::updateMetrics() {
+    QFontMetrics fm(font());
+    m_lineHeight = qMax(1, fm.height());
+    m_ascent = fm.ascent();
+    m_charWidth = qMax(1, fm.horizontalAdvance(QLatin1Char('0')));
+}
+
+void OutputView::updateScrollBars() {
+    const int visible = visibleLineCount();
+    QScrollBar *vbar = verticalScrollBar();
+    vbar->setPageStep(visible);
+    vbar->setSingleStep(1);
+    vbar->setRange(0, qMax(0, m_count - visible));
+
+    QScrollBar *hbar = horizontalScrollBar();
+    const int contentWidth = m_maxLineLength * m_charWidth + 2 * TEXT_MARGIN;
+    hbar->setPageStep(viewport()->width());
+    hbar->setSingleStep(m_charWidth);
+    hbar->setRange(0, qMax(0, contentWidth - viewport()->width()));
+}
+
+int OutputView::visibleLineCount() const {
+    return qMax(1, viewport()->height() / m_lineHeight);
+}
+
+int OutputView::textOffsetX() const {
+    return TEXT_MARGIN - horizontalScrollBar()->value();
+}
+
+void OutputView::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    QPainter p(viewport());
+    p.fillRect(viewport()->rect(), m_backgroundColor);
+    p.setFont(font());
+
+    QFont linkFont = font();
+    linkFont.setUnderline(true);
+
+    const int firstLine = verticalScrollBar()->value();
+    const int rows = viewport()->height() / m_lineHeight + 1;
+    const int xOffset = textOffsetX();
+    // Видимый диапазон колонок: длинные строки рисуем только частично
+    const int firstColumn = qMax(0, -xOffset / m_charWidth);
+    const int lastColumn = firstColumn + viewport()->width() / m_charWidth + 2;
+
+    TextPos selStart = m_selAnchor;
+    TextPos selEnd = m_selCursor;
+    if (selEnd.line < selStart.line || (selEnd.line == selStart.line && selEnd.column < selStart.column)) {
+        qSwap(selStart, selEnd);
+    }
+    const bool selection = hasSelection();
+
+    auto drawSpan = [&](const QString &text, int from, int to, int y) {
+        from = qMax(from, firstColumn);
+        to = qMin(to, lastColumn);
+        if (from >= to) return;
+        p.drawText(xOffset + from * m_charWidth, y + m_ascent, text.mid(from, to - from));
+    };
+
+    for (int row = 0; row < rows && firstLine + row < m_count; ++row) {
+        const Line &line = lineAt(firstLine + row);
+        const qint64 serial = m_firstSerial + firstLine + row;
+        const int y = row * m_lineHeight;
+
+        if (selection && serial >= selStart.line && serial <= selEnd.line) {
+            const int from = (serial == selStart.line) ? selStart.column : 0;
+            const int to = (serial == selEnd.line) ? selEnd.column : line.text.length() + 1;
+            if (to > from) {
+                p.fillRect(xOffset + from * m_charWidth, y, (to - from) * m_charWidth, m_lineHeight,
+                           m_selectionColor);
+            }
+        }
+
+        const QColor color = line.isError ? m_errorColor : m_textColor;
+        int column = 0;
+        for (const TracebackFrame &link : line.links) {
+            p.setPen(color);
+            drawSpan(line.text, column, link.start, y);
+            p.setPen(m_linkColor);
+            p.setFont(linkFont);
+            drawSpan(line.text, link.start, link.start + link.length, y);
+            p.setFont(font());
+            column = link.start + link.length;
+        }
+        p.setPen(color);
+        drawSpan(line.text, column, line.text.length(), y);
+    }
+}
+
+void OutputView::resizeEvent(QResizeEvent *event) {
+    QScrollBar *vbar = verticalScrollBar();
+    const bool stickToBottom = vbar->value() >= vbar->maximum();
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+    if (stickToBottom) {
+        vbar->setValue(vbar->maximum());
+    }
+}
+
+void OutputView::scrollContentsBy(int dx, int dy) {
+    Q_UNUSED(dx);
+    Q_UNUSED(dy);
+    viewport()->update();
+}
+
+OutputView::TextPos OutputView::positionAt(const QPoint &pos) const {
+    TextPos result;
+    if (m_count == 0) return result;
+    const int index = qBound(0, verticalScrollBar()->value() + pos.y() / m_lineHeight, m_count - 1);
+    const Line &line = lineAt(index);
+    result.line = m_firstSerial + index;
+    const int column = qRound(double(pos.x() - textOffsetX()) / m_charWidth);
+    result.column = qBound(0, column, line.text.length());
+    return result;
+}
+
+const TracebackFrame *OutputView::linkAt(const QPoint &pos) const {
+    if (pos.y() < 0) return nullptr;
+    const int index = verticalScrollBar()->value() + pos.y() / m_lineHeight;
+    if (index < 0 || index >= m_count) return nullptr;
+    const int x = pos.x() - textOffsetX();
+    if (x < 0) return nullptr;
+    const int column = x / m_charWidth;
+    for (const TracebackFrame &link : lineAt(index).links) {
+        if (column >= link.start && column < link.start + link.length) {
+            return &link;
+        }
+    }
+    return nullptr;
+}
+
+void OutputView::mousePressEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+    if (const TracebackFrame *link = linkAt(event->pos())) {
+        if (!(event->modifiers() & Qt::ShiftModifier)) {
+            emit linkActivated(link->path, link->line);
+            return;
+        }
+    }
+    const TextPos pos = positionAt(event->pos());
+    if (event->modifiers() & Qt::ShiftModifier) {
+        m_selCursor = pos;
+    } else {
+        m_selAnchor = m_selCursor = pos;
+    }
+    m_selecting = true;
+    viewport()->update();
+}
+
+void OutputView::mouseMoveEvent(QMouseEvent *event) {
+    if (m_selecting) {
+        // Автопрокрутка при выделении за границами области
+        QScrollBar *vbar = verticalScrollBar();
+        if (event->pos().y() < 0) {
+            vbar->setValue(vbar->value() - 1);
+        } else if (event->pos().y() > viewport()->height()) {
+            vbar->setValue(vbar->value() + 1);
+        }
+        m_selCursor = positionAt(event->pos());
+        viewport()->update();
+        return;
+    }
+    viewport()->setCursor(linkAt(event->pos()) ? Qt::PointingHandCursor : Qt::IBeamCursor);
+}
+
+void OutputView::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_selecting = false;
+    }
+    QAbstractScrollArea::mouseReleaseEvent(event);
+}
+
+void OutputView::keyPressEvent(QKeyEvent *event) {
+    if (event->matches(QKeySequence::Copy)) {
+        copySelection();
+        return;
+    }
+    if (event->matches(QKeySequence::SelectAll)) {
+        selectAll();
+        return;
+    }
+    QAbstractScrollArea::keyPressEvent(event);
+}
+
+void OutputView::contextMenuEvent(QContextMenuEvent *event) {
+    QMenu menu(this);
+    QAction *copyAction = menu.addAction(tr("Копировать"), this, &OutputView::copySelection);
+    copyAction->setEnabled(hasSelection());
+    menu.addAction(tr("Выделить всё"), this, &OutputView::selectAll);
+    menu.addSeparator();
+    menu.addAction(tr("Очистить"), this, &OutputView::clear);
+    menu.exec(event->globalPos());
+}
+
+void OutputView::changeEvent(QEvent *event) {
+    if (event->type() == QEvent::FontChange) {
+        updateMetrics();
+        updateScrollBars();
+        viewport()->update();
+    }
+    QAbstractScrollArea::changeEvent(event);
+}
+
+bool OutputView::hasSelection() const {
+    return m_selAnchor.line != m_selCursor.line || m_selAnchor.column != m_selCursor.column;
+}
+
+QString OutputView::selectedText() const {
+    if (!hasSelection()) return QString();
+    TextPos selStart = m_selAnchor;
+    TextPos selEnd = m_selCursor;
+    if (selEnd.line < selStart.line || (selEnd.line == selStart.line && selEnd.column < selStart.column)) {
+        qSwap(selStart, selEnd);
+    }
+
+    QString result;
+    for (qint64 serial = qMax(selStart.line, m_firstSerial); serial <= selEnd.line; ++serial) {
+        const int index = int(serial - m_firstSerial);
+        if (index >= m_count) break;
+        const QString &text = lineAt(index).text;
+        const int from = (serial == selStart.line) ? qMin(selStart.column, text.length()) : 0;
+        const int to = (serial == selEnd.line) ? qMin(selEnd.column, text.length()) : text.length();
+        result += text.mid(from, to - from);
+        if (serial != selEnd.line) {
+            result += QLatin1Char('\n');
+        }
+    }
+    return result;
+}
+
+void OutputView::copySelection() const {
+    const QString text = selectedText();
+    if (!text.isEmpty()) {
+        QApplication::clipboard()->setText(text);
+    }
+}
+
+void OutputView::selectAll() {
+    if (m_count == 0) return;
+    m_selAnchor.line = m_firstSerial;
+    m_selAnchor.column = 0;
+    m_selCursor.line = m_firstSerial + m_count - 1;
+    m_selCursor.column = lineAt(m_count - 1).text.length();
+    viewport()->update();
+}
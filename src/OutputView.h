@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QAbstractScrollArea>
+#include <QColor>
+#include <QVector>
+
+#include "TracebackParser.h"
+
+// Панель вывода программы.
+// Строки хранятся в кольцевом буфере с ограничением по числу строк и символов,
+// отрисовывается только видимая область. Цвет ошибок и ссылки трассировки
+// хранятся как метаданные строки, HTML не используется.
+class OutputView : public QAbstractScrollArea {
+    Q_OBJECT
+public:
+    explicit OutputView(QWidget *parent = nullptr);
+
+    void appendText(const QString &text, bool isError = false);
+    void ensureNewLine(); // Переходит на новую строку, если текущая не пуста
+    void clear();
+
+    void setMaxLines(int maxLines);
+    void setMaxChars(int maxChars);
+    void setTheme(const QString &theme);
+
+    // Кадры трассировки, распознанные в выводе с последней очистки
+    const QVector<TracebackFrame> &tracebackFrames() const { return m_traceback.frames(); }
+
+signals:
+    void linkActivated(const QString &path, int line);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;
+    void changeEvent(QEvent *event) override;
+
+private:
+    struct Line {
+        QString text;
+        QVector<TracebackFrame> links;
+        bool isError { false };
+    };
+
+    // Позиция в тексте: сквозной номер строки (не сбрасывается при вытеснении) и колонка
+    struct TextPos {
+        qint64 line { 0 };
+        int column { 0 };
+    };
+
+    Line &lineAt(int index);
+    const Line &lineAt(int index) const;
+    void pushLine();
+    void dropFrontLine();
+    void appendToLastLine(const QString &text, int from, int to, bool isError);
+    void finishLine(Line &line);
+    void updateMetrics();
+    void updateScrollBars();
+    int visibleLineCount() const;
+    int textOffsetX() const;
+    TextPos positionAt(const QPoint &pos) const;
+    const TracebackFrame *linkAt(const QPoint &pos) const;
+    bool hasSelection() const;
+    QString selectedText() const;
+    void copySelection() const;
+    void selectAll();
+
+    QVector<Line> m_lines;        // Кольцевой буфер строк
+    TracebackParser m_traceback;  // Ссылки трассировки распознаются при завершении строки
+    int m_head { 0 };             // Индекс первой строки в буфере
+    int m_count { 0 };            // Количество строк в буфере
+    qint64 m_firstSerial { 0 };   // Сквозной номер первой строки буфера
+    int m_maxLines { 10000 };     // Максимум строк в буфере
+    int m_maxChars { 2000000 };   // Максимум символов в буфере
+    qint64 m_totalChars { 0 };    // Текущее количество символов в буфере
+    int m_maxLineLength { 0 };    // Самая длинная строка (для горизонтальной прокрутки)
+
+    int m_lineHeight { 16 };
+    int m_ascent { 12 };
+    int m_charWidth { 8 };
+
+    TextPos m_selAnchor;          // Начало выделения
+    TextPos m_selCursor;          // Конец выделения
+    bool m_selecting { false };   // Идет выделение мышью
+
+    QColor m_backgroundColor { Qt::white };
+    QColor m_textColor { Qt::black };
+    QColor m_errorColor { "#b00020" };
+    QColor m_linkColor { "#0000ee" };
+    QColor m_selectionColor { "#add6ff" };
+};
@@ -0,0 +1,388 @@
+#include "PackageService.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+constexpr int CACHE_FORMAT_VERSION = 2; // 2 - каталоги хранятся массивом в порядке sys.path
+constexpr int PATHS_QUERY_TIMEOUT_MS = 15000;
+
+// Каталог пакетов пользователя добавляется, даже если его еще нет: pip создает его
+// при установке с --user (site-packages только для чтения), и кэш должен это заметить.
+// Он ставится туда, где его поместит site при следующем запуске - перед site-packages
+const char *SITE_PATHS_SCRIPT =
+    "import json, os, site, sys\n"
+    "paths = [os.path.abspath(p) for p in sys.path if p and os.path.isdir(p)]\n"
+    "user = os.path.abspath(site.getusersitepackages()) if site.ENABLE_USER_SITE else None\n"
+    "if user and user not in paths:\n"
+    "    names = ('site-packages', 'dist-packages')\n"
+    "    index = next((i for i, p in enumerate(paths) if os.path.basename(p).lower() in names), len(paths))\n"
+    "    paths.insert(index, user)\n"
+    "print(json.dumps(paths))\n";
+
+QString cacheFilePath() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+        .absoluteFilePath("python_packages.json");
+}
+
+QString resolveExecutable(const QString &python) {
+    // "python.exe" без пути (системный интерпретатор) ищем в PATH
+    QFileInfo info(python);
+    if (info.isAbsolute()) {
+        return info.absoluteFilePath();
+    }
+    const QString found = QStandardPaths::findExecutable(python);
+    return found.isEmpty() ? python : QFileInfo(found).absoluteFilePath();
+}
+
+qint64 modificationTime(const QString &path) {
+    const QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+QJsonObject readCache() {
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("format").toInt() != CACHE_FORMAT_VERSION) {
+        return QJsonObject();
+    }
+    return root;
+}
+
+// Имя и версия из заголовка METADATA / PKG-INFO (формат писем: до первой пустой строки)
+PythonPackage readMetadata(const QString &path) {
+    PythonPackage package;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return package;
+    }
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty()) break;
+        if (line.startsWith("Name:")) {
+            package.name = QString::fromUtf8(line.mid(5)).trimmed();
+        } else if (line.startsWith("Version:")) {
+            package.version = QString::fromUtf8(line.mid(8)).trimmed();
+        }
+        if (!package.name.isEmpty() && !package.version.isEmpty()) break;
+    }
+    return package;
+}
+
+// "requests-2.31.0.dist-info" -> requests 2.31.0 (если METADATA не читается)
+PythonPackage packageFromDirectoryName(const QString &fileName) {
+    PythonPackage package;
+    const QString stem = fileName.left(fileName.lastIndexOf('.'));
+    const int dash = stem.indexOf('-');
+    package.name = dash > 0 ? stem.left(dash) : stem;
+    package.version = dash > 0 ? stem.mid(dash + 1).section('-', 0, 0) : QString();
+    return package;
+}
+
+// Нормализованное имя (PEP 503): пакет в нескольких каталогах sys.path учитывается один раз
+QString normalizedName(const QString &name) {
+    static const QRegularExpression separators("[-_.]+");
+    return name.toLower().replace(separators, "-");
+}
+
+QVector<PythonPackage> scanPackages(const QStringList &paths) {
+    QVector<PythonPackage> packages;
+    QHash<QString, bool> seen;
+    for (const QString &path : paths) {
+        const QDir dir(path);
+        const QFileInfoList entries = dir.entryInfoList(QStringList() << "*.dist-info" << "*.egg-info",
+                                                        QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot);
+        for (const QFileInfo &entry : entries) {
+            PythonPackage package;
+            if (entry.fileName().endsWith(".dist-info")) {
+                package = readMetadata(QDir(entry.absoluteFilePath()).filePath("METADATA"));
+            } else if (entry.isDir()) {
+                package = readMetadata(QDir(entry.absoluteFilePath()).filePath("PKG-INFO"));
+            } else {
+                package = readMetadata(entry.absoluteFilePath()); // egg-info в виде файла
+            }
+            if (package.name.isEmpty()) {
+                package = packageFromDirectoryName(entry.fileName());
+            }
+            // Первое вхождение по порядку sys.path - то, что импортирует интерпретатор
+            const QString key = normalizedName(package.name);
+            if (package.name.isEmpty() || seen.contains(key)) continue;
+            seen.insert(key, true);
+            packages.append(package);
+        }
+    }
+    std::sort(packages.begin(), packages.end(), [](const PythonPackage &a, const PythonPackage &b) {
+        return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
+    });
+    return packages;
+}
+}
+
+PackageService::PackageService(QObject *parent)
+    : QObject(parent) {
+}
+
+PackageService::~PackageService() {
+    for (QProcess *process : { m_pathsQuery.data(), m_operation.data() }) {
+        if (process) {
+            process->disconnect(this);
+            process->kill();
+            process->waitForFinished(500);
+        }
+    }
+}
+
+void PackageService::refresh(const QString &python) {
+    m_python = resolveExecutable(python);
+    ++m_generation;
+    if (m_pathsQuery) {
+        m_pathsQuery->disconnect(this);
+        m_pathsQuery->kill();
+        m_pathsQuery->deleteLater();
+    }
+
+    QStringList knownPaths;
+    if (loadFromCache(&knownPaths)) {
+        return;
+    }
+    // Каталоги sys.path при установке пакетов не меняются - запускать Python не нужно
+    if (!knownPaths.isEmpty()) {
+        scan(knownPaths);
+    } else {
+        querySitePaths();
+    }
+}
+
+bool PackageService::loadFromCache(QStringList *knownPaths) {
+    const QJsonObject entry = readCache().value("interpreters").toObject().value(m_python).toObject();
+    if (entry.isEmpty()) {
+        return false;
+    }
+    // Интерпретатор обновлен или заменен - каталоги могли измениться
+    if (entry.value("exeModified").toVariant().toLongLong() != modificationTime(m_python)) {
+        return false;
+    }
+    // Порядок важен: пакет из нескольких каталогов берется из первого по sys.path
+    const QJsonArray paths = entry.value("paths").toArray();
+    for (const QJsonValue &value : paths) {
+        knownPaths->append(value.toObject().value("path").toString());
+    }
+    for (const QJsonValue &value : paths) {
+        const QJsonObject path = value.toObject();
+        if (path.value("modified").toVariant().toLongLong() != modificationTime(path.value("path").toString())) {
+            return false;
+        }
+    }
+
+    QVector<PythonPackage> packages;
+    const QJsonArray items = entry.value("packages").toArray();
+    packages.reserve(items.size());
+    for (const QJsonValue &value : items) {
+        const QJsonObject object = value.toObject();
+        packages.append({ object.value("name").toString(), object.value("version").toString() });
+    }
+    emit packagesReady(packages, true);
+    return true;
+}
+
+void PackageService::querySitePaths() {
+    m_pathsQuery = new QProcess(this);
+    m_pathsQuery->setProgram(m_python);
+    m_pathsQuery->setArguments(QStringList() << "-c" << QString::fromUtf8(SITE_PATHS_SCRIPT));
+    m_pathsQuery->setProcessChannelMode(QProcess::SeparateChannels);
+    connect(m_pathsQuery, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [this]() {
+        QProcess *process = m_pathsQuery;
+        if (!process) return;
+        process->deleteLater();
+        const QByteArray output = process->readAllStandardOutput().trimmed();
+        // JSON - последняя строка вывода (до нее могут быть предупреждения site-пакетов)
+        const QJsonArray array = QJsonDocument::fromJson(output.mid(output.lastIndexOf('\n') + 1)).array();
+        QStringList paths;
+        for (const QJsonValue &path : array) {
+            paths.append(path.toString());
+        }
+        if (paths.isEmpty()) {
+            emit packagesFailed(tr("Не удалось получить каталоги пакетов интерпретатора."));
+            return;
+        }
+        scan(paths);
+    });
+    connect(m_pathsQuery, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart && m_pathsQuery) {
+            m_pathsQuery->deleteLater();
+            emit packagesFailed(tr("Не удалось запустить интерпретатор Python."));
+        }
+    });
+    QTimer::singleShot(PATHS_QUERY_TIMEOUT_MS, m_pathsQuery, [process = m_pathsQuery]() {
+        if (process) {
+            process->kill();
+        }
+    });
+    m_pathsQuery->start();
+}
+
+void PackageService::scan(const QStringList &paths) {
+    const quint64 generation = m_generation;
+    auto result = std::make_shared<QVector<PythonPackage>>();
+
+    // Поток без родителя: если сервис удален раньше, соединение разорвется,
+    // а поток удалит себя сам после завершения
+    QThread *thread = QThread::create([paths, result]() {
+        *result = scanPackages(paths);
+    });
+    connect(thread, &QThread::finished, this, [this, generation, paths, result]() {
+        applyScan(generation, paths, *result);
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start(QThread::LowPriority);
+}
+
+void PackageService::applyScan(quint64 generation, const QStringList &paths, const QVector<PythonPackage> &packages) {
+    if (generation != m_generation) return;
+    saveToCache(paths, packages);
+    emit packagesReady(packages, false);
+}
+
+void PackageService::saveToCache(const QStringList &paths, const QVector<PythonPackage> &packages) {
+    QJsonArray pathTimes;
+    for (const QString &path : paths) {
+        QJsonObject object;
+        object.insert("path", path);
+        object.insert("modified", modificationTime(path));
+        pathTimes.append(object);
+    }
+    QJsonArray items;
+    for (const PythonPackage &package : packages) {
+        QJsonObject object;
+        object.insert("name", package.name);
+        object.insert("version", package.version);
+        items.append(object);
+    }
+    QJsonObject entry;
+    entry.insert("exeModified", modificationTime(m_python));
+    entry.insert("paths", pathTimes);
+    entry.insert("packages", items);
+
+    QJsonObject root = readCache();
+    QJsonObject interpreters = root.value("interpreters").toObject();
+    interpreters.insert(m_python, entry);
+    root.insert("format", CACHE_FORMAT_VERSION);
+    root.insert("interpreters", interpreters);
+
+    const QString path = cacheFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
+
+bool PackageService::run(Operation operation, const QString &package) {
+    if (m_operation || m_python.isEmpty() || package.trimmed().isEmpty()) {
+        return false;
+    }
+
+    QStringList arguments { "-m", "pip" };
+    switch (operation) {
+    case Operation::Install:
+        arguments << "install";
+        break;
+    case Operation::Upgrade:
+        arguments << "install" << "--upgrade";
+        break;
+    case Operation::Uninstall:
+        arguments << "uninstall" << "--yes";
+        break;
+    }
+    arguments << "--disable-pip-version-check" << package.trimmed();
+
+    m_cancelled = false;
+    m_outputBuffer.clear();
+    m_lastOutputLine.clear();
+    m_operation = new QProcess(this);
+    m_operation->setProgram(m_python);
+    m_operation->setArguments(arguments);
+    m_operation->setProcessChannelMode(QProcess::MergedChannels);
+    // Вывод без буферизации - строки приходят по мере работы pip
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert("PYTHONUNBUFFERED", "1");
+    environment.insert("PYTHONIOENCODING", "utf-8");
+    m_operation->setProcessEnvironment(environment);
+    connect(m_operation, &QProcess::readyReadStandardOutput, this, &PackageService::onOperationOutput);
+    connect(m_operation, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &PackageService::onOperationFinished);
+    connect(m_operation, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            m_lastOutputLine = tr("Не удалось запустить интерпретатор Python.");
+            onOperationFinished();
+        }
+    });
+    m_operation->start();
+    return true;
+}
+
+void PackageService::cancel() {
+    if (!m_operation) return;
+    m_cancelled = true;
+    m_operation->kill();
+}
+
+void PackageService::onOperationOutput() {
+    if (!m_operation) return;
+    m_outputBuffer += m_operation->readAllStandardOutput();
+    // Индикаторы pip перерисовывают строку через '\r' - это тоже граница строки
+    for (;;) {
+        const int newline = m_outputBuffer.indexOf('\n');
+        const int carriage = m_outputBuffer.indexOf('\r');
+        const int end = (newline < 0 || (carriage >= 0 && carriage < newline)) ? carriage : newline;
+        if (end < 0) break;
+        const QString line = QString::fromUtf8(m_outputBuffer.left(end)).trimmed();
+        m_outputBuffer.remove(0, end + 1);
+        if (line.isEmpty()) continue;
+        m_lastOutputLine = line;
+        emit operationOutput(line);
+    }
+}
+
+void PackageService::onOperationFinished() {
+    QProcess *process = m_operation;
+    if (!process) return;
+    m_operation = nullptr;
+    disconnect(process, nullptr, this, nullptr);
+    process->deleteLater();
+
+    const QString rest = QString::fromUtf8(m_outputBuffer + process->readAllStandardOutput()).trimmed();
+    m_outputBuffer.clear();
+    if (!rest.isEmpty()) {
+        m_lastOutputLine = rest.section('\n', -1).trimmed();
+        emit operationOutput(m_lastOutputLine);
+    }
+
+    const bool success = !m_cancelled && process->exitStatus() == QProcess::NormalExit
+        && process->exitCode() == 0 && process->error() != QProcess::FailedToStart;
+    const QString message = m_cancelled ? tr("Операция отменена") : m_lastOutputLine;
+    emit operationFinished(success, message);
+
+    // Даже отмененная операция могла успеть изменить site-packages
+    refresh(m_python);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QByteArray>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QProcess;
+
+struct PythonPackage {
+    QString name;
+    QString version;
+};
+
+// Установленные пакеты интерпретатора и операции pip.
+// Список читается не через "pip list", а прямо из *.dist-info/METADATA (и *.egg-info)
+// каталогов sys.path в фоновом потоке и кэшируется на диске для каждого интерпретатора.
+// Запись кэша действительна, пока не изменились исполняемый файл и время изменения
+// каталогов sys.path (меняется при установке и удалении пакетов) - как в PythonEnvironment.
+// Каталог пакетов пользователя отслеживается, даже пока его нет (pip install --user создаст его).
+// Установка, обновление и удаление выполняются асинхронно, вывод pip передается построчно.
+class PackageService : public QObject {
+    Q_OBJECT
+public:
+    enum class Operation { Install, Upgrade, Uninstall };
+
+    explicit PackageService(QObject *parent = nullptr);
+    ~PackageService() override;
+
+    // packagesReady испускается сразу, если кэш действителен, иначе - после сканирования
+    void refresh(const QString &python);
+    bool run(Operation operation, const QString &package); // false - уже идет другая операция
+    void cancel();
+    bool isBusy() const { return m_operation != nullptr; }
+
+signals:
+    void packagesReady(const QVector<PythonPackage> &packages, bool fromCache);
+    void packagesFailed(const QString &message);
+    void operationOutput(const QString &line);
+    void operationFinished(bool success, const QString &message);
+
+private:
+    bool loadFromCache(QStringList *knownPaths);
+    void querySitePaths();
+    void scan(const QStringList &paths);
+    void applyScan(quint64 generation, const QStringList &paths, const QVector<PythonPackage> &packages);
+    void saveToCache(const QStringList &paths, const QVector<PythonPackage> &packages);
+    void onOperationOutput();
+    void onOperationFinished();
+
+    QString m_python;                // Абсолютный путь к интерпретатору
+    quint64 m_generation { 0 };      // Результаты устаревших запросов отбрасываются
+    QPointer<QProcess> m_pathsQuery; // Запрос sys.path (если его нет в кэше)
+    QPointer<QProcess> m_operation;  // Текущая операция pip
+    QByteArray m_outputBuffer;       // Неполная строка вывода pip
+    QString m_lastOutputLine;
+    bool m_cancelled { false };
+};
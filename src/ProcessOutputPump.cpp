@@ -0,0 +1,145 @@
+#include "ProcessOutputPump.h"
+
+#include <QProcess>
+#include <QTextCodec>
+#include <QTextDecoder>
+#include <QTimer>
+
+namespace {
+constexpr int FLUSH_INTERVAL_MS = 16;   // Не чаще одного обновления UI за кадр
+constexpr int RATE_WINDOW_MS = 1000;    // Окно подсчета скорости вывода
+}
+
+ProcessOutputPump::ProcessOutputPump(QProcess *process, QObject *parent)
+    : QObject(parent), m_process(process) {
+    QTextCodec *utf8 = QTextCodec::codecForName("UTF-8");
+    m_stdout.decoder = utf8->makeDecoder();
+    m_stderr.decoder = utf8->makeDecoder();
+
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+    connect(m_flushTimer, &QTimer::timeout, this, &ProcessOutputPump::flush);
+
+    connect(process, &QProcess::readyReadStandardOutput, this, &ProcessOutputPump::onReadyReadStandardOutput);
+    connect(process, &QProcess::readyReadStandardError, this, &ProcessOutputPump::onReadyReadStandardError);
+
+    m_rateTimer.start();
+    m_startTimer.start();
+
+    // Процесс мог быть запущен заранее (прогретый интерпретатор) и уже что-то вывести.
+    // Читаем из очереди событий: вызывающий успевает подключиться к textReady и firstOutput
+    QTimer::singleShot(0, this, [this]() {
+        onReadyReadStandardOutput();
+        onReadyReadStandardError();
+    });
+}
+
+ProcessOutputPump::~ProcessOutputPump() {
+    delete m_stdout.decoder;
+    delete m_stderr.decoder;
+}
+
+void ProcessOutputPump::setMaxPendingChars(int maxChars) {
+    m_maxPendingChars = qMax(1024, maxChars);
+}
+
+void ProcessOutputPump::onReadyReadStandardOutput() {
+    if (!m_process) return;
+    ingest(m_stdout, m_process->readAllStandardOutput(), false);
+}
+
+void ProcessOutputPump::onReadyReadStandardError() {
+    if (!m_process) return;
+    ingest(m_stderr, m_process->readAllStandardError(), true);
+}
+
+void ProcessOutputPump::ingest(Channel &channel, const QByteArray &data, bool isError) {
+    if (data.isEmpty()) return;
+    if (m_firstOutputMs < 0) {
+        m_firstOutputMs = m_startTimer.elapsed();
+        emit firstOutput(m_firstOutputMs);
+    }
+    updateRate(data.size());
+
+    QString text = channel.decoder->toUnicode(data);
+    if (!channel.localFallback && channel.decoder->hasFailure()) {
+        // Поток не в UTF-8 (например, консольная кодировка Windows) -
+        // переключаемся на локальную кодировку один раз, а не проверяем каждую порцию
+        channel.localFallback = true;
+        delete channel.decoder;
+        channel.decoder = QTextCodec::codecForLocale()->makeDecoder();
+        text = channel.decoder->toUnicode(data);
+    }
+    if (text.isEmpty()) return;
+
+    // Соседние порции одного потока склеиваем в один сегмент
+    if (!m_pending.isEmpty() && m_pending.last().isError == isError) {
+        m_pending.last().text += text;
+    } else {
+        Segment segment;
+        segment.text = text;
+        segment.isError = isError;
+        m_pending.append(segment);
+    }
+    m_pendingChars += text.length();
+
+    if (m_pendingChars > m_maxPendingChars) {
+        dropOldestLines();
+    }
+
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void ProcessOutputPump::dropOldestLines() {
+    // Программа пишет быстрее, чем имеет смысл показывать: отбрасываем
+    // самые старые целые строки, они все равно были бы вытеснены из панели
+    while (m_pendingChars > m_maxPendingChars && !m_pending.isEmpty()) {
+        Segment &front = m_pending.first();
+        const int excess = m_pendingChars - m_maxPendingChars;
+        if (front.text.length() <= excess && m_pending.size() > 1) {
+            m_droppedLines += front.text.count(QLatin1Char('\n'));
+            m_pendingChars -= front.text.length();
+            m_pending.removeFirst();
+            continue;
+        }
+        // Режем до конца строки, в которую попадает граница
+        const int boundary = qMin(excess, front.text.length()) - 1;
+        int cut = front.text.indexOf(QLatin1Char('\n'), boundary);
+        if (cut < 0) {
+            cut = boundary;
+        }
+        m_droppedLines += front.text.leftRef(cut + 1).count(QLatin1Char('\n'));
+        front.text.remove(0, cut + 1);
+        m_pendingChars -= cut + 1;
+        if (front.text.isEmpty()) {
+            m_pending.removeFirst();
+        }
+    }
+}
+
+void ProcessOutputPump::flush() {
+    m_flushTimer->stop();
+    if (m_pending.isEmpty()) return;
+
+    const QVector<Segment> pending = m_pending;
+    m_pending.clear();
+    m_pendingChars = 0;
+    for (const Segment &segment : pending) {
+        emit textReady(segment.text, segment.isError);
+    }
+}
+
+void ProcessOutputPump::updateRate(qint64 bytes) {
+    m_totalBytes += bytes;
+    m_windowBytes += bytes;
+    const qint64 elapsed = m_rateTimer.elapsed();
+    if (elapsed >= RATE_WINDOW_MS) {
+        m_bytesPerSecond = m_windowBytes * 1000 / elapsed;
+        m_windowBytes = 0;
+        m_rateTimer.restart();
+        emit statsUpdated(m_bytesPerSecond, m_droppedLines);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QVector>
+
+class QProcess;
+class QTextDecoder;
+class QTimer;
+
+// Промежуточный слой между QProcess и панелью вывода.
+// Байты stdout/stderr декодируются потоково (многобайтные символы, разорванные
+// между чтениями, не портятся), накапливаются и отдаются в UI не чаще раза за кадр.
+class ProcessOutputPump : public QObject {
+    Q_OBJECT
+public:
+    explicit ProcessOutputPump(QProcess *process, QObject *parent = nullptr);
+    ~ProcessOutputPump() override;
+
+    void flush(); // Немедленно отдает накопленный текст (например, при завершении процесса)
+    void setMaxPendingChars(int maxChars);
+
+    qint64 totalBytes() const { return m_totalBytes; }
+    qint64 bytesPerSecond() const { return m_bytesPerSecond; }
+    qint64 droppedLines() const { return m_droppedLines; }
+    qint64 firstOutputLatency() const { return m_firstOutputMs; } // -1, пока вывода не было
+
+signals:
+    void textReady(const QString &text, bool isError);
+    void statsUpdated(qint64 bytesPerSecond, qint64 droppedLines);
+    void firstOutput(qint64 latencyMs); // Время от создания до первого байта вывода
+
+private slots:
+    void onReadyReadStandardOutput();
+    void onReadyReadStandardError();
+
+private:
+    struct Channel {
+        QTextDecoder *decoder { nullptr };
+        bool localFallback { false }; // Поток оказался не в UTF-8 - декодируем локальной кодировкой
+    };
+
+    struct Segment {
+        QString text;
+        bool isError { false };
+    };
+
+    void ingest(Channel &channel, const QByteArray &data, bool isError);
+    void dropOldestLines();
+    void updateRate(qint64 bytes);
+
+    QProcess *m_process { nullptr };
+    Channel m_stdout;
+    Channel m_stderr;
+    QVector<Segment> m_pending;       // Накопленный текст в порядке поступления
+    int m_pendingChars { 0 };
+    int m_maxPendingChars { 1000000 }; // Сверх этого старые строки отбрасываются до отрисовки
+    QTimer *m_flushTimer { nullptr };
+
+    qint64 m_totalBytes { 0 };
+    qint64 m_bytesPerSecond { 0 };
+    qint64 m_droppedLines { 0 };
+    qint64 m_windowBytes { 0 };       // Байты за текущее окно подсчета скорости
+    QElapsedTimer m_rateTimer;
+    QElapsedTimer m_startTimer;       // Отсчет от запуска для замера задержки первого вывода
+    qint64 m_firstOutputMs { -1 };
+};
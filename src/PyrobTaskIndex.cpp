@@ -0,0 +1,105 @@
+#include "PyrobTaskIndex.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+constexpr int RESCAN_DELAY_MS = 300;
+
+struct ScanResult {
+    QString tasksDir;
+    QStringList tasks;
+};
+
+// Выполняется в фоновом потоке: только файловая система, без объектов GUI
+ScanResult scanTasks(const QStringList &searchPaths) {
+    ScanResult result;
+    for (const QString &path : searchPaths) {
+        const QString candidate = QDir(path).absoluteFilePath("pyrob/tasks");
+        if (QFileInfo(candidate).isDir()) {
+            result.tasksDir = candidate;
+            break;
+        }
+    }
+    if (result.tasksDir.isEmpty()) {
+        return result;
+    }
+    const QStringList files = QDir(result.tasksDir).entryList(QStringList() << "*.py", QDir::Files);
+    for (const QString &file : files) {
+        if (file != "__init__.py") {
+            result.tasks.append(file.left(file.length() - 3));
+        }
+    }
+    std::sort(result.tasks.begin(), result.tasks.end());
+    return result;
+}
+}
+
+PyrobTaskIndex::PyrobTaskIndex(QObject *parent)
+    : QObject(parent) {
+    m_watcher = new QFileSystemWatcher(this);
+    m_rescanTimer = new QTimer(this);
+    m_rescanTimer->setSingleShot(true);
+    m_rescanTimer->setInterval(RESCAN_DELAY_MS);
+    connect(m_rescanTimer, &QTimer::timeout, this, &PyrobTaskIndex::rescan);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, m_rescanTimer, QOverload<>::of(&QTimer::start));
+}
+
+void PyrobTaskIndex::setSearchPaths(const QStringList &paths) {
+    if (paths == m_searchPaths) return;
+    m_searchPaths = paths;
+    rescan();
+}
+
+void PyrobTaskIndex::rescan() {
+    const quint64 generation = ++m_generation;
+    const QStringList searchPaths = m_searchPaths;
+    auto result = std::make_shared<ScanResult>();
+
+    // Поток без родителя: если индекс удален раньше, соединение разорвется,
+    // а поток удалит себя сам после завершения
+    QThread *thread = QThread::create([searchPaths, result]() {
+        *result = scanTasks(searchPaths);
+    });
+    connect(thread, &QThread::finished, this, [this, generation, result]() {
+        applyScan(generation, result->tasksDir, result->tasks);
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start(QThread::LowPriority);
+}
+
+void PyrobTaskIndex::applyScan(quint64 generation, const QString &tasksDir, const QStringList &tasks) {
+    if (generation != m_generation) return;
+
+    // Следим за каталогом задач, а пока pyrob не найден - за каталогами поиска,
+    // чтобы заметить его установку
+    const QStringList watched = m_watcher->directories();
+    if (!watched.isEmpty()) {
+        m_watcher->removePaths(watched);
+    }
+    QStringList toWatch;
+    if (!tasksDir.isEmpty()) {
+        toWatch.append(tasksDir);
+    } else {
+        for (const QString &path : qAsConst(m_searchPaths)) {
+            if (QFileInfo(path).isDir()) {
+                toWatch.append(path);
+            }
+        }
+    }
+    if (!toWatch.isEmpty()) {
+        m_watcher->addPaths(toWatch);
+    }
+
+    m_tasksDir = tasksDir;
+    if (tasks != m_tasks) {
+        m_tasks = tasks;
+        emit tasksChanged();
+    }
+}
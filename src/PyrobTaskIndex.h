@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+
+class QFileSystemWatcher;
+class QTimer;
+
+// Индекс задач pyrob для автодополнения после "def ".
+// Каталог pyrob/tasks ищется в переданных каталогах (site-packages интерпретатора)
+// и сканируется в фоновом потоке; QFileSystemWatcher запускает повторное
+// сканирование при изменениях. Запросы к индексу не обращаются к диску.
+class PyrobTaskIndex : public QObject {
+    Q_OBJECT
+public:
+    explicit PyrobTaskIndex(QObject *parent = nullptr);
+
+    void setSearchPaths(const QStringList &paths);
+
+    QStringList tasks() const { return m_tasks; } // Отсортированы по имени
+    QString tasksDirectory() const { return m_tasksDir; }
+
+signals:
+    void tasksChanged();
+
+private:
+    void rescan();
+    void applyScan(quint64 generation, const QString &tasksDir, const QStringList &tasks);
+
+    QFileSystemWatcher *m_watcher { nullptr };
+    QTimer *m_rescanTimer { nullptr }; // Склеивает серию изменений каталога в одно сканирование
+    QStringList m_searchPaths;
+    QStringList m_tasks;
+    QString m_tasksDir;
+    quint64 m_generation { 0 }; // Результаты устаревших сканирований отбрасываются
+};
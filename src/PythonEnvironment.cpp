@@ -0,0 +1,234 @@
+#include "PythonEnvironment.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+
+namespace {
+constexpr int INTROSPECTION_TIMEOUT_MS = 30000; // Зависший интерпретатор не держит запрос вечно
+constexpr int CACHE_FORMAT_VERSION = 2; // 2 - каталоги хранятся массивом в порядке sys.path
+
+// Выводит одной строкой JSON: версию, каталоги sys.path и список слов для дополнения
+const char *INTROSPECTION_SCRIPT =
+    "import builtins\n"
+    "import json\n"
+    "import keyword\n"
+    "import os\n"
+    "import pkgutil\n"
+    "import sys\n"
+    "\n"
+    "result = set(keyword.kwlist)\n"
+    "\n"
+    "# Встроенные функции, константы и исключения\n"
+    "for name in dir(builtins):\n"
+    "    if not name.startswith('_') or name in ('__debug__', '__import__'):\n"
+    "        result.add(name)\n"
+    "\n"
+    "# Модули из sys.path (stdlib и site-packages)\n"
+    "try:\n"
+    "    for module in pkgutil.iter_modules():\n"
+    "        if not module.name.startswith('_') and '.' not in module.name:\n"
+    "            result.add(module.name)\n"
+    "except Exception:\n"
+    "    pass\n"
+    "result.update(name for name in sys.builtin_module_names if not name.startswith('_'))\n"
+    "\n"
+    "# Pyrob API\n"
+    "try:\n"
+    "    import pyrob.api\n"
+    "    result.update(name for name in dir(pyrob.api) if not name.startswith('_'))\n"
+    "    result.update(('task', 'run_tasks'))\n"
+    "except Exception:\n"
+    "    result.update(('move_left', 'move_right', 'move_up', 'move_down', 'wall_is_above',\n"
+    "                   'wall_is_beneath', 'wall_is_on_the_left', 'wall_is_on_the_right',\n"
+    "                   'fill_cell', 'cell_is_filled', 'mov', 'task', 'run_tasks'))\n"
+    "\n"
+    "paths = [os.path.abspath(p) for p in sys.path if p and os.path.isdir(p)]\n"
+    "print(json.dumps({\n"
+    "    'version': sys.version.split()[0],\n"
+    "    'paths': paths,\n"
+    "    'completions': sorted(result),\n"
+    "}))\n";
+
+QString cacheFilePath() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+        .absoluteFilePath("python_completions.json");
+}
+
+QString resolveExecutable(const QString &python) {
+    // "python.exe" без пути (системный интерпретатор) ищем в PATH
+    QFileInfo info(python);
+    if (info.isAbsolute()) {
+        return info.absoluteFilePath();
+    }
+    const QString found = QStandardPaths::findExecutable(python);
+    return found.isEmpty() ? python : QFileInfo(found).absoluteFilePath();
+}
+
+qint64 modificationTime(const QString &path) {
+    const QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+QJsonObject readCache() {
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("format").toInt() != CACHE_FORMAT_VERSION) {
+        return QJsonObject();
+    }
+    return root;
+}
+}
+
+PythonEnvironment::PythonEnvironment(QObject *parent)
+    : QObject(parent) {
+}
+
+PythonEnvironment::~PythonEnvironment() {
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(500);
+    }
+}
+
+void PythonEnvironment::requestCompletions(const QString &python) {
+    m_python = resolveExecutable(python);
+    m_version.clear();
+    m_sitePaths.clear();
+
+    // Предыдущий запрос (например, для старого интерпретатора) больше не нужен
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->deleteLater();
+    }
+
+    if (loadFromCache()) {
+        return;
+    }
+
+    m_process = new QProcess(this);
+    m_process->setProgram(m_python);
+    m_process->setArguments(QStringList() << "-c" << QString::fromUtf8(INTROSPECTION_SCRIPT));
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &PythonEnvironment::onIntrospectionFinished);
+    connect(m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart && m_process) {
+            // Интерпретатор не найден - остается статический список
+            m_process->deleteLater();
+        }
+    });
+    QTimer::singleShot(INTROSPECTION_TIMEOUT_MS, m_process, [process = m_process]() {
+        if (process) {
+            process->kill();
+        }
+    });
+    m_process->start();
+}
+
+bool PythonEnvironment::loadFromCache() {
+    const QJsonObject entry = readCache().value("interpreters").toObject().value(m_python).toObject();
+    if (entry.isEmpty()) {
+        return false;
+    }
+    // Интерпретатор обновлен или заменен
+    if (entry.value("exeModified").toVariant().toLongLong() != modificationTime(m_python)) {
+        return false;
+    }
+    // Установка или удаление пакетов меняет время изменения каталогов sys.path.
+    // Порядок важен: задачи pyrob берутся из первого каталога, как при импорте
+    QStringList sitePaths;
+    for (const QJsonValue &value : entry.value("paths").toArray()) {
+        const QJsonObject path = value.toObject();
+        const QString dir = path.value("path").toString();
+        if (path.value("modified").toVariant().toLongLong() != modificationTime(dir)) {
+            return false;
+        }
+        sitePaths.append(dir);
+    }
+
+    QStringList completions;
+    const QJsonArray words = entry.value("completions").toArray();
+    completions.reserve(words.size());
+    for (const QJsonValue &word : words) {
+        completions.append(word.toString());
+    }
+    if (completions.isEmpty()) {
+        return false;
+    }
+    m_version = entry.value("version").toString();
+    m_sitePaths = sitePaths;
+    emit completionsReady(completions, true);
+    return true;
+}
+
+void PythonEnvironment::onIntrospectionFinished() {
+    QProcess *process = m_process;
+    if (!process) return;
+    process->deleteLater();
+
+    const QByteArray output = process->readAllStandardOutput().trimmed();
+    // JSON - последняя строка вывода (до нее могут быть предупреждения site-пакетов)
+    const QJsonObject result = QJsonDocument::fromJson(output.mid(output.lastIndexOf('\n') + 1)).object();
+    if (result.isEmpty()) {
+        return;
+    }
+
+    QStringList completions;
+    for (const QJsonValue &word : result.value("completions").toArray()) {
+        completions.append(word.toString());
+    }
+    if (completions.isEmpty()) {
+        return;
+    }
+    m_version = result.value("version").toString();
+    m_sitePaths.clear();
+    for (const QJsonValue &path : result.value("paths").toArray()) {
+        m_sitePaths.append(path.toString());
+    }
+
+    saveToCache(completions);
+    emit completionsReady(completions, false);
+}
+
+void PythonEnvironment::saveToCache(const QStringList &completions) {
+    QJsonArray paths;
+    for (const QString &path : qAsConst(m_sitePaths)) {
+        QJsonObject object;
+        object.insert("path", path);
+        object.insert("modified", modificationTime(path));
+        paths.append(object);
+    }
+    QJsonObject entry;
+    entry.insert("exeModified", modificationTime(m_python));
+    entry.insert("version", m_version);
+    entry.insert("paths", paths);
+    entry.insert("completions", QJsonArray::fromStringList(completions));
+
+    QJsonObject root = readCache();
+    QJsonObject interpreters = root.value("interpreters").toObject();
+    interpreters.insert(m_python, entry);
+    root.insert("format", CACHE_FORMAT_VERSION);
+    root.insert("interpreters", interpreters);
+
+    const QString path = cacheFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+
+class QProcess;
+
+// Сведения об интерпретаторе Python для автодополнения: ключевые слова, builtins,
+// модули из sys.path и API pyrob.
+// Интроспекция выполняется асинхронно (без блокировки GUI) и сохраняется в дисковый
+// кэш. Запись кэша действительна, пока не изменились исполняемый файл интерпретатора
+// (путь и время изменения) и каталоги sys.path (время изменения - меняется при
+// установке и удалении пакетов), поэтому при следующих запусках Python не запускается.
+class PythonEnvironment : public QObject {
+    Q_OBJECT
+public:
+    explicit PythonEnvironment(QObject *parent = nullptr);
+    ~PythonEnvironment() override;
+
+    // Если кэш действителен, completionsReady испускается сразу, иначе - по готовности
+    void requestCompletions(const QString &python);
+
+    QString pythonPath() const { return m_python; }
+    QString version() const { return m_version; }
+    QStringList sitePaths() const { return m_sitePaths; } // Каталоги sys.path интерпретатора
+
+signals:
+    void completionsReady(const QStringList &completions, bool fromCache);
+
+private:
+    bool loadFromCache();
+    void onIntrospectionFinished();
+    void saveToCache(const QStringList &completions);
+
+    QPointer<QProcess> m_process;
+    QString m_python;       // Абсолютный путь к интерпретатору
+    QString m_version;
+    QStringList m_sitePaths;
+};
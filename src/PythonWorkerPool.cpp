@@ -0,0 +1,133 @@
+#include "PythonWorkerPool.h"
+
+#include <QProcess>
+#include <QTimer>
+
+namespace {
+constexpr int MAX_FAILED_STARTS = 3;      // После стольких сбоев подряд пул перестает запускать процессы
+constexpr int RESPAWN_DELAY_MS = 1000;    // Пауза перед повторным запуском после сбоя
+}
+
+PythonWorkerPool::PythonWorkerPool(QObject *parent)
+    : QObject(parent) {
+}
+
+PythonWorkerPool::~PythonWorkerPool() {
+    clearWorkers();
+}
+
+void PythonWorkerPool::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    m_failedStarts = 0;
+    if (m_enabled) {
+        scheduleReplenish();
+    } else {
+        clearWorkers();
+    }
+}
+
+void PythonWorkerPool::setPythonPath(const QString &python) {
+    if (m_pythonPath == python) return;
+    m_pythonPath = python;
+    m_failedStarts = 0;
+    // Прогретые процессы старого интерпретатора больше не годятся
+    clearWorkers();
+    if (m_enabled) {
+        scheduleReplenish();
+    }
+}
+
+void PythonWorkerPool::setScript(const QString &script) {
+    if (m_script == script) return;
+    m_script = script;
+    clearWorkers();
+    if (m_enabled) {
+        scheduleReplenish();
+    }
+}
+
+void PythonWorkerPool::setPoolSize(int size) {
+    m_poolSize = qBound(1, size, 4);
+    while (m_workers.size() > m_poolSize) {
+        QProcess *worker = m_workers.takeLast();
+        disconnect(worker, nullptr, this, nullptr);
+        worker->kill();
+        worker->deleteLater();
+    }
+    if (m_enabled) {
+        scheduleReplenish();
+    }
+}
+
+QProcess *PythonWorkerPool::takeWorker(QObject *newParent) {
+    if (!m_enabled) return nullptr;
+
+    QProcess *result = nullptr;
+    for (int i = 0; i < m_workers.size(); ++i) {
+        QProcess *worker = m_workers.at(i);
+        if (worker->state() == QProcess::Running) {
+            m_workers.removeAt(i);
+            disconnect(worker, nullptr, this, nullptr);
+            worker->setParent(newParent);
+            result = worker;
+            break;
+        }
+    }
+    // Вместо отданного (или еще не готового) процесса сразу готовим следующий
+    scheduleReplenish();
+    return result;
+}
+
+void PythonWorkerPool::scheduleReplenish(int delayMs) {
+    if (m_replenishScheduled) return;
+    m_replenishScheduled = true;
+    QTimer::singleShot(delayMs, this, &PythonWorkerPool::replenish);
+}
+
+void PythonWorkerPool::replenish() {
+    m_replenishScheduled = false;
+    if (!m_enabled || m_pythonPath.isEmpty() || m_script.isEmpty()) return;
+    if (m_failedStarts >= MAX_FAILED_STARTS) return;
+
+    while (m_workers.size() < m_poolSize) {
+        auto *worker = new QProcess(this);
+        worker->setProgram(m_pythonPath);
+        worker->setArguments(QStringList() << "-c" << m_script << "--worker");
+        worker->setProcessChannelMode(QProcess::SeparateChannels);
+        connect(worker, &QProcess::started, this, [this]() {
+            m_failedStarts = 0;
+        });
+        connect(worker, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+                [this, worker]() { onWorkerDied(worker); });
+        connect(worker, &QProcess::errorOccurred, this, [this, worker](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+                onWorkerDied(worker);
+            }
+        });
+        m_workers.append(worker);
+        worker->start();
+    }
+}
+
+void PythonWorkerPool::onWorkerDied(QProcess *worker) {
+    // Процесс завершился, не дождавшись задания (сбой интерпретатора) -
+    // убираем его и запускаем замену с паузой
+    if (!m_workers.removeOne(worker)) return;
+    disconnect(worker, nullptr, this, nullptr);
+    worker->deleteLater();
+    ++m_failedStarts;
+    if (m_enabled) {
+        scheduleReplenish(RESPAWN_DELAY_MS);
+    }
+}
+
+void PythonWorkerPool::clearWorkers() {
+    for (QProcess *worker : qAsConst(m_workers)) {
+        disconnect(worker, nullptr, this, nullptr);
+        worker->kill();
+        worker->waitForFinished(500);
+        delete worker;
+    }
+    m_workers.clear();
+}
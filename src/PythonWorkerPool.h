@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QObject>
+#include <QList>
+#include <QStringList>
+
+class QProcess;
+
+// Пул прогретых интерпретаторов для режима "быстрый запуск".
+// Каждый процесс заранее запущен с оберткой (runtime/vuzhyk_runner.py --worker),
+// уже импортировал ее модули и ждет задание в первой строке stdin.
+// Процесс выполняет ровно один скрипт и завершается, поэтому состояние между
+// запусками не переносится; вместо отданного процесса пул запускает новый.
+class PythonWorkerPool : public QObject {
+    Q_OBJECT
+public:
+    explicit PythonWorkerPool(QObject *parent = nullptr);
+    ~PythonWorkerPool() override;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+    void setPythonPath(const QString &python);
+    void setScript(const QString &script);
+    void setPoolSize(int size);
+
+    // Возвращает готовый процесс (владение переходит к newParent) или nullptr,
+    // если готовых нет - тогда вызывающий запускает свежий процесс
+    QProcess *takeWorker(QObject *newParent);
+
+private:
+    void scheduleReplenish(int delayMs = 0);
+    void replenish();
+    void onWorkerDied(QProcess *worker);
+    void clearWorkers();
+
+    QList<QProcess*> m_workers;   // Ожидающие задания процессы
+    QString m_pythonPath;
+    QString m_script;
+    int m_poolSize { 1 };
+    bool m_enabled { false };
+    bool m_replenishScheduled { false };
+    int m_failedStarts { 0 };     // Подряд неудачных запусков - чтобы не перезапускать бесконечно
+};
@@ -0,0 +1,79 @@
+#include "RunnerChannel.h"
+
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+RunnerChannel::RunnerChannel(QObject *parent)
+    : QObject(parent) {
+    m_server = new QLocalServer(this);
+    connect(m_server, &QLocalServer::newConnection, this, &RunnerChannel::onNewConnection);
+}
+
+bool RunnerChannel::listen() {
+    static int channelCounter = 0;
+    const QString name = QString("VuzhykRunner_%1_%2")
+                             .arg(QCoreApplication::applicationPid())
+                             .arg(++channelCounter);
+    QLocalServer::removeServer(name);
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    return m_server->listen(name);
+}
+
+QString RunnerChannel::fullServerName() const {
+    return m_server->isListening() ? m_server->fullServerName() : QString();
+}
+
+bool RunnerChannel::isConnected() const {
+    return m_socket && m_socket->state() == QLocalSocket::ConnectedState;
+}
+
+void RunnerChannel::send(const QJsonObject &message) {
+    if (!isConnected()) return;
+    m_socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact) + '\n');
+    m_socket->flush();
+}
+
+void RunnerChannel::drain() {
+    if (!m_socket && m_server->hasPendingConnections()) {
+        onNewConnection();
+    }
+    if (!m_socket) return;
+    if (m_socket->state() == QLocalSocket::ConnectedState) {
+        m_socket->waitForReadyRead(0);
+    }
+    onReadyRead();
+}
+
+void RunnerChannel::onNewConnection() {
+    QLocalSocket *socket = m_server->nextPendingConnection();
+    if (!socket) return;
+    if (m_socket) {
+        // Канал рассчитан на один процесс - лишние подключения закрываем
+        socket->disconnectFromServer();
+        socket->deleteLater();
+        return;
+    }
+    m_socket = socket;
+    connect(socket, &QLocalSocket::readyRead, this, &RunnerChannel::onReadyRead);
+    connect(socket, &QLocalSocket::disconnected, this, &RunnerChannel::disconnected);
+    // Больше подключений не ждем
+    m_server->close();
+    emit connected();
+    onReadyRead();
+}
+
+void RunnerChannel::onReadyRead() {
+    if (!m_socket) return;
+    m_buffer += m_socket->readAll();
+    int newline;
+    while ((newline = m_buffer.indexOf('\n')) >= 0) {
+        const QByteArray line = m_buffer.left(newline);
+        m_buffer.remove(0, newline + 1);
+        const QJsonDocument doc = QJsonDocument::fromJson(line);
+        if (doc.isObject()) {
+            emit messageReceived(doc.object());
+        }
+    }
+}
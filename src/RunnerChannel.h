@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QPointer>
+
+class QLocalServer;
+class QLocalSocket;
+
+// Служебный канал между IDE и запущенным скриптом.
+// QLocalServer на один клиент; сообщения - JSON-объекты, по одному на строку.
+// Python-сторона подключается к fullServerName() (см. runtime/vuzhyk_runner.py).
+class RunnerChannel : public QObject {
+    Q_OBJECT
+public:
+    explicit RunnerChannel(QObject *parent = nullptr);
+
+    bool listen();                  // Создает канал с уникальным именем
+    QString fullServerName() const; // Имя для подключения из Python
+    bool isConnected() const;
+    void send(const QJsonObject &message);
+    void drain(); // Дочитывает уже пришедшие сообщения (например, после завершения процесса)
+
+signals:
+    void connected();
+    void messageReceived(const QJsonObject &message);
+    void disconnected();
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+private:
+    QLocalServer *m_server { nullptr };
+    QPointer<QLocalSocket> m_socket;
+    QByteArray m_buffer; // Незавершенная строка сообщения
+};
@@ -0,0 +1,135 @@
+#include "SessionStore.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <utility>
+
+namespace {
+constexpr int SESSION_FORMAT_VERSION = 1;
+}
+
+SessionStore::SessionStore(QObject *parent)
+    : QObject(parent) {
+}
+
+SessionStore::~SessionStore() {
+    if (m_writer) {
+        m_writer->wait();
+    }
+}
+
+QString SessionStore::sessionFilePath() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation))
+        .absoluteFilePath("session.json");
+}
+
+Session SessionStore::load() const {
+    Session session;
+    QFile file(sessionFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return session;
+    }
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("format").toInt() != SESSION_FORMAT_VERSION) {
+        return session;
+    }
+    const QJsonArray files = root.value("files").toArray();
+    session.files.reserve(files.size());
+    for (const QJsonValue &value : files) {
+        const QJsonObject object = value.toObject();
+        SessionFile entry;
+        entry.path = object.value("path").toString();
+        if (entry.path.isEmpty()) continue;
+        entry.line = object.value("line").toInt();
+        entry.index = object.value("index").toInt();
+        entry.firstVisibleLine = object.value("firstVisibleLine").toInt();
+        for (const QJsonValue &line : object.value("breakpoints").toArray()) {
+            entry.breakpoints.append(line.toInt());
+        }
+        session.files.append(entry);
+    }
+    session.activeIndex = root.value("active").toInt(-1);
+    if (session.activeIndex >= session.files.size()) {
+        session.activeIndex = -1;
+    }
+    return session;
+}
+
+QByteArray SessionStore::serialize(const Session &session) {
+    QJsonArray files;
+    for (const SessionFile &entry : session.files) {
+        QJsonObject object;
+        object.insert("path", entry.path);
+        object.insert("line", entry.line);
+        object.insert("index", entry.index);
+        object.insert("firstVisibleLine", entry.firstVisibleLine);
+        QJsonArray breakpoints;
+        for (int line : entry.breakpoints) {
+            breakpoints.append(line);
+        }
+        object.insert("breakpoints", breakpoints);
+        files.append(object);
+    }
+    QJsonObject root;
+    root.insert("format", SESSION_FORMAT_VERSION);
+    root.insert("files", files);
+    root.insert("active", session.activeIndex);
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+void SessionStore::writeFile(const QByteArray &data) {
+    const QString path = sessionFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(data);
+        file.commit();
+    }
+}
+
+void SessionStore::save(const Session &session) {
+    m_pending = serialize(session);
+    if (!m_writer) {
+        startWrite();
+    }
+}
+
+void SessionStore::saveNow(const Session &session) {
+    if (m_writer) {
+        m_writer->wait();
+    }
+    const QByteArray data = serialize(session);
+    m_pending.clear();
+    if (data == m_lastWritten) return;
+    writeFile(data);
+    m_lastWritten = data;
+}
+
+void SessionStore::startWrite() {
+    if (m_pending.isEmpty() || m_pending == m_lastWritten) {
+        m_pending.clear();
+        return;
+    }
+    const QByteArray data = std::move(m_pending);
+    m_pending.clear();
+    m_lastWritten = data;
+    QThread *thread = QThread::create([data]() {
+        writeFile(data);
+    });
+    m_writer = thread;
+    // Следующий снимок записывается только после окончания текущей записи
+    connect(thread, &QThread::finished, this, [this]() {
+        m_writer = nullptr;
+        startWrite();
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start(QThread::LowPriority);
+}
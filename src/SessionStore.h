@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+
+class QThread;
+
+// Снимок сеанса: открытые файлы, позиции курсора и прокрутки, точки останова
+// и активная вкладка. Хранится в JSON-файле рядом с настройками.
+// Запись выполняется в фоновом потоке (QSaveFile - файл не бывает записан наполовину);
+// частые сохранения склеиваются: пока идет запись, сохраняется только последний снимок.
+struct SessionFile {
+    QString path;
+    int line { 0 };
+    int index { 0 };
+    int firstVisibleLine { 0 };
+    QList<int> breakpoints;
+};
+
+struct Session {
+    QVector<SessionFile> files;
+    int activeIndex { -1 }; // Индекс в files; -1 - активна вкладка без файла
+};
+
+class SessionStore : public QObject {
+    Q_OBJECT
+public:
+    explicit SessionStore(QObject *parent = nullptr);
+    ~SessionStore() override; // Дожидается фоновой записи
+
+    Session load() const;
+    void save(const Session &session);    // Асинхронно; одинаковые снимки не записываются
+    void saveNow(const Session &session); // Синхронно (при закрытии окна)
+
+private:
+    static QString sessionFilePath();
+    static QByteArray serialize(const Session &session);
+    static void writeFile(const QByteArray &data);
+    void startWrite();
+
+    QPointer<QThread> m_writer;
+    QByteArray m_pending;      // Снимок, ожидающий окончания текущей записи
+    QByteArray m_lastWritten;
+};
@@ -11,11 +11,7 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
-#include <QProcess>
 #include <QMessageBox>
-#include <QJsonDocument>
-#include <QJsonArray>
-#include <QJsonObject>
 #include <QTableWidget>
 #include <QTableWidgetItem>
 #include <QHeaderView>
@@ -120,6 +116,47 @@ void SettingsWidget::setupUi()
     
     interfaceLayout->addLayout(fontSizeLayout);
     
+    // Порог большого файла: такие файлы открываются без сворачивания и дополнения по словам файла
+    auto *largeFileLabel = new QLabel(tr("Открывать как большой файл от:"), m_interfacePage);
+    m_largeFileSizeSpinBox = new QSpinBox(m_interfacePage);
+    m_largeFileSizeSpinBox->setRange(1, 1024);
+    m_largeFileSizeSpinBox->setSuffix(tr(" МБ"));
+    m_largeFileSizeSpinBox->setToolTip(tr("Большой файл загружается частями, без сворачивания блоков "
+                                          "и без дополнения по словам этого файла"));
+    m_largeFileSizeSpinBox->setValue(QSettings().value("editor/largeFileSizeMB", 2).toInt());
+    connect(m_largeFileSizeSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [](int value) {
+        QSettings settings;
+        settings.setValue("editor/largeFileSizeMB", value);
+    });
+    
+    auto *largeFileLayout = new QHBoxLayout();
+    largeFileLayout->addWidget(largeFileLabel);
+    largeFileLayout->addWidget(m_largeFileSizeSpinBox);
+    largeFileLayout->addStretch();
+    
+    interfaceLayout->addLayout(largeFileLayout);
+    
+    // Выгрузка редакторов неактивных вкладок (вкладка остается, файл читается заново при показе)
+    auto *unloadLabel = new QLabel(tr("Выгружать неактивные вкладки через:"), m_interfacePage);
+    m_unloadIdleSpinBox = new QSpinBox(m_interfacePage);
+    m_unloadIdleSpinBox->setRange(0, 24 * 60);
+    m_unloadIdleSpinBox->setSuffix(tr(" мин"));
+    m_unloadIdleSpinBox->setSpecialValueText(tr("не выгружать"));
+    m_unloadIdleSpinBox->setToolTip(tr("Редактор сохраненного файла, который давно не открывали, освобождает память. "
+                                       "При переходе на вкладку файл открывается снова на том же месте."));
+    m_unloadIdleSpinBox->setValue(QSettings().value("editor/unloadIdleMinutes", 10).toInt());
+    connect(m_unloadIdleSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [](int value) {
+        QSettings settings;
+        settings.setValue("editor/unloadIdleMinutes", value);
+    });
+    
+    auto *unloadLayout = new QHBoxLayout();
+    unloadLayout->addWidget(unloadLabel);
+    unloadLayout->addWidget(m_unloadIdleSpinBox);
+    unloadLayout->addStretch();
+    
+    interfaceLayout->addLayout(unloadLayout);
+    
     // Закрытие вкладок средней кнопкой мыши
     m_closeTabWithMiddleButtonCheckBox = new QCheckBox(tr("Закрытие вкладок средней кнопкой мыши"), m_interfacePage);
     QSettings settings;
@@ -187,19 +224,100 @@ void SettingsWidget::setupUi()
     
     interpreterLayout->addLayout(pathLayout);
     
+    // Быстрый запуск: интерпретатор запускается заранее и ждет скрипт
+    m_fastRunCheckBox = new QCheckBox(tr("Быстрый запуск (держать готовый интерпретатор)"), m_interpreterPage);
+    m_fastRunCheckBox->setToolTip(tr("Интерпретатор запускается заранее, поэтому скрипт стартует быстрее. "
+                                     "Каждый запуск по-прежнему выполняется в отдельном процессе."));
+    QSettings fastRunSettings;
+    m_fastRunCheckBox->setChecked(fastRunSettings.value("runtime/fastRun", false).toBool());
+    connect(m_fastRunCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        QSettings settings;
+        settings.setValue("runtime/fastRun", checked);
+        emit fastRunChanged(checked);
+    });
+    interpreterLayout->addWidget(m_fastRunCheckBox);
+    
+    // Умное автодополнение: атрибуты объектов и модулей от фонового сервера анализа
+    m_semanticCompletionCheckBox = new QCheckBox(tr("Умное автодополнение (атрибуты объектов и модулей)"), m_interpreterPage);
+    m_semanticCompletionCheckBox->setToolTip(tr("Код анализируется в фоновом процессе Python, поэтому после \"math.\" "
+                                                "или \"self.\" предлагаются их атрибуты. Пока анализ не готов, "
+                                                "работает обычное дополнение по словам."));
+    m_semanticCompletionCheckBox->setChecked(QSettings().value("runtime/semanticCompletion", true).toBool());
+    connect(m_semanticCompletionCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        QSettings settings;
+        settings.setValue("runtime/semanticCompletion", checked);
+        emit semanticCompletionChanged(checked);
+    });
+    interpreterLayout->addWidget(m_semanticCompletionCheckBox);
+    
+    // Проверка синтаксиса во время набора (тем же фоновым сервером анализа)
+    m_liveSyntaxCheckCheckBox = new QCheckBox(tr("Проверять синтаксис во время набора"), m_interpreterPage);
+    m_liveSyntaxCheckCheckBox->setToolTip(tr("Через полсекунды после правки файл проверяется выбранным интерпретатором, "
+                                             "а место ошибки подчеркивается. Подробности - при наведении мыши."));
+    m_liveSyntaxCheckCheckBox->setChecked(QSettings().value("runtime/liveSyntaxCheck", true).toBool());
+    connect(m_liveSyntaxCheckCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        QSettings settings;
+        settings.setValue("runtime/liveSyntaxCheck", checked);
+        emit liveSyntaxCheckChanged(checked);
+    });
+    interpreterLayout->addWidget(m_liveSyntaxCheckCheckBox);
+    
     // Список установленных библиотек
+    m_packageService = new PackageService(this);
+    
     auto *packagesHeaderLayout = new QHBoxLayout();
-    packagesHeaderLayout->addStretch();
+    m_packageNameEdit = new QLineEdit(m_interpreterPage);
+    m_packageNameEdit->setPlaceholderText(tr("Имя библиотеки"));
+    packagesHeaderLayout->addWidget(m_packageNameEdit, 1);
+    m_installPackageButton = new QPushButton(tr("Установить"), m_interpreterPage);
+    packagesHeaderLayout->addWidget(m_installPackageButton);
+    m_upgradePackageButton = new QPushButton(tr("Обновить"), m_interpreterPage);
+    packagesHeaderLayout->addWidget(m_upgradePackageButton);
+    m_uninstallPackageButton = new QPushButton(tr("Удалить"), m_interpreterPage);
+    packagesHeaderLayout->addWidget(m_uninstallPackageButton);
+    m_cancelPackageButton = new QPushButton(tr("Отмена"), m_interpreterPage);
+    m_cancelPackageButton->setVisible(false);
+    packagesHeaderLayout->addWidget(m_cancelPackageButton);
     m_refreshPackagesButton = new QPushButton(tr("Обновить список"), m_interpreterPage);
     packagesHeaderLayout->addWidget(m_refreshPackagesButton);
     interpreterLayout->addLayout(packagesHeaderLayout);
     
+    m_packageStatusLabel = new QLabel(m_interpreterPage);
+    m_packageStatusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    interpreterLayout->addWidget(m_packageStatusLabel);
+    
     m_installedPackagesList = new QListWidget(m_interpreterPage);
     m_installedPackagesList->setUniformItemSizes(true);
     interpreterLayout->addWidget(m_installedPackagesList);
     
     connect(m_refreshPackagesButton, &QPushButton::clicked,
             this, &SettingsWidget::refreshInstalledPackages);
+    connect(m_installPackageButton, &QPushButton::clicked, this, [this]() {
+        runPackageOperation(PackageService::Operation::Install);
+    });
+    connect(m_upgradePackageButton, &QPushButton::clicked, this, [this]() {
+        runPackageOperation(PackageService::Operation::Upgrade);
+    });
+    connect(m_uninstallPackageButton, &QPushButton::clicked, this, [this]() {
+        runPackageOperation(PackageService::Operation::Uninstall);
+    });
+    connect(m_cancelPackageButton, &QPushButton::clicked, m_packageService, &PackageService::cancel);
+    connect(m_installedPackagesList, &QListWidget::currentItemChanged, this, [this](QListWidgetItem *item) {
+        if (item) {
+            m_packageNameEdit->setText(item->data(Qt::UserRole).toString());
+        }
+    });
+    connect(m_packageService, &PackageService::packagesReady, this,
+            [this](const QVector<PythonPackage> &packages) {
+        populateInstalledPackagesList(packages);
+    });
+    connect(m_packageService, &PackageService::packagesFailed, this, [this](const QString &message) {
+        m_installedPackagesList->clear();
+        m_packageStatusLabel->setText(message);
+    });
+    connect(m_packageService, &PackageService::operationOutput, m_packageStatusLabel, &QLabel::setText);
+    connect(m_packageService, &PackageService::operationFinished,
+            this, &SettingsWidget::onPackageOperationFinished);
     interpreterLayout->addStretch();
     
     m_settingsStack->addWidget(m_interpreterPage);
@@ -355,15 +473,38 @@ void SettingsWidget::refreshInstalledPackages()
         return;
     }
     
-    m_installedPackagesList->clear();
-    
-    QByteArray stdOut;
-    QByteArray stdErr;
-    if (!runPythonProcess({"-m", "pip", "list", "--format=json"}, stdOut, stdErr)) {
+    // Список приходит сразу из кэша или после фонового чтения метаданных пакетов
+    m_packageService->refresh(python);
+}
+
+void SettingsWidget::runPackageOperation(PackageService::Operation operation)
+{
+    const QString package = m_packageNameEdit->text().trimmed();
+    if (package.isEmpty()) {
+        m_packageNameEdit->setFocus();
+        return;
+    }
+    if (operation == PackageService::Operation::Uninstall
+        && QMessageBox::question(this, tr("Удаление библиотеки"),
+                                 tr("Удалить библиотеку %1?").arg(package)) != QMessageBox::Yes) {
         return;
     }
     
-    populateInstalledPackagesList(stdOut);
+    if (m_packageService->run(operation, package)) {
+        m_packageStatusLabel->setText(tr("Выполняется pip для %1...").arg(package));
+        updatePackageUiEnabled();
+    }
+}
+
+void SettingsWidget::onPackageOperationFinished(bool success, const QString &message)
+{
+    if (success) {
+        m_packageStatusLabel->setText(message.isEmpty() ? tr("Готово") : message);
+        emit showStatusMessage(tr("Операция pip завершена"));
+    } else {
+        m_packageStatusLabel->setText(message.isEmpty() ? tr("Ошибка pip") : message);
+    }
+    updatePackageUiEnabled();
 }
 
 void SettingsWidget::ensurePackagesInitialized()
@@ -412,92 +553,36 @@ QString SettingsWidget::resolvePythonExecutable() const
     return QStringLiteral("python.exe");
 }
 
-bool SettingsWidget::runPythonProcess(const QStringList &arguments, QByteArray &stdOutput, QByteArray &stdError, bool showErrors)
-{
-    const QString python = resolvePythonExecutable();
-    if (python.isEmpty() || !QFile::exists(python)) {
-        if (showErrors) {
-            QMessageBox::warning(this, tr("Python не найден"),
-                                 tr("Не удалось найти интерпретатор Python. Проверьте настройки интерпретатора."));
-        }
-        updatePackageUiEnabled();
-        return false;
-    }
-    
-    QProcess process;
-    process.setProgram(python);
-    process.setArguments(arguments);
-    process.setProcessChannelMode(QProcess::SeparateChannels);
-    
-    process.start();
-    if (!process.waitForFinished(60000)) {
-        process.kill();
-        if (showErrors) {
-            QMessageBox::warning(this, tr("Таймаут"),
-                                 tr("Команда pip выполняется слишком долго и была остановлена."));
-        }
-        return false;
-    }
-    
-    stdOutput = process.readAllStandardOutput();
-    stdError = process.readAllStandardError();
-    
-    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
-        QString errorText = QString::fromUtf8(stdError).trimmed();
-        if (errorText.isEmpty())
-            errorText = tr("Неизвестная ошибка при выполнении команды pip.");
-        if (showErrors) {
-            QMessageBox::warning(this, tr("Ошибка pip"), errorText);
-        }
-        return false;
-    }
-    
-    return true;
-}
-
 void SettingsWidget::updatePackageUiEnabled()
 {
     const QString python = resolvePythonExecutable();
     const bool available = !python.isEmpty() && QFile::exists(python);
     
-    if (m_refreshPackagesButton) m_refreshPackagesButton->setEnabled(available);
+    const bool busy = m_packageService && m_packageService->isBusy();
+    
+    if (m_refreshPackagesButton) m_refreshPackagesButton->setEnabled(available && !busy);
     if (m_installedPackagesList) m_installedPackagesList->setEnabled(available);
+    if (m_packageNameEdit) m_packageNameEdit->setEnabled(available && !busy);
+    for (QPushButton *button : { m_installPackageButton, m_upgradePackageButton, m_uninstallPackageButton }) {
+        if (button) button->setEnabled(available && !busy);
+    }
+    if (m_cancelPackageButton) m_cancelPackageButton->setVisible(busy);
     
     if (!available) {
         if (m_installedPackagesList) m_installedPackagesList->clear();
     }
 }
 
-void SettingsWidget::populateInstalledPackagesList(const QByteArray &jsonData)
+void SettingsWidget::populateInstalledPackagesList(const QVector<PythonPackage> &packages)
 {
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(jsonData, &parseError);
-    if (parseError.error != QJsonParseError::NoError || !doc.isArray()) {
-        QMessageBox::warning(this, tr("Ошибка разбора"),
-                             tr("Не удалось разобрать вывод pip list."));
-        return;
-    }
-    
-    const QJsonArray array = doc.array();
-    QStringList packages;
-    packages.reserve(array.size());
-    for (const QJsonValue &value : array) {
-        if (!value.isObject())
-            continue;
-        const QJsonObject obj = value.toObject();
-        const QString name = obj.value(QStringLiteral("name")).toString();
-        const QString version = obj.value(QStringLiteral("version")).toString();
-        if (!name.isEmpty()) {
-            if (!version.isEmpty())
-                packages << QString("%1 %2").arg(name, version);
-            else
-                packages << name;
-        }
-    }
-    packages.sort(Qt::CaseInsensitive);
-    
-    for (const QString &pkg : packages) {
-        m_installedPackagesList->addItem(pkg);
+    // Список уже отсортирован сервисом
+    m_installedPackagesList->clear();
+    for (const PythonPackage &package : packages) {
+        auto *item = new QListWidgetItem(package.version.isEmpty()
+                                         ? package.name
+                                         : QString("%1 %2").arg(package.name, package.version));
+        item->setData(Qt::UserRole, package.name);
+        m_installedPackagesList->addItem(item);
     }
 }
 
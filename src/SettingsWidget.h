@@ -19,6 +19,8 @@
 #include <QKeySequence>
 #include <QCheckBox>
 
+#include "PackageService.h"
+
 class SettingsWidget : public QWidget {
     Q_OBJECT
 public:
@@ -28,6 +30,9 @@ public:
 signals:
     void fontSizeChanged(int size);
     void interpreterChanged();
+    void fastRunChanged(bool enabled);
+    void semanticCompletionChanged(bool enabled);
+    void liveSyntaxCheckChanged(bool enabled);
     void showStatusMessage(const QString &message, int timeoutMs = 3000);
     void closeRequested();
     void shortcutChanged(const QString &actionName, const QKeySequence &sequence);
@@ -50,12 +55,13 @@ private:
     void saveShortcutSettings();
     void setupShortcutsPage();
     QString resolvePythonExecutable() const;
-    bool runPythonProcess(const QStringList &arguments, QByteArray &stdOutput, QByteArray &stdError, bool showErrors = true);
     void updatePackageUiEnabled();
     void ensurePackagesInitialized();
     void schedulePackagesRefresh();
     bool isInterpreterPageVisible() const;
-    void populateInstalledPackagesList(const QByteArray &jsonData);
+    void populateInstalledPackagesList(const QVector<PythonPackage> &packages);
+    void runPackageOperation(PackageService::Operation operation);
+    void onPackageOperationFinished(bool success, const QString &message);
     
     QListWidget *m_categoryList { nullptr };
     QStackedWidget *m_settingsStack { nullptr };
@@ -63,6 +69,8 @@ private:
     // Interface section
     QWidget *m_interfacePage { nullptr };
     QSpinBox *m_fontSizeSpinBox { nullptr };
+    QSpinBox *m_largeFileSizeSpinBox { nullptr }; // Порог режима большого файла (МБ)
+    QSpinBox *m_unloadIdleSpinBox { nullptr }; // Простой вкладки до выгрузки редактора (мин, 0 - никогда)
     QCheckBox *m_closeTabWithMiddleButtonCheckBox { nullptr };
     QCheckBox *m_showCloseButtonOnTabsCheckBox { nullptr };
     
@@ -74,9 +82,19 @@ private:
     QRadioButton *m_customRadio { nullptr };
     QLineEdit *m_pythonPathEdit { nullptr };
     QPushButton *m_browseButton { nullptr };
+    QCheckBox *m_fastRunCheckBox { nullptr }; // Быстрый запуск через прогретый интерпретатор
+    QCheckBox *m_semanticCompletionCheckBox { nullptr }; // Сервер анализа кода для автодополнения
+    QCheckBox *m_liveSyntaxCheckCheckBox { nullptr }; // Проверка синтаксиса во время набора
     
     QListWidget *m_installedPackagesList { nullptr };
     QPushButton *m_refreshPackagesButton { nullptr };
+    QLineEdit *m_packageNameEdit { nullptr };
+    QPushButton *m_installPackageButton { nullptr };
+    QPushButton *m_upgradePackageButton { nullptr };
+    QPushButton *m_uninstallPackageButton { nullptr };
+    QPushButton *m_cancelPackageButton { nullptr };
+    QLabel *m_packageStatusLabel { nullptr }; // Последняя строка вывода pip
+    PackageService *m_packageService { nullptr };
     
     // Shortcuts section
     QWidget *m_shortcutsPage { nullptr };
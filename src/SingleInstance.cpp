@@ -0,0 +1,164 @@
+#include "SingleInstance.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QLockFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QtEndian>
+
+namespace {
+constexpr auto SERVER_NAME = "VuzhykIDE_SingleInstance";
+constexpr int HEADER_BYTES = 4;
+constexpr quint32 MAX_MESSAGE_BYTES = 16 * 1024 * 1024;
+constexpr int CONNECT_TIMEOUT_MS = 3000; // Запущенный экземпляр может еще не слушать
+constexpr int CONNECT_ATTEMPT_MS = 200;
+constexpr int CONNECT_RETRY_MS = 50;
+constexpr int WRITE_TIMEOUT_MS = 1000;
+}
+
+SingleInstance::SingleInstance(QObject *parent)
+    : QObject(parent) {
+}
+
+SingleInstance::~SingleInstance() = default;
+
+QString SingleInstance::serverName() {
+    return QString::fromLatin1(SERVER_NAME);
+}
+
+bool SingleInstance::tryLock() {
+    const QString path = QDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation))
+        .absoluteFilePath(serverName() + ".lock");
+    m_lock.reset(new QLockFile(path));
+    // Блокировка устаревает только со смертью процесса-владельца, не по времени
+    m_lock->setStaleLockTime(0);
+    return m_lock->tryLock(0);
+}
+
+bool SingleInstance::listen() {
+    if (m_server) return true;
+    m_server = new QLocalServer(this);
+    // Блокировка наша - оставшийся сокет принадлежал упавшему экземпляру
+    QLocalServer::removeServer(serverName());
+    if (!m_server->listen(serverName())) {
+        delete m_server;
+        m_server = nullptr;
+        return false;
+    }
+    connect(m_server, &QLocalServer::newConnection, this, &SingleInstance::onNewConnection);
+    return true;
+}
+
+bool SingleInstance::sendToRunning(const InstanceRequest &request) {
+    const QByteArray message = encode(request);
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < CONNECT_TIMEOUT_MS) {
+        QLocalSocket socket;
+        socket.connectToServer(serverName());
+        if (!socket.waitForConnected(CONNECT_ATTEMPT_MS)) {
+            // Сервера еще нет - соединение отклоняется сразу, ждем недолго
+            QThread::msleep(CONNECT_RETRY_MS);
+            continue;
+        }
+        socket.write(message);
+        while (socket.bytesToWrite() > 0) {
+            if (!socket.waitForBytesWritten(WRITE_TIMEOUT_MS)) {
+                return false;
+            }
+        }
+        socket.disconnectFromServer();
+        return true;
+    }
+    return false;
+}
+
+QByteArray SingleInstance::encode(const InstanceRequest &request) {
+    QJsonArray files;
+    for (const InstanceFile &file : request.files) {
+        QJsonObject object;
+        object.insert("path", file.path);
+        if (file.line > 0) {
+            object.insert("line", file.line);
+        }
+        files.append(object);
+    }
+    QJsonObject root;
+    root.insert("action", request.action);
+    root.insert("files", files);
+    const QByteArray payload = QJsonDocument(root).toJson(QJsonDocument::Compact);
+
+    QByteArray message(HEADER_BYTES, '\0');
+    qToBigEndian(quint32(payload.size()), message.data());
+    message += payload;
+    return message;
+}
+
+bool SingleInstance::decode(const QByteArray &payload, InstanceRequest *request) {
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(payload, &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+        return false;
+    }
+    const QJsonObject root = document.object();
+    request->action = root.value("action").toString();
+    for (const QJsonValue &value : root.value("files").toArray()) {
+        const QJsonObject object = value.toObject();
+        InstanceFile file;
+        file.path = object.value("path").toString();
+        file.line = object.value("line").toInt();
+        if (!file.path.isEmpty()) {
+            request->files.append(file);
+        }
+    }
+    return !request->action.isEmpty();
+}
+
+void SingleInstance::onNewConnection() {
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+            readMessages(socket);
+        });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+            // Отправитель отключается сразу после записи - дочитываем буфер
+            readMessages(socket);
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+        readMessages(socket);
+    }
+}
+
+void SingleInstance::readMessages(QLocalSocket *socket) {
+    if (!m_buffers.contains(socket) && socket->bytesAvailable() == 0) return;
+    QVector<InstanceRequest> requests;
+    {
+        QByteArray &buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        while (buffer.size() >= HEADER_BYTES) {
+            const quint32 length = qFromBigEndian<quint32>(buffer.constData());
+            if (length > MAX_MESSAGE_BYTES) {
+                // Не наш протокол - дальнейшие байты не разобрать
+                buffer.clear();
+                socket->abort();
+                break;
+            }
+            if (quint32(buffer.size()) < HEADER_BYTES + length) break;
+            InstanceRequest request;
+            if (decode(buffer.mid(HEADER_BYTES, int(length)), &request)) {
+                requests.append(request);
+            }
+            buffer.remove(0, HEADER_BYTES + int(length));
+        }
+    }
+    // Обработчик может открыть диалог (вложенный цикл событий) - буфер к этому моменту не используется
+    for (const InstanceRequest &request : qAsConst(requests)) {
+        emit requestReceived(request);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+class QLocalServer;
+class QLocalSocket;
+class QLockFile;
+
+struct InstanceFile {
+    QString path;
+    int line { 0 }; // С 1; 0 - строка не задана
+};
+
+// Запрос запущенному экземпляру: "open" - открыть файлы, "activate" - только показать окно
+struct InstanceRequest {
+    QString action;
+    QVector<InstanceFile> files;
+};
+
+// Единственный экземпляр IDE. Первый экземпляр удерживает QLockFile и слушает
+// QLocalServer; следующие видят занятую блокировку сразу, без ожидания подключения,
+// и передают ему запрос. Сообщение - 4 байта длины (big-endian) и JSON
+// {action, files: [{path, line}]}, поэтому длинный список файлов может приходить частями.
+class SingleInstance : public QObject {
+    Q_OBJECT
+public:
+    explicit SingleInstance(QObject *parent = nullptr);
+    ~SingleInstance() override;
+
+    bool tryLock(); // true - других экземпляров нет (блокировка упавшего процесса снимается)
+    bool listen();
+    static bool sendToRunning(const InstanceRequest &request); // false - экземпляр не ответил
+
+signals:
+    void requestReceived(const InstanceRequest &request);
+
+private slots:
+    void onNewConnection();
+
+private:
+    static QString serverName();
+    static QByteArray encode(const InstanceRequest &request);
+    static bool decode(const QByteArray &payload, InstanceRequest *request);
+    void readMessages(QLocalSocket *socket);
+
+    std::unique_ptr<QLockFile> m_lock;
+    QLocalServer *m_server { nullptr };
+    QHash<QLocalSocket*, QByteArray> m_buffers; // Неполные сообщения по подключениям
+};
@@ -0,0 +1,112 @@
+#include "StartupTrace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QTextStream>
+#include <QWidget>
+
+#include <utility>
+
+namespace {
+QElapsedTimer &clock() {
+    static QElapsedTimer timer;
+    return timer;
+}
+
+QVector<QPair<QString, qint64>> &recordedStages() {
+    static QVector<QPair<QString, qint64>> stages;
+    return stages;
+}
+
+// Фильтр приложения до первой отрисовки окна (или любого его дочернего виджета);
+// после нее снимает себя
+class FirstPaintFilter : public QObject {
+public:
+    FirstPaintFilter(QWidget *window, std::function<void()> onPainted)
+        : QObject(window), m_window(window), m_onPainted(std::move(onPainted)) {
+    }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override {
+        if (event->type() == QEvent::Paint && watched->isWidgetType()) {
+            QWidget *widget = static_cast<QWidget *>(watched);
+            if (widget == m_window || m_window->isAncestorOf(widget)) {
+                StartupTrace::mark(QStringLiteral("first paint"));
+                QCoreApplication::instance()->removeEventFilter(this);
+                deleteLater();
+                if (m_onPainted) {
+                    m_onPainted();
+                }
+            }
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    QWidget *m_window { nullptr };
+    std::function<void()> m_onPainted;
+};
+}
+
+qint64 StartupTrace::s_firstPaintMs = -1;
+qint64 StartupTrace::s_interactiveMs = -1;
+bool StartupTrace::s_reportEnabled = false;
+
+void StartupTrace::start() {
+    clock().start();
+    recordedStages().clear();
+    s_firstPaintMs = -1;
+    s_interactiveMs = -1;
+}
+
+void StartupTrace::mark(const QString &stage) {
+    if (!clock().isValid()) return;
+    const qint64 elapsed = clock().elapsed();
+    recordedStages().append({ stage, elapsed });
+    if (stage == QLatin1String("first paint") && s_firstPaintMs < 0) {
+        s_firstPaintMs = elapsed;
+    }
+}
+
+void StartupTrace::watchFirstPaint(QWidget *window, std::function<void()> onPainted) {
+    if (!window) return;
+    if (s_firstPaintMs >= 0) {
+        if (onPainted) {
+            onPainted();
+        }
+        return;
+    }
+    // Окно может рисоваться целиком дочерними виджетами - фильтр на всё приложение
+    QCoreApplication::instance()->installEventFilter(new FirstPaintFilter(window, std::move(onPainted)));
+}
+
+void StartupTrace::markInteractive() {
+    if (!clock().isValid() || s_interactiveMs >= 0) return;
+    s_interactiveMs = clock().elapsed();
+    recordedStages().append({ QStringLiteral("interactive"), s_interactiveMs });
+    if (s_reportEnabled) {
+        QTextStream(stderr) << report();
+    }
+}
+
+void StartupTrace::setReportEnabled(bool enabled) {
+    s_reportEnabled = enabled;
+}
+
+QString StartupTrace::report() {
+    QString text;
+    QTextStream out(&text);
+    qint64 previous = 0;
+    for (const auto &stage : qAsConst(recordedStages())) {
+        out << stage.first.leftJustified(24) << QString::number(stage.second).rightJustified(7)
+            << " ms  (+" << stage.second - previous << " ms)\n";
+        previous = stage.second;
+    }
+    out.flush();
+    return text;
+}
+
+QVector<QPair<QString, qint64>> StartupTrace::stages() {
+    return recordedStages();
+}
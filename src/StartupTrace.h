@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+class QWidget;
+
+// Замер холодного запуска: время от старта процесса до первой отрисовки окна
+// (time to first paint) и до готовности к работе (time to interactive - окно показано,
+// активная вкладка открыта, отложенная работа запуска поставлена в очередь).
+// Промежуточные этапы отмечаются mark(); все времена - в мс от start().
+// С ключом --startup-trace отчет по этапам выводится в stderr при markInteractive().
+class StartupTrace {
+public:
+    static void start();
+    static void mark(const QString &stage);
+    // Отметка при первой отрисовке окна; onPainted вызывается сразу после нее
+    static void watchFirstPaint(QWidget *window, std::function<void()> onPainted = {});
+    static void markInteractive();
+    static void setReportEnabled(bool enabled);
+    static QString report(); // Этап, время от старта и длительность этапа - по строке на этап
+
+    static qint64 firstPaintMs() { return s_firstPaintMs; }       // -1 - еще не было
+    static qint64 interactiveMs() { return s_interactiveMs; }
+    static QVector<QPair<QString, qint64>> stages();
+
+private:
+    static qint64 s_firstPaintMs;
+    static qint64 s_interactiveMs;
+    static bool s_reportEnabled;
+};
@@ -0,0 +1,162 @@
+#include "SymbolIndex.h"
+
+#include <Qsci/qsciscintilla.h>
+
+namespace {
+constexpr int MIN_IDENTIFIER_LENGTH = 2; // Однобуквенные имена в дополнение не попадают
+
+bool isIdentifierStart(QChar ch) {
+    return ch.isLetter() || ch == QLatin1Char('_');
+}
+
+bool isIdentifierChar(QChar ch) {
+    return ch.isLetterOrNumber() || ch == QLatin1Char('_');
+}
+}
+
+SymbolIndex::SymbolIndex(QsciScintilla *editor)
+    : QObject(editor), m_editor(editor) {
+    connect(m_editor, &QsciScintillaBase::SCN_MODIFIED, this, &SymbolIndex::onModified);
+    rebuild();
+}
+
+QStringList SymbolIndex::identifiersWithPrefix(const QString &prefix, int limit) const {
+    QStringList result;
+    for (auto it = m_counts.lowerBound(prefix); it != m_counts.constEnd(); ++it) {
+        if (!it.key().startsWith(prefix) || (limit >= 0 && result.size() >= limit)) {
+            break;
+        }
+        result.append(it.key());
+    }
+    return result;
+}
+
+void SymbolIndex::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    if (m_enabled) {
+        rebuild();
+        return;
+    }
+    m_lines.clear();
+    m_lines.squeeze();
+    m_counts.clear();
+    ++m_revision;
+}
+
+void SymbolIndex::rebuild() {
+    if (!m_enabled) return;
+    const int lineCount = m_editor->lines();
+    m_lines.clear();
+    m_lines.reserve(lineCount);
+    m_counts.clear();
+    for (int line = 0; line < lineCount; ++line) {
+        m_lines.append(tokenizeLine(line));
+        addLine(m_lines.last());
+    }
+    ++m_revision;
+}
+
+void SymbolIndex::onModified(int position, int modificationType, const char *text, int length,
+                             int linesAdded, int line, int foldNow, int foldPrev, int token,
+                             int annotationLinesAdded) {
+    Q_UNUSED(text);
+    Q_UNUSED(length);
+    Q_UNUSED(line);
+    Q_UNUSED(foldNow);
+    Q_UNUSED(foldPrev);
+    Q_UNUSED(token);
+    Q_UNUSED(annotationLinesAdded);
+
+    if (!(modificationType & (QsciScintillaBase::SC_MOD_INSERTTEXT | QsciScintillaBase::SC_MOD_DELETETEXT))) {
+        return;
+    }
+    ++m_modifications;
+    if (!m_enabled) return;
+
+    // Уведомление приходит после изменения: при вставке строка firstLine изменилась
+    // и после нее появились linesAdded новых, при удалении строки после firstLine
+    // слились с ней
+    const int firstLine = static_cast<int>(
+        m_editor->SendScintilla(QsciScintillaBase::SCI_LINEFROMPOSITION, static_cast<unsigned long>(position)));
+    if (firstLine < 0 || firstLine >= m_lines.size()) {
+        rebuild();
+        return;
+    }
+
+    if (linesAdded > 0) {
+        m_lines.insert(firstLine + 1, linesAdded, QStringList());
+    } else if (linesAdded < 0) {
+        const int removed = qMin(-linesAdded, m_lines.size() - firstLine - 1);
+        for (int i = firstLine + 1; i <= firstLine + removed; ++i) {
+            removeLine(m_lines.at(i));
+        }
+        m_lines.remove(firstLine + 1, removed);
+    }
+
+    if (m_lines.size() != m_editor->lines()) {
+        // Пропущенное уведомление (например, при смене документа) - разбираем заново
+        rebuild();
+        return;
+    }
+
+    const int lastLine = firstLine + qMax(0, linesAdded);
+    for (int i = firstLine; i <= lastLine; ++i) {
+        QStringList identifiers = tokenizeLine(i);
+        if (identifiers == m_lines.at(i)) {
+            continue;
+        }
+        // Сначала добавляем новые вхождения: идентификатор, оставшийся в строке,
+        // не исчезает из индекса даже на время обновления
+        addLine(identifiers);
+        removeLine(m_lines.at(i));
+        m_lines[i] = std::move(identifiers);
+    }
+}
+
+QStringList SymbolIndex::tokenizeLine(int line) const {
+    QStringList identifiers;
+    const QString text = m_editor->text(line);
+    const int length = text.length();
+    int pos = 0;
+    while (pos < length) {
+        const QChar ch = text.at(pos);
+        if (isIdentifierStart(ch)) {
+            const int start = pos;
+            while (pos < length && isIdentifierChar(text.at(pos))) {
+                ++pos;
+            }
+            if (pos - start >= MIN_IDENTIFIER_LENGTH) {
+                identifiers.append(text.mid(start, pos - start));
+            }
+        } else if (ch.isDigit()) {
+            // Числа вроде 0x1F или 1e10 не дают идентификаторов
+            while (pos < length && isIdentifierChar(text.at(pos))) {
+                ++pos;
+            }
+        } else {
+            ++pos;
+        }
+    }
+    return identifiers;
+}
+
+void SymbolIndex::addLine(const QStringList &identifiers) {
+    for (const QString &identifier : identifiers) {
+        int &count = m_counts[identifier];
+        if (count++ == 0) {
+            ++m_revision;
+        }
+    }
+}
+
+void SymbolIndex::removeLine(const QStringList &identifiers) {
+    for (const QString &identifier : identifiers) {
+        auto it = m_counts.find(identifier);
+        if (it == m_counts.end()) continue;
+        if (--it.value() == 0) {
+            m_counts.erase(it);
+            ++m_revision;
+        }
+    }
+}
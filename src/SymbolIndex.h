@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QMap>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+class QsciScintilla;
+
+// Индекс идентификаторов документа для автодополнения по словам файла.
+// Обновляется инкрементально по уведомлениям SCN_MODIFIED: заново разбираются только
+// измененные строки, а для каждого идентификатора хранится число вхождений, поэтому
+// стоимость обновления пропорциональна правке, а не размеру файла.
+// Идентификаторы хранятся отсортированными - поиск по префиксу выполняется бинарным поиском.
+class SymbolIndex : public QObject {
+    Q_OBJECT
+public:
+    explicit SymbolIndex(QsciScintilla *editor);
+
+    // Меняется только при появлении нового или исчезновении последнего вхождения идентификатора
+    quint64 revision() const { return m_revision; }
+    quint64 modificationCount() const { return m_modifications; } // Меняется при любой правке текста
+
+    QStringList identifiers() const { return m_counts.keys(); } // Отсортированы (с учетом регистра)
+    QStringList identifiersWithPrefix(const QString &prefix, int limit = -1) const;
+    int occurrences(const QString &identifier) const { return m_counts.value(identifier); }
+
+    void rebuild(); // Полный разбор документа (при создании и рассинхронизации)
+    // Выключенный индекс пуст и не разбирает правки (большие файлы); счетчик правок идет всегда
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+private slots:
+    void onModified(int position, int modificationType, const char *text, int length,
+                    int linesAdded, int line, int foldNow, int foldPrev, int token,
+                    int annotationLinesAdded);
+
+private:
+    QStringList tokenizeLine(int line) const;
+    void addLine(const QStringList &identifiers);
+    void removeLine(const QStringList &identifiers);
+
+    QsciScintilla *m_editor { nullptr };
+    QVector<QStringList> m_lines;   // Идентификаторы каждой строки документа
+    QMap<QString, int> m_counts;    // Идентификатор -> число вхождений
+    quint64 m_revision { 0 };
+    quint64 m_modifications { 0 };
+    bool m_enabled { true };
+};
@@ -0,0 +1,105 @@
+#include "TracebackParser.h"
+
+namespace {
+constexpr int MAX_FRAMES = 256;          // Сколько последних кадров хранить
+constexpr int MAX_PARTIAL_LINE = 16384;  // Хвост сверхдлинной строки, которого достаточно для ссылки
+
+int skipSpaces(const QString &text, int pos) {
+    while (pos < text.length() && text.at(pos).isSpace()) {
+        ++pos;
+    }
+    return pos;
+}
+}
+
+QVector<TracebackFrame> TracebackParser::parseLine(const QString &line) {
+    QVector<TracebackFrame> result;
+
+    if (line.startsWith(QLatin1String("Traceback (most recent call last)"))) {
+        m_sawTraceback = true;
+        return result;
+    }
+
+    // Формат: File "path", line N[, in function]
+    int from = 0;
+    while (true) {
+        const int fileAt = line.indexOf(QLatin1String("File "), from);
+        if (fileAt < 0) break;
+        from = fileAt + 5;
+
+        int pos = skipSpaces(line, from);
+        if (pos >= line.length()) break;
+        const QChar quote = line.at(pos);
+        if (quote != QLatin1Char('"') && quote != QLatin1Char('\'')) continue;
+        const int pathEnd = line.indexOf(quote, pos + 1);
+        if (pathEnd < 0) break;
+        const QString path = line.mid(pos + 1, pathEnd - pos - 1);
+
+        pos = pathEnd + 1;
+        if (pos >= line.length() || line.at(pos) != QLatin1Char(',')) continue;
+        pos = skipSpaces(line, pos + 1);
+        if (!line.midRef(pos, 4).startsWith(QLatin1String("line"))) continue;
+        pos = skipSpaces(line, pos + 4);
+
+        const int digitsStart = pos;
+        int lineNumber = 0;
+        while (pos < line.length() && line.at(pos).isDigit()) {
+            lineNumber = lineNumber * 10 + line.at(pos).digitValue();
+            ++pos;
+        }
+        if (pos == digitsStart) continue;
+
+        TracebackFrame frame;
+        frame.start = fileAt;
+        frame.length = pos - fileAt;
+        frame.path = path;
+        frame.line = lineNumber;
+
+        // Необязательное ", in function"
+        int tail = pos;
+        if (tail < line.length() && line.at(tail) == QLatin1Char(',')) {
+            tail = skipSpaces(line, tail + 1);
+            if (line.midRef(tail, 3) == QLatin1String("in ")) {
+                frame.function = line.mid(tail + 3).trimmed();
+            }
+        }
+
+        result.append(frame);
+        from = pos;
+    }
+
+    if (!result.isEmpty()) {
+        m_frames += result;
+        if (m_frames.size() > MAX_FRAMES) {
+            m_frames.remove(0, m_frames.size() - MAX_FRAMES);
+        }
+    }
+    return result;
+}
+
+void TracebackParser::feed(const QString &chunk) {
+    int from = 0;
+    while (true) {
+        const int newline = chunk.indexOf(QLatin1Char('\n'), from);
+        if (newline < 0) {
+            m_partialLine += chunk.midRef(from);
+            if (m_partialLine.length() > MAX_PARTIAL_LINE) {
+                m_partialLine.remove(0, m_partialLine.length() - MAX_PARTIAL_LINE);
+            }
+            break;
+        }
+        m_partialLine += chunk.midRef(from, newline - from);
+        if (m_partialLine.endsWith(QLatin1Char('\r'))) {
+            m_partialLine.chop(1);
+        }
+        parseLine(m_partialLine);
+        m_partialLine.clear();
+        from = newline + 1;
+    }
+}
+
+void TracebackParser::reset() {
+    m_partialLine.clear();
+    m_frames.clear();
+    m_sawTraceback = false;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+// Кадр трассировки Python: File "path", line N, in function
+struct TracebackFrame {
+    int start { 0 };    // Позиция начала ссылки в строке вывода
+    int length { 0 };   // Длина ссылки (File "...", line N)
+    QString path;       // Путь к файлу
+    int line { 0 };     // Номер строки в файле (1-based)
+    QString function;   // Имя функции (<module> для верхнего уровня)
+};
+
+// Потоковый распознаватель трассировок Python.
+// Каждая строка вывода разбирается ровно один раз, без регулярных выражений.
+// Незавершенная строка хранится между порциями, поэтому ссылка, разорванная
+// между двумя чтениями, распознается корректно.
+class TracebackParser {
+public:
+    // Разбирает завершенную строку (без '\n') и возвращает найденные ссылки
+    QVector<TracebackFrame> parseLine(const QString &line);
+
+    // Принимает произвольную порцию потока; строки собираются внутри
+    void feed(const QString &chunk);
+
+    // Кадры, найденные с последнего reset() (не более MAX_FRAMES последних)
+    const QVector<TracebackFrame> &frames() const { return m_frames; }
+    bool sawTraceback() const { return m_sawTraceback; }
+    void reset();
+
+private:
+    QString m_partialLine;             // Незавершенная строка из предыдущих порций
+    QVector<TracebackFrame> m_frames;
+    bool m_sawTraceback { false };     // Встречался заголовок "Traceback (most recent call last):"
+};
@@ -9,7 +9,9 @@
 #include <cctype>
 #include <algorithm>
 
-int main(int argc, char *argv[])
+// Показывает диалог по аргументам (-e расширение, -d папка, -s, --dir).
+// false - неверные аргументы или выбор отменен
+static bool pickPath(const std::vector<std::string> &args, std::string &resultPath)
 {
     // Парсим аргументы командной строки
     std::string extension; // Обязательный параметр
@@ -17,15 +19,15 @@ int main(int argc, char *argv[])
     bool isSave = false;
     bool isDirectory = false;
     
-    for (int i = 1; i < argc; i++) {
-        std::string arg = argv[i];
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string &arg = args[i];
         if (arg == "-e" || arg == "--ext" || arg == "--extension") {
-            if (i + 1 < argc) {
-                extension = argv[++i];
+            if (i + 1 < args.size()) {
+                extension = args[++i];
             }
         } else if (arg == "-d" || arg == "--directory") {
-            if (i + 1 < argc) {
-                initialDir = argv[++i];
+            if (i + 1 < args.size()) {
+                initialDir = args[++i];
             }
         } else if (arg == "-s" || arg == "--save") {
             isSave = true;
@@ -36,7 +38,7 @@ int main(int argc, char *argv[])
     
     // Расширение обязательно
     if (extension.empty()) {
-        return 1; // Завершаем с ошибкой, если расширение не указано
+        return false;
     }
     
     // Нормализуем расширение (добавляем точку, если её нет)
@@ -64,7 +66,7 @@ int main(int argc, char *argv[])
     // Формируем паттерн фильтра
     std::string pattern = "*" + extension;
     
-    std::string resultPath;
+    resultPath.clear();
     
     if (isDirectory) {
         // Используем SHBrowseForFolderW для выбора папки (Unicode версия)
@@ -223,8 +225,45 @@ int main(int argc, char *argv[])
         }
     }
     
+    return !resultPath.empty();
+}
+
+int main(int argc, char *argv[])
+{
+    // Диалог выбора папки использует оболочку Windows (COM)
+    CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
+    
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        // Постоянный режим для IDE: строка запроса (аргументы через табуляцию) из stdin,
+        // строка с путем в stdout; пустая строка - отмена. Завершение - по закрытию stdin
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            std::vector<std::string> args;
+            size_t start = 0;
+            while (start <= line.size()) {
+                const size_t tab = line.find('\t', start);
+                const size_t end = tab == std::string::npos ? line.size() : tab;
+                args.push_back(line.substr(start, end - start));
+                start = end + 1;
+            }
+            std::string resultPath;
+            pickPath(args, resultPath);
+            std::cout << resultPath << std::endl;
+        }
+        CoUninitialize();
+        return 0;
+    }
+    
+    std::vector<std::string> args(argv + 1, argv + argc);
+    std::string resultPath;
+    const bool picked = pickPath(args, resultPath);
+    CoUninitialize();
+    
     // Выводим результат в stdout
-    if (!resultPath.empty()) {
+    if (picked) {
         std::cout << resultPath;
         return 0;
     }
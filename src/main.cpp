@@ -5,10 +5,10 @@
 #include <QSettings>
 #include <QDir>
 #include <QFileInfo>
-#include <QLocalSocket>
-#include <QLocalServer>
 #include <QMessageBox>
 #include "MainWindow.h"
+#include "SingleInstance.h"
+#include "StartupTrace.h"
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -20,7 +20,61 @@
 #include <crtdbg.h>
 #endif
 
+namespace {
+// Файлы из командной строки. Пути абсолютные - их может открывать и уже запущенный
+// экземпляр с другой текущей папкой; "путь:строка" открывает файл на этой строке
+QVector<InstanceFile> commandLineFiles(const QCommandLineParser &parser) {
+    QStringList arguments;
+#ifdef Q_OS_WIN
+    // Используем Windows API для правильной обработки аргументов (как в 7zip)
+    Q_UNUSED(parser);
+    int argCount;
+    LPWSTR *argList = CommandLineToArgvW(GetCommandLineW(), &argCount);
+    if (argList) {
+        // Пропускаем первый аргумент (путь к exe)
+        for (int i = 1; i < argCount; ++i) {
+            arguments.append(QString::fromWCharArray(argList[i]));
+        }
+        LocalFree(argList);
+    }
+#else
+    arguments = parser.positionalArguments();
+#endif
+    
+    QVector<InstanceFile> files;
+    for (const QString &argument : arguments) {
+        // Удаляем кавычки, если они есть (Windows может передавать пути в кавычках)
+        QString filePath = argument.trimmed();
+        if (filePath.startsWith('"') && filePath.endsWith('"')) {
+            filePath = filePath.mid(1, filePath.length() - 2);
+        }
+        if (filePath.isEmpty()) continue;
+        filePath = QDir::toNativeSeparators(QDir::cleanPath(filePath));
+        
+        InstanceFile file;
+        QFileInfo fileInfo(filePath);
+        if (!fileInfo.isFile()) {
+            const int colon = filePath.lastIndexOf(':');
+            bool isNumber = false;
+            const int line = colon > 0 ? filePath.mid(colon + 1).toInt(&isNumber) : 0;
+            if (isNumber && line > 0 && QFileInfo(filePath.left(colon)).isFile()) {
+                fileInfo = QFileInfo(filePath.left(colon));
+                file.line = line;
+            } else if (!filePath.contains('/') && !filePath.contains('\\') && !filePath.endsWith(".py")) {
+                // Значения ключей (--theme dark) - не файлы. Несуществующий путь к файлу
+                // пропускаем дальше: пользователь увидит сообщение об ошибке
+                continue;
+            }
+        }
+        file.path = QDir::toNativeSeparators(fileInfo.absoluteFilePath());
+        files.append(file);
+    }
+    return files;
+}
+}
+
 int main(int argc, char *argv[]) {
+    StartupTrace::start();
 #ifdef _DEBUG
     // Включаем обнаружение утечек памяти
     _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
@@ -33,71 +87,39 @@ int main(int argc, char *argv[]) {
     QApplication::setApplicationName("Vuzhyk");
     QApplication::setOrganizationName("Vuzhyk");
     QApplication::setWindowIcon(QIcon(":/icons/icons/logo/vuzhyk.ico"));
+    StartupTrace::mark(QStringLiteral("application"));
 
-    // Проверяем, не запущен ли уже экземпляр приложения
-    QString serverName = "VuzhykIDE_SingleInstance";
-    QLocalSocket socket;
-    socket.connectToServer(serverName);
-    
-    // Если подключение успешно, значит уже есть запущенный экземпляр
-    if (socket.waitForConnected(500)) {
-        // Собираем пути к файлам для открытия
-        QStringList filePaths;
-        
-        // Обрабатываем аргументы командной строки (файлы для открытия)
-#ifdef Q_OS_WIN
-        int argCount;
-        LPWSTR *argList = CommandLineToArgvW(GetCommandLineW(), &argCount);
-        if (argList && argCount > 1) {
-            for (int i = 1; i < argCount; ++i) {
-                QString filePath = QString::fromWCharArray(argList[i]);
-                filePath = filePath.trimmed();
-                if (filePath.startsWith('"') && filePath.endsWith('"')) {
-                    filePath = filePath.mid(1, filePath.length() - 2);
-                }
-                filePath = QDir::toNativeSeparators(QDir::cleanPath(filePath));
-                if (!filePath.isEmpty() && (filePath.contains('/') || filePath.contains('\\') || filePath.endsWith(".py"))) {
-                    filePaths.append(filePath);
-                }
-            }
-            LocalFree(argList);
-        }
-#else
-        QCommandLineParser parser;
-        parser.addPositionalArgument("file", QCoreApplication::translate("main", "File to open"));
-        parser.process(app);
-        QStringList positionalArgs = parser.positionalArguments();
-        for (const QString &arg : positionalArgs) {
-            QString cleanPath = arg.trimmed();
-            if (cleanPath.startsWith('"') && cleanPath.endsWith('"')) {
-                cleanPath = cleanPath.mid(1, cleanPath.length() - 2);
-            }
-            cleanPath = QDir::toNativeSeparators(QDir::cleanPath(cleanPath));
-            if (!cleanPath.isEmpty()) {
-                filePaths.append(cleanPath);
-            }
-        }
-#endif
-        
-        // Отправляем пути к файлам в существующий экземпляр
-        if (!filePaths.isEmpty()) {
-            QByteArray data = filePaths.join('\n').toUtf8();
-            socket.write(data);
-            socket.waitForBytesWritten(1000);
-        }
-        socket.disconnectFromServer();
-        return 0; // Завершаем новый экземпляр
-    }
-    
-    // Если подключение не удалось, значит это первый экземпляр - продолжаем запуск
     QCommandLineParser parser;
     parser.setApplicationDescription("Vuzhyk IDE");
     QCommandLineOption themeOption(QStringList() << "t" << "theme",
                                    QCoreApplication::translate("main", "Theme: light or dark"),
                                    QCoreApplication::translate("main", "theme"));
     parser.addOption(themeOption);
+    const QCommandLineOption startupTraceOption("startup-trace",
+                                                QCoreApplication::translate("main", "Print startup stage timings to stderr"));
+    parser.addOption(startupTraceOption);
     parser.addPositionalArgument("file", QCoreApplication::translate("main", "File to open"));
     parser.process(app);
+    StartupTrace::setReportEnabled(parser.isSet(startupTraceOption));
+    const QVector<InstanceFile> files = commandLineFiles(parser);
+
+    // Проверяем, не запущен ли уже экземпляр приложения: занятая блокировка видна
+    // сразу, поэтому первый запуск не ждет подключения к несуществующему серверу
+    SingleInstance instance;
+    const bool isFirstInstance = instance.tryLock();
+    if (!isFirstInstance) {
+        InstanceRequest request;
+        request.action = files.isEmpty() ? QStringLiteral("activate") : QStringLiteral("open");
+        request.files = files;
+        if (SingleInstance::sendToRunning(request)) {
+            return 0; // Файлы откроет запущенный экземпляр
+        }
+        // Владелец блокировки не отвечает - работаем отдельно
+    } else {
+        // Запросы, пришедшие до создания окна, ждут в очереди цикла событий
+        instance.listen();
+    }
+    StartupTrace::mark(QStringLiteral("single instance check"));
 
     QString theme = parser.value(themeOption);
     
@@ -108,60 +130,12 @@ int main(int argc, char *argv[]) {
     }
 
     MainWindow w(theme);
-    
-    // Обрабатываем аргументы командной строки (файлы для открытия)
-    // Используем Windows API для правильной обработки аргументов (как в 7zip)
-#ifdef Q_OS_WIN
-    int argCount;
-    LPWSTR *argList = CommandLineToArgvW(GetCommandLineW(), &argCount);
-    if (argList && argCount > 1) {
-        // Пропускаем первый аргумент (путь к exe) и обрабатываем остальные
-        for (int i = 1; i < argCount; ++i) {
-            QString filePath = QString::fromWCharArray(argList[i]);
-            
-            // Удаляем кавычки, если они есть (Windows может передавать пути в кавычках)
-            filePath = filePath.trimmed();
-            if (filePath.startsWith('"') && filePath.endsWith('"')) {
-                filePath = filePath.mid(1, filePath.length() - 2);
-            }
-            
-            // Нормализуем путь
-            filePath = QDir::toNativeSeparators(QDir::cleanPath(filePath));
-            
-            // Проверяем, что это путь к файлу
-            if (!filePath.isEmpty()) {
-                QFileInfo fileInfo(filePath);
-                if (fileInfo.exists() && fileInfo.isFile()) {
-                    w.openFileFromPath(fileInfo.absoluteFilePath());
-                } else {
-                    // Пытаемся открыть даже если файл не найден (может быть относительный путь)
-                    // Но только если путь выглядит как путь к файлу
-                    if (filePath.contains('/') || filePath.contains('\\') || filePath.endsWith(".py")) {
-                        w.openFileFromPath(filePath);
-                    }
-                }
-            }
-        }
-        LocalFree(argList);
-    }
-#else
-    // Для не-Windows используем стандартный способ Qt
-    QStringList positionalArgs = parser.positionalArguments();
-    for (const QString &arg : positionalArgs) {
-        QString cleanPath = arg.trimmed();
-        if (cleanPath.startsWith('"') && cleanPath.endsWith('"')) {
-            cleanPath = cleanPath.mid(1, cleanPath.length() - 2);
-        }
-        cleanPath = QDir::toNativeSeparators(QDir::cleanPath(cleanPath));
-        QFileInfo fileInfo(cleanPath);
-        if (fileInfo.exists() && fileInfo.isFile()) {
-            w.openFileFromPath(fileInfo.absoluteFilePath());
-        }
-    }
-#endif
+    StartupTrace::mark(QStringLiteral("main window"));
+    QObject::connect(&instance, &SingleInstance::requestReceived, &w, &MainWindow::handleInstanceRequest);
+    // Прошлый сеанс - до файлов из командной строки, чтобы они открылись поверх него
+    w.restoreSession();
+    w.openInstanceFiles(files);
     
     w.show();
     return app.exec();
 }
-
-
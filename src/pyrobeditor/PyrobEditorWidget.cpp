@@ -1353,64 +1353,69 @@ QString PyrobEditorWidget::defaultTasksDirectory() const
 void PyrobEditorWidget::openProject()
 {
 	if (!maybeSave()) return;
-	QString path = showFilePicker(trKey("project_filter"), defaultTasksDirectory(), false, false);
-	if (path.isEmpty()) return;
-	if (loadFromFile(path)) {
-		m_currentProjectPath = path;
-	}
+	pickFile(trKey("project_filter"), defaultTasksDirectory(), false, [this](const QString &path) {
+		// Пока диалог был открыт, проект могли изменить - спрашиваем еще раз перед заменой
+		if (!maybeSave()) return;
+		if (loadFromFile(path)) {
+			m_currentProjectPath = path;
+		}
+	});
 }
 
 void PyrobEditorWidget::saveProject()
 {
-	QString path = m_currentProjectPath;
-	if (path.isEmpty()) {
-        path = showFilePicker(trKey("project_filter"), defaultTasksDirectory(), true, false);
-		if (path.isEmpty()) return;
-		if (!path.endsWith(".pyrob.json")) path += ".pyrob.json";
-	}
-	if (saveToFile(path)) {
-		m_currentProjectPath = path;
+	if (!m_currentProjectPath.isEmpty()) {
+		saveToFile(m_currentProjectPath);
+		return;
 	}
+	pickFile(trKey("project_filter"), defaultTasksDirectory(), true, [this](const QString &selectedPath) {
+		QString path = selectedPath;
+		if (!path.endsWith(".pyrob.json")) path += ".pyrob.json";
+		if (saveToFile(path)) {
+			m_currentProjectPath = path;
+		}
+	});
 }
 
 void PyrobEditorWidget::exportPython()
 {
-    QString path = showFilePicker(trKey("python_filter"), defaultTasksDirectory(), true, false);
-	if (path.isEmpty()) return;
-	if (!path.endsWith(".py")) path += ".py";
-	QString baseName = QFileInfo(path).baseName();
-	QString py = m_model->generatePythonTask(baseName);
-	QFile f(path);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
-        QMessageBox::warning(this, trKey("error"), trKey("cannot_write"));
-		return;
-	}
-	f.write(py.toUtf8());
-	f.close();
-    m_currentTaskPath = path;
-	QMessageBox::information(this, tr("Экспорт"), tr("Задача Python экспортирована."));
+	pickFile(trKey("python_filter"), defaultTasksDirectory(), true, [this](const QString &selectedPath) {
+		QString path = selectedPath;
+		if (!path.endsWith(".py")) path += ".py";
+		if (writeTask(path)) {
+			QMessageBox::information(this, tr("Экспорт"), tr("Задача Python экспортирована."));
+		}
+	});
 }
 
 void PyrobEditorWidget::saveTask()
 {
-    QString path = m_currentTaskPath;
-    if (path.isEmpty()) {
-        QString defaultDir = defaultTasksDirectory();
-        QString suggested = QDir(defaultDir).filePath("task_1_1.py");
-        path = showFilePicker(trKey("python_filter"), suggested, true, false);
-        if (path.isEmpty()) return;
-        if (!path.endsWith(".py")) path += ".py";
+    if (!m_currentTaskPath.isEmpty()) {
+        writeTask(m_currentTaskPath);
+        return;
     }
+    QString defaultDir = defaultTasksDirectory();
+    QString suggested = QDir(defaultDir).filePath("task_1_1.py");
+    pickFile(trKey("python_filter"), suggested, true, [this](const QString &selectedPath) {
+        QString path = selectedPath;
+        if (!path.endsWith(".py")) path += ".py";
+        writeTask(path);
+    });
+}
+
+bool PyrobEditorWidget::writeTask(const QString &path)
+{
     QString baseName = QFileInfo(path).baseName();
     QString py = m_model->generatePythonTask(baseName);
     QFile f(path);
     if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
         QMessageBox::warning(this, trKey("error"), trKey("cannot_write"));
-        return;
+        return false;
     }
     f.write(py.toUtf8());
     f.close();
     m_currentTaskPath = path;
+    return true;
 }
 
 void PyrobEditorWidget::gridSizeChanged()
@@ -1517,10 +1522,10 @@ bool PyrobEditorWidget::loadFromFile(const QString &path)
 	return ok;
 }
 
-QString PyrobEditorWidget::showFilePicker(const QString &filter, const QString &initialDir, bool isSave, bool isDirectory)
+MainWindow *PyrobEditorWidget::mainWindow()
 {
 	if (m_mainWindow) {
-		return m_mainWindow->showFilePicker(filter, initialDir, isSave, isDirectory);
+		return m_mainWindow;
 	}
 	
 	// Если указатель не сохранен, ищем MainWindow через цепочку родителей
@@ -1529,7 +1534,7 @@ QString PyrobEditorWidget::showFilePicker(const QString &filter, const QString &
 		MainWindow *mainWindow = qobject_cast<MainWindow*>(p);
 		if (mainWindow) {
 			m_mainWindow = mainWindow; // Сохраняем для будущих вызовов
-			return mainWindow->showFilePicker(filter, initialDir, isSave, isDirectory);
+			return mainWindow;
 		}
 		p = p->parentWidget();
 	}
@@ -1540,11 +1545,26 @@ QString PyrobEditorWidget::showFilePicker(const QString &filter, const QString &
 		MainWindow *mainWindow = qobject_cast<MainWindow*>(widget);
 		if (mainWindow) {
 			m_mainWindow = mainWindow; // Сохраняем для будущих вызовов
-			return mainWindow->showFilePicker(filter, initialDir, isSave, isDirectory);
+			return mainWindow;
 		}
 	}
 	
-	return QString();
+	return nullptr;
+}
+
+void PyrobEditorWidget::pickFile(const QString &filter, const QString &initialDir, bool isSave,
+                                 std::function<void(const QString &)> onPicked)
+{
+	// Общий помощник выбора файлов MainWindow. Диалог не блокирует окно - редактор
+	// могут закрыть, пока он открыт
+	MainWindow *window = mainWindow();
+	if (!window) return;
+	QPointer<PyrobEditorWidget> self = this;
+	window->pickFile(filter, initialDir, isSave, false, [self, onPicked](const QString &path) {
+		if (self && !path.isEmpty()) {
+			onPicked(path);
+		}
+	});
 }
 
 QString PyrobEditorWidget::trKey(const char *key) const
@@ -4,6 +4,8 @@
 #include <QWidget>
 #include <QPointer>
 
+#include <functional>
+
 class GridEditor;
 class ProjectModel;
 class QToolBar;
@@ -51,7 +53,11 @@ private:
 	bool maybeSave();
 	bool saveToFile(const QString &path);
 	bool loadFromFile(const QString &path);
-	QString showFilePicker(const QString &filter, const QString &initialDir = QString(), bool isSave = false, bool isDirectory = false);
+	MainWindow *mainWindow();
+	// Асинхронный выбор файла; onPicked вызывается, только если путь выбран и виджет еще существует
+	void pickFile(const QString &filter, const QString &initialDir, bool isSave,
+	              std::function<void(const QString &)> onPicked);
+	bool writeTask(const QString &path);
 
 private:
 	QPointer<GridEditor> m_editor;
@@ -3,14 +3,67 @@
 
 #include <QMouseEvent>
 #include <QGraphicsScene>
-#include <QGraphicsRectItem>
-#include <QGraphicsLineItem>
+#include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
 #include <QPainter>
 #include <QPalette>
+#include <QTimer>
+
+namespace {
+constexpr int FRAME_INTERVAL_MS = 16; // Правки при перетаскивании собираются в одну перерисовку за кадр
+constexpr qreal MIN_CELL_SIZE = 16.0;
+
+QColor cellColor(ProjectModel::CellType type, bool dark)
+{
+	if (dark) {
+		switch (type) {
+		case ProjectModel::Empty: return QColor(50, 50, 50);
+		case ProjectModel::ToBeFilled: return QColor(80, 140, 135);
+		case ProjectModel::FilledInitial: return QColor(140, 130, 100);
+		}
+	} else {
+		switch (type) {
+		case ProjectModel::Empty: return QColor(255, 255, 255);
+		case ProjectModel::ToBeFilled: return QColor(161, 220, 216);
+		case ProjectModel::FilledInitial: return QColor(255, 248, 209);
+		}
+	}
+	return QColor(255, 255, 255);
+}
+}
+
+// Единственный элемент сцены: рисует поле из модели через GridEditor::paintGrid
+class GridEditor::GridItem : public QGraphicsItem
+{
+public:
+	explicit GridItem(const GridEditor *editor)
+		: m_editor(editor)
+	{
+		// exposedRect нужен, чтобы перерисовывать только затронутые клетки
+		setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+	}
+
+	QRectF boundingRect() const override { return m_editor->gridBounds(); }
+
+	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *) override
+	{
+		m_editor->paintGrid(painter, option->exposedRect);
+	}
+
+	// Вызывается до изменения размеров поля
+	void aboutToResize() { prepareGeometryChange(); }
+
+private:
+	const GridEditor *m_editor;
+};
 
 GridEditor::GridEditor(QWidget *parent)
 	: QGraphicsView(parent)
 	, m_scene(new QGraphicsScene(this))
+	, m_gridItem(new GridItem(this))
+	, m_syncTimer(new QTimer(this))
+	, m_renderedRows(0)
+	, m_renderedCols(0)
 	, m_model(nullptr)
 	, m_tool(PaintEmpty)
 	, m_cellSize(32.0)
@@ -21,12 +74,19 @@ GridEditor::GridEditor(QWidget *parent)
 	, m_lastCj(-1)
 	, m_lastEdge(-1)
 {
+	// Элемент один - индекс сцены не нужен
+	m_scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+	m_scene->addItem(m_gridItem);
 	setScene(m_scene);
 	m_gridPen.setWidthF(1.0);
 	m_wallPen.setWidthF(3.0);
 	setRenderHint(QPainter::Antialiasing, false);
 	setMouseTracking(true);
 	setAutoFillBackground(true);
+
+	m_syncTimer->setSingleShot(true);
+	m_syncTimer->setInterval(FRAME_INTERVAL_MS);
+	connect(m_syncTimer, &QTimer::timeout, this, &GridEditor::syncWithModel);
 }
 
 GridEditor::~GridEditor() {
@@ -34,6 +94,7 @@ GridEditor::~GridEditor() {
 }
 
 void GridEditor::clear() {
+	m_syncTimer->stop();
 	// Отключаем все связи
 	if (m_model) {
 		m_model->disconnect(this);
@@ -50,6 +111,7 @@ void GridEditor::clear() {
 				delete item;
 			}
 		}
+		m_gridItem = nullptr;
 		// Очищаем сцену
 		m_scene->clear();
 		// Удаляем сцену из view
@@ -66,16 +128,14 @@ void GridEditor::setModel(ProjectModel *model)
 	if (m_model) {
 		m_model->disconnect(this);
 	}
+	m_syncTimer->stop();
 	m_model = model;
 	if (m_model) {
-		connect(m_model, &ProjectModel::changed, this, &GridEditor::rebuildScene);
-		rebuildScene();
-	} else {
-		// Если модель удалена, очищаем сцену
-		if (m_scene) {
-			m_scene->clear();
-		}
+		connect(m_model, &ProjectModel::changed, this, &GridEditor::scheduleSync);
 	}
+	// Без модели поле пустое (boundingRect нулевой)
+	takeSnapshot();
+	relayout();
 }
 
 void GridEditor::setTool(GridEditor::Tool tool)
@@ -104,14 +164,17 @@ void GridEditor::setTheme(const QString &theme)
 		setPalette(palette);
 		setStyleSheet("QGraphicsView { background-color: #ffffff; border: none; }");
 	}
-	rebuildScene();
+	// Геометрия не меняется - достаточно перерисовать поле новыми цветами
+	if (m_gridItem) {
+		m_gridItem->update();
+	}
 	update();
 }
 
 void GridEditor::resizeEvent(QResizeEvent *event)
 {
 	QGraphicsView::resizeEvent(event);
-	rebuildScene();
+	relayout();
 }
 
 QPointF GridEditor::cellTopLeft(int i, int j) const
@@ -141,63 +204,61 @@ bool GridEditor::pickCellAndEdge(const QPointF &pos, int &ci, int &cj, int &edge
 	return true;
 }
 
-void GridEditor::rebuildScene()
+QRectF GridEditor::gridBounds() const
+{
+	if (!m_model || m_renderedRows <= 0 || m_renderedCols <= 0) return QRectF();
+	// Толстая рамка рисуется по краю поля и выходит за него на половину толщины
+	const qreal margin = m_wallPen.widthF();
+	return QRectF(0, 0, m_renderedCols * m_cellSize, m_renderedRows * m_cellSize)
+		.adjusted(-margin, -margin, margin, margin);
+}
+
+void GridEditor::paintGrid(QPainter *painter, const QRectF &exposed) const
 {
-	m_scene->clear();
 	if (!m_model) return;
-	// fit cell size
-	int r = m_model->rows();
-	int c = m_model->cols();
-	QSizeF avail = viewport()->size();
-	m_cellSize = qMax<qreal>(16.0, qMin((avail.width()-2.0)/c, (avail.height()-2.0)/r));
-	m_scene->setSceneRect(0, 0, c*m_cellSize, r*m_cellSize);
-
-		// draw cells
-	for (int i = 0; i < r; ++i) {
-		for (int j = 0; j < c; ++j) {
-			QRectF rc = cellRect(i, j);
-			QColor fill(255,255,255);
-			if (m_theme == "dark") {
-				switch (m_model->cellType(i,j)) {
-				case ProjectModel::Empty: fill = QColor(50, 50, 50); break;
-				case ProjectModel::ToBeFilled: fill = QColor(80, 140, 135); break;
-				case ProjectModel::FilledInitial: fill = QColor(140, 130, 100); break;
-				}
-			} else {
-				switch (m_model->cellType(i,j)) {
-				case ProjectModel::Empty: fill = QColor(255,255,255); break;
-				case ProjectModel::ToBeFilled: fill = QColor(161,220,216); break;
-				case ProjectModel::FilledInitial: fill = QColor(255,248,209); break;
-				}
-			}
-			QGraphicsRectItem *cell = m_scene->addRect(rc, Qt::NoPen, QBrush(fill));
-			cell->setZValue(-2);
+	// Размер поля - как при последней синхронизации: до нее геометрия сцены еще старая
+	const int r = qMin(m_renderedRows, m_model->rows());
+	const int c = qMin(m_renderedCols, m_model->cols());
+	if (r <= 0 || c <= 0) return;
+
+	// Клетки, задетые открытой областью, и соседние: стены выходят за край клетки
+	const qreal margin = m_wallPen.widthF();
+	const int i0 = qBound(0, static_cast<int>((exposed.top() - margin) / m_cellSize), r - 1);
+	const int i1 = qBound(0, static_cast<int>((exposed.bottom() + margin) / m_cellSize), r - 1);
+	const int j0 = qBound(0, static_cast<int>((exposed.left() - margin) / m_cellSize), c - 1);
+	const int j1 = qBound(0, static_cast<int>((exposed.right() + margin) / m_cellSize), c - 1);
+	const bool dark = (m_theme == "dark");
+
+	// cells
+	for (int i = i0; i <= i1; ++i) {
+		for (int j = j0; j <= j1; ++j) {
+			painter->fillRect(cellRect(i, j), cellColor(m_model->cellType(i, j), dark));
 		}
 	}
 
-	// draw grid lines
-	for (int i = 0; i <= r; ++i) {
-		m_scene->addLine(0, i*m_cellSize, c*m_cellSize, i*m_cellSize, m_gridPen)->setZValue(-1);
+	// grid lines
+	painter->setPen(m_gridPen);
+	for (int i = i0; i <= i1 + 1; ++i) {
+		painter->drawLine(QLineF(j0*m_cellSize, i*m_cellSize, (j1+1)*m_cellSize, i*m_cellSize));
 	}
-	for (int j = 0; j <= c; ++j) {
-		m_scene->addLine(j*m_cellSize, 0, j*m_cellSize, r*m_cellSize, m_gridPen)->setZValue(-1);
+	for (int j = j0; j <= j1 + 1; ++j) {
+		painter->drawLine(QLineF(j*m_cellSize, i0*m_cellSize, j*m_cellSize, (i1+1)*m_cellSize));
 	}
 
 	// outer border stronger
-	m_scene->addLine(0, 0, c*m_cellSize, 0, m_wallPen);
-	m_scene->addLine(0, r*m_cellSize, c*m_cellSize, r*m_cellSize, m_wallPen);
-	m_scene->addLine(0, 0, 0, r*m_cellSize, m_wallPen);
-	m_scene->addLine(c*m_cellSize, 0, c*m_cellSize, r*m_cellSize, m_wallPen);
-
-	// draw interior walls (right/bottom)
-	for (int i = 0; i < r; ++i) {
-		for (int j = 0; j < c; ++j) {
+	painter->setPen(m_wallPen);
+	painter->setBrush(Qt::NoBrush);
+	painter->drawRect(QRectF(0, 0, c*m_cellSize, r*m_cellSize));
+
+	// interior walls (right/bottom)
+	for (int i = i0; i <= i1; ++i) {
+		for (int j = j0; j <= j1; ++j) {
 			QRectF rc = cellRect(i, j);
 			if (j < c-1 && m_model->wall(i, j, ProjectModel::Right)) {
-				m_scene->addLine(rc.right(), rc.top(), rc.right(), rc.bottom(), m_wallPen);
+				painter->drawLine(QLineF(rc.right(), rc.top(), rc.right(), rc.bottom()));
 			}
 			if (i < r-1 && m_model->wall(i, j, ProjectModel::Bottom)) {
-				m_scene->addLine(rc.left(), rc.bottom(), rc.right(), rc.bottom(), m_wallPen);
+				painter->drawLine(QLineF(rc.left(), rc.bottom(), rc.right(), rc.bottom()));
 			}
 		}
 	}
@@ -205,18 +266,120 @@ void GridEditor::rebuildScene()
 	// start and parking markers
 	if (m_model->hasStart()) {
 		QPoint st = m_model->startCell();
-		QRectF rc = cellRect(st.x(), st.y());
-		QRectF inner(rc.adjusted(6,6,-6,-6));
-		QPen pen(m_theme == "dark" ? QColor(100, 150, 255) : Qt::blue); pen.setWidth(2);
-		m_scene->addEllipse(inner, pen, Qt::NoBrush);
+		QRectF inner(cellRect(st.x(), st.y()).adjusted(6,6,-6,-6));
+		if (inner.intersects(exposed)) {
+			QPen pen(dark ? QColor(100, 150, 255) : Qt::blue); pen.setWidth(2);
+			painter->setPen(pen);
+			painter->setBrush(Qt::NoBrush);
+			painter->drawEllipse(inner);
+		}
 	}
 	if (m_model->hasParking()) {
 		QPoint pk = m_model->parkingCell();
-		QRectF rc = cellRect(pk.x(), pk.y());
-		QRectF inner(rc.adjusted(10,10,-10,-10));
-		QColor parkingColor = m_theme == "dark" ? QColor(200, 200, 200) : Qt::black;
-		m_scene->addEllipse(inner, Qt::NoPen, QBrush(parkingColor));
+		QRectF inner(cellRect(pk.x(), pk.y()).adjusted(10,10,-10,-10));
+		if (inner.intersects(exposed)) {
+			painter->setPen(Qt::NoPen);
+			painter->setBrush(dark ? QColor(200, 200, 200) : Qt::black);
+			painter->drawEllipse(inner);
+		}
+	}
+}
+
+void GridEditor::scheduleSync()
+{
+	// Сигналы changed() за кадр (перетаскивание, очистка клетки правой кнопкой) - одна синхронизация
+	if (!m_syncTimer->isActive()) {
+		m_syncTimer->start();
+	}
+}
+
+void GridEditor::takeSnapshot()
+{
+	m_rendered = ProjectModel::VariantState();
+	m_renderedRows = m_model ? m_model->rows() : 0;
+	m_renderedCols = m_model ? m_model->cols() : 0;
+	if (!m_model) return;
+	m_rendered.cells = QVector<QVector<ProjectModel::CellType>>(m_renderedRows, QVector<ProjectModel::CellType>(m_renderedCols, ProjectModel::Empty));
+	m_rendered.wallRight = QVector<QVector<bool>>(m_renderedRows, QVector<bool>(m_renderedCols, false));
+	m_rendered.wallBottom = QVector<QVector<bool>>(m_renderedRows, QVector<bool>(m_renderedCols, false));
+	for (int i = 0; i < m_renderedRows; ++i) {
+		for (int j = 0; j < m_renderedCols; ++j) {
+			m_rendered.cells[i][j] = m_model->cellType(i, j);
+			m_rendered.wallRight[i][j] = m_model->wall(i, j, ProjectModel::Right);
+			m_rendered.wallBottom[i][j] = m_model->wall(i, j, ProjectModel::Bottom);
+		}
+	}
+	m_rendered.hasStart = m_model->hasStart();
+	m_rendered.start = m_model->startCell();
+	m_rendered.hasParking = m_model->hasParking();
+	m_rendered.parking = m_model->parkingCell();
+}
+
+void GridEditor::syncWithModel()
+{
+	m_syncTimer->stop();
+	if (!m_gridItem) return;
+	if (!m_model || m_model->rows() != m_renderedRows || m_model->cols() != m_renderedCols) {
+		// Поле изменило размер - новая геометрия и полная перерисовка
+		takeSnapshot();
+		relayout();
+		return;
+	}
+
+	// Область клетки с запасом на стены и рамку вокруг нее
+	const qreal margin = m_wallPen.widthF();
+	auto invalidateCell = [this, margin](int i, int j) {
+		m_gridItem->update(cellRect(i, j).adjusted(-margin, -margin, margin, margin));
+	};
+
+	for (int i = 0; i < m_renderedRows; ++i) {
+		for (int j = 0; j < m_renderedCols; ++j) {
+			const ProjectModel::CellType type = m_model->cellType(i, j);
+			if (m_rendered.cells[i][j] != type) {
+				m_rendered.cells[i][j] = type;
+				invalidateCell(i, j);
+			}
+			const bool right = m_model->wall(i, j, ProjectModel::Right);
+			if (m_rendered.wallRight[i][j] != right) {
+				m_rendered.wallRight[i][j] = right;
+				invalidateCell(i, j);
+			}
+			const bool bottom = m_model->wall(i, j, ProjectModel::Bottom);
+			if (m_rendered.wallBottom[i][j] != bottom) {
+				m_rendered.wallBottom[i][j] = bottom;
+				invalidateCell(i, j);
+			}
+		}
+	}
+
+	// Маркер переместился или исчез - перерисовываем старую и новую клетку
+	if (m_rendered.hasStart != m_model->hasStart() || m_rendered.start != m_model->startCell()) {
+		if (m_rendered.hasStart) invalidateCell(m_rendered.start.x(), m_rendered.start.y());
+		m_rendered.hasStart = m_model->hasStart();
+		m_rendered.start = m_model->startCell();
+		if (m_rendered.hasStart) invalidateCell(m_rendered.start.x(), m_rendered.start.y());
+	}
+	if (m_rendered.hasParking != m_model->hasParking() || m_rendered.parking != m_model->parkingCell()) {
+		if (m_rendered.hasParking) invalidateCell(m_rendered.parking.x(), m_rendered.parking.y());
+		m_rendered.hasParking = m_model->hasParking();
+		m_rendered.parking = m_model->parkingCell();
+		if (m_rendered.hasParking) invalidateCell(m_rendered.parking.x(), m_rendered.parking.y());
+	}
+}
+
+void GridEditor::relayout()
+{
+	if (!m_scene || !m_gridItem) return;
+	m_gridItem->aboutToResize();
+	if (m_model && m_renderedRows > 0 && m_renderedCols > 0) {
+		// fit cell size
+		QSizeF avail = viewport()->size();
+		m_cellSize = qMax<qreal>(MIN_CELL_SIZE, qMin((avail.width()-2.0)/m_renderedCols, (avail.height()-2.0)/m_renderedRows));
+		m_scene->setSceneRect(0, 0, m_renderedCols*m_cellSize, m_renderedRows*m_cellSize);
+	} else {
+		m_scene->setSceneRect(QRectF());
 	}
+	m_gridItem->update();
 }
 
 void GridEditor::mousePressEvent(QMouseEvent *event)
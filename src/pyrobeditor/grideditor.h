@@ -8,7 +8,10 @@
 #include <QRectF>
 #include <QPen>
 
-class ProjectModel;
+#include "projectmodel.h"
+
+class QPainter;
+class QTimer;
 
 class GridEditor : public QGraphicsView
 {
@@ -36,13 +39,28 @@ protected:
 	void mouseMoveEvent(QMouseEvent *event) override;
 
 private:
+	class GridItem;
+
 	QPointF cellTopLeft(int i, int j) const;
 	QRectF cellRect(int i, int j) const;
 	bool pickCellAndEdge(const QPointF &pos, int &ci, int &cj, int &edge) const;
-	void rebuildScene();
+	// Поле рисуется одним элементом сцены прямо из модели (только открытая часть).
+	// Изменения модели собираются таймером и сравниваются с последним нарисованным
+	// состоянием - перерисовываются только изменившиеся клетки и стены
+	QRectF gridBounds() const;
+	void paintGrid(QPainter *painter, const QRectF &exposed) const;
+	void scheduleSync();
+	void syncWithModel();
+	void takeSnapshot();
+	void relayout();
 
 private:
 	class QGraphicsScene *m_scene;
+	GridItem *m_gridItem;
+	QTimer *m_syncTimer;
+	ProjectModel::VariantState m_rendered; // Состояние модели на момент последней синхронизации
+	int m_renderedRows;
+	int m_renderedCols;
 	ProjectModel *m_model;
 	Tool m_tool;
 	qreal m_cellSize;